@@ -0,0 +1,119 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Benchmark.cpp
+ *
+ *  @brief Implementation file for the class Benchmark.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class Benchmark.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <stdio.h>
+
+# include "Benchmark.h"
+
+/**
+ *  Constructor of the class.
+ *  @param benchName name printed in the report.
+ *  @param opUnit name of the operations, p.e, "frames".
+ */
+Benchmark :: Benchmark (const char *benchName, const char *opUnit)
+{
+    name      = benchName;
+    unit      = opUnit;
+    startTime = 0.0;
+    total     = 0.0;
+    numOps    = 0;
+}
+
+/**
+ *  Starts timing.
+ */
+void Benchmark :: start ()
+{
+    startTime = now();
+}
+
+/**
+ *  Stops timing.
+ *  @param ops number of operations since start().
+ */
+void Benchmark :: stop (long ops)
+{
+    total  += now() - startTime;
+    numOps += ops;
+}
+
+/**
+ *  Returns the nanoseconds per operation.
+ *  @return nanoseconds per operation, 0 if there were none.
+ */
+double Benchmark :: nsPerOp ()
+{
+    if (numOps == 0) {
+        return 0.0;
+    }
+
+    return total / numOps;
+}
+
+/**
+ *  Prints the header of the report lines.
+ */
+void Benchmark :: reportHeader ()
+{
+    printf("%-36s %10s %14s %14s\n", "benchmark", "ops", "ns/op", "rate");
+}
+
+/**
+ *  Prints a line with the results.
+ */
+void Benchmark :: report ()
+{
+    double perSecond;
+
+    perSecond = (total > 0.0) ? numOps * 1e9 / total : 0.0;
+
+    printf("%-36s %10ld %14.1f %14.1f %s/s\n", 
+           name, numOps, nsPerOp(), perSecond, unit);
+}
+
+/**
+ *  Returns the time of the monotonic clock.
+ *  @return time in nanoseconds.
+ */
+double Benchmark :: now ()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
@@ -0,0 +1,130 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Benchmark.h
+ *
+ *  @brief Header file for the class Benchmark.
+ *
+ *  This file contains the definition of the class Benchmark, the
+ *  timer shared by the benchmark programs.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef BENCHMARK_H
+# define BENCHMARK_H
+
+# include <time.h>
+
+/**
+ *  @class Benchmark
+ *
+ *  @brief Accumulates the time of the operations of a benchmark.
+ *
+ *  Every start() and stop() pair times some operations with the
+ *  monotonic clock. The report gives the nanoseconds per operation
+ *  and the operations per second, that are the frames per second
+ *  when every operation is a frame.
+ */
+class Benchmark
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         *  @param benchName name printed in the report.
+         *  @param opUnit name of the operations, p.e, "frames".
+         */
+        Benchmark(const char *benchName, const char *opUnit = "frames");
+
+        /**
+         *  Class destructor.
+         */
+        ~Benchmark() {}
+
+        /**
+         *  Starts timing.
+         */
+        void start();
+
+        /**
+         *  Stops timing.
+         *  @param ops number of operations since start().
+         */
+        void stop(long ops = 1);
+
+        /**
+         *  Returns the nanoseconds per operation.
+         *  @return nanoseconds per operation, 0 if there were none.
+         */
+        double nsPerOp();
+
+        /**
+         *  Prints a line with the results.
+         */
+        void report();
+
+        /**
+         *  Prints the header of the report lines.
+         */
+        static void reportHeader();
+
+        /**
+         *  Returns the time of the monotonic clock.
+         *  @return time in nanoseconds.
+         */
+        static double now();
+
+    private:
+
+        /**
+         *  Name printed in the report.
+         */
+        const char *name;
+
+        /**
+         *  Name of the operations.
+         */
+        const char *unit;
+
+        /**
+         *  Time of the last start().
+         */
+        double startTime;
+
+        /**
+         *  Total time in nanoseconds.
+         */
+        double total;
+
+        /**
+         *  Number of operations timed.
+         */
+        long numOps;
+};
+
+# endif
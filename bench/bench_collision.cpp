@@ -0,0 +1,273 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file bench/bench_collision.cpp
+ *
+ *  @brief Benchmark of the collisions of the game.
+ *
+ *  Starts a game with the scripted players and then times
+ *  SuperFiremanBrothers::nextFrame() with N flames and M shoots
+ *  spread over the field. The shoots are shared between Zamus and
+ *  Linq. Without -n and -m a set of sizes is run, and then the
+ *  advance of the projectiles is timed alone.
+ *
+ *  Usage: bench_collision [-n flames] [-m shoots] [-f frames]
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ */
+
+# include <unistd.h>
+
+# include "../src/common.h"
+# include "../src/config.h"
+# include "../src/UserDetector.h"
+# include "../src/GameSimulation.h"
+# include "../src/SyntheticBackend.h"
+# include "Benchmark.h"
+
+/**
+ *  Frames given to the scripted players to start the game.
+ */
+# define MAX_START_FRAMES 20000
+
+/**
+ *  Returns a random number between min and max.
+ */
+static float randomIn (float min, float max)
+{
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+/**
+ *  Returns a random point of the field where the flames advance.
+ */
+static XnPoint3D randomPoint ()
+{
+    XnPoint3D point;
+
+    point.X = randomIn(0.0, 800.0);
+    point.Y = randomIn(-600.0, 600.0);
+    point.Z = randomIn(-3500.0, 0.0);
+
+    return point;
+}
+
+/**
+ *  Times nextFrame() with a number of flames and shoots.
+ *  @param simulation game simulation with the game started.
+ *  @param player ID of a player of the game.
+ *  @param flames number of flames.
+ *  @param shoots number of shoots.
+ *  @param frames number of frames to time.
+ */
+static void runCollisions (GameSimulation *simulation, 
+                           XnUserID player,
+                           int flames, 
+                           int shoots, 
+                           int frames)
+{
+    int i;
+    int j;
+    char name[64];
+    XnPoint3D point;
+
+    SuperFiremanBrothers *game;
+    Zamus *zamusDetector;
+    Linq *linqDetector;
+
+    game          = simulation -> retGame();
+    zamusDetector = simulation -> retZamusDetector();
+    linqDetector  = simulation -> retLinqDetector();
+
+    sprintf(name, "nextFrame %d flames %d shoots", flames, shoots);
+    Benchmark bench(name);
+
+    // The hits remove shoots and flames, so they are placed again
+    // before every frame
+    for (i = 0; i < frames; i++) {
+        game -> clearFlames();
+        simulation -> retProjectiles() -> clear();
+
+        for (j = 0; j < flames; j++) {
+            point = randomPoint();
+            game -> addFlame(Vector3D(point.X, point.Y, point.Z), 
+                             rand() % 3 + 1);
+        }
+
+        for (j = 0; j < shoots; j++) {
+            if (j % 2 == 0) {
+                zamusDetector -> addShoot(randomPoint(), g_Vmz, player);
+            }
+            else {
+                linqDetector -> addIceSpawn(randomPoint(), g_Vmz, player);
+            }
+        }
+
+        bench.start();
+        game -> nextFrame();
+        bench.stop();
+    }
+
+    bench.report();
+}
+
+/**
+ *  Times ProjectileSystem::advance() with a number of projectiles.
+ *  @param projectiles projectiles of the game.
+ *  @param player ID of a player of the game.
+ *  @param count number of projectiles.
+ *  @param frames number of frames to time.
+ */
+static void runProjectiles (ProjectileSystem *projectiles,
+                            XnUserID player,
+                            int count,
+                            int frames)
+{
+    int i;
+    char name[64];
+    Vector3D direction;
+
+    sprintf(name, "advance %d projectiles", count);
+    Benchmark bench(name);
+
+    projectiles -> clear();
+
+    for (i = 0; i < count; i++) {
+        direction = Vector3D(randomIn(-1.0, 1.0), randomIn(-1.0, 1.0), -1.0);
+        direction.normalize();
+        projectiles -> add(i % 2 == 0 ? ZAMUS_SHOOT : LINQ_ICE, 
+                           randomPoint(), 
+                           direction, 
+                           player);
+    }
+
+    // The shoots go away slowly, most of them stay during the frames
+    bench.start();
+    for (i = 0; i < frames; i++) {
+        projectiles -> advance();
+    }
+    bench.stop(frames);
+
+    bench.report();
+}
+
+/**
+ *  Prints the options of the program.
+ */
+static void usage (const char *name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  -n flames     number of flames\n");
+    printf("  -m shoots     number of shoots\n");
+    printf("  -f frames     frames to time for every size (default 20000)\n");
+}
+
+/**
+ * Main Program
+ */
+int main (int argc, char* argv[]) 
+{
+    int option;
+    int flames;
+    int shoots;
+    int frames;
+    int i;
+    int j;
+    vector <XnUserID> users;
+
+    SyntheticBackend backend(2);
+    SensorFrame frame;
+
+    const int sizes[] = {8, 32, 128, 512};
+    const int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    flames = -1;
+    shoots = -1;
+    frames = 20000;
+
+    while ((option = getopt(argc, argv, "n:m:f:h")) != -1) {
+        switch (option) {
+            case 'n':
+                flames = atoi(optarg);
+                break;
+            case 'm':
+                shoots = atoi(optarg);
+                break;
+            case 'f':
+                frames = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (frames < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    srand(1);
+
+    UserDetector userDetector(&backend);
+    GameSimulation simulation(&userDetector, 2, 1);
+
+    // The scripted players transform and start the game
+    for (i = 0; i < MAX_START_FRAMES && !simulation.retGame() -> isGameOn(); i++) {
+        backend.readFrame(frame, false, false);
+        simulation.step(&frame);
+    }
+
+    users = userDetector.trackedUsers();
+
+    if (!simulation.retGame() -> isGameOn() || users.size() == 0) {
+        printf("The scripted players could not start the game\n");
+        return EXIT_FAILURE;
+    }
+
+    // From now on only the collisions run, on the last frame
+    Benchmark::reportHeader();
+
+    if (flames >= 0 || shoots >= 0) {
+        runCollisions(&simulation, 
+                      users[0], 
+                      flames < 0 ? 0 : flames, 
+                      shoots < 0 ? 0 : shoots, 
+                      frames);
+        return EXIT_SUCCESS;
+    }
+
+    for (i = 0; i < numSizes; i++) {
+        for (j = 0; j < numSizes; j++) {
+            runCollisions(&simulation, users[0], sizes[i], sizes[j], frames);
+        }
+    }
+
+    runProjectiles(simulation.retProjectiles(), users[0], 512, frames);
+    runProjectiles(simulation.retProjectiles(), users[0], 4096, frames);
+
+    return EXIT_SUCCESS;
+}
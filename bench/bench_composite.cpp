@@ -0,0 +1,212 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file bench/bench_composite.cpp
+ *
+ *  @brief Benchmark of the overlay of the camera image.
+ *
+ *  Times compositeUsers() on a 640x480 image with users in its label
+ *  map, cropped like the game does it, against the loop of one pixel
+ *  at a time that the renderer used before. Both overlays are compared
+ *  before timing them.
+ *
+ *  Usage: bench_composite [-f frames]
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ */
+
+# include <unistd.h>
+# include <string.h>
+
+# include "../src/common.h"
+# include "../src/config.h"
+# include "../src/Compositor.h"
+# include "Benchmark.h"
+
+/**
+ *  Size of the camera image and of its texture.
+ */
+# define IMAGE_X_RES 640
+# define IMAGE_Y_RES 480
+# define TEXTURE_RES 1024
+
+/**
+ *  Copies the window of the image one pixel at a time, like the
+ *  renderer did before.
+ */
+static void compositeScalar (const XnRGB24Pixel *image,
+                             const XnLabel *labels,
+                             const CropWindow &window,
+                             XnRGB24Pixel *overlay)
+{
+    unsigned int x;
+    unsigned int y;
+    unsigned int offset;
+
+    for (y = 0; y < window.height; y++) {
+        offset = (window.top + y) * IMAGE_X_RES + window.left;
+
+        for (x = 0; x < window.width; x++) {
+            *overlay = image[offset + x];
+
+            if ((labels[offset + x] != 0) && 
+                (labels[offset + x] <= MAX_USERS)) {
+                overlay -> nBlue = USER_PIXEL_BLUE;
+            }
+
+            overlay++;
+        }
+    }
+}
+
+/**
+ *  Fills the label map with some users as rectangles, so the labels
+ *  come in runs like the ones of the sensor.
+ */
+static void fillLabels (XnLabel *labels)
+{
+    int i;
+    int x;
+    int y;
+    int left;
+    int top;
+    int width;
+    int height;
+
+    memset(labels, 0, IMAGE_X_RES * IMAGE_Y_RES * sizeof(XnLabel));
+
+    for (i = 1; i <= 4; i++) {
+        width  = 60 + rand() % 120;
+        height = 200 + rand() % 200;
+        left   = rand() % (IMAGE_X_RES - width);
+        top    = rand() % (IMAGE_Y_RES - height);
+
+        for (y = top; y < top + height; y++) {
+            for (x = left; x < left + width; x++) {
+                labels[y * IMAGE_X_RES + x] = i;
+            }
+        }
+    }
+}
+
+/**
+ *  Prints the options of the program.
+ */
+static void usage (const char *name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  -f frames     frames to time (default 2000)\n");
+}
+
+/**
+ * Main Program
+ */
+int main (int argc, char* argv[]) 
+{
+    int option;
+    int frames;
+    int i;
+    unsigned int pixels;
+
+    vector <XnRGB24Pixel> image(IMAGE_X_RES * IMAGE_Y_RES);
+    vector <XnLabel> labels(IMAGE_X_RES * IMAGE_Y_RES);
+    vector <XnRGB24Pixel> scalar(IMAGE_X_RES * IMAGE_Y_RES);
+    vector <XnRGB24Pixel> simd(IMAGE_X_RES * IMAGE_Y_RES);
+    CropWindow window;
+
+    frames = 2000;
+
+    while ((option = getopt(argc, argv, "f:h")) != -1) {
+        switch (option) {
+            case 'f':
+                frames = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (frames < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    srand(1);
+
+    for (i = 0; i < IMAGE_X_RES * IMAGE_Y_RES; i++) {
+        image[i].nRed   = rand() % 256;
+        image[i].nGreen = rand() % 256;
+        image[i].nBlue  = rand() % 256;
+    }
+
+    fillLabels(&labels[0]);
+
+    window = cropWindow(IMAGE_X_RES, IMAGE_Y_RES, TEXTURE_RES, TEXTURE_RES);
+    pixels = window.width * window.height;
+
+    compositeScalar(&image[0], &labels[0], window, &scalar[0]);
+    compositeUsers(&image[0], 
+                   &labels[0], 
+                   IMAGE_X_RES, 
+                   window.left, 
+                   window.top, 
+                   window.width, 
+                   window.height, 
+                   &simd[0]);
+
+    if (memcmp(&scalar[0], &simd[0], pixels * sizeof(XnRGB24Pixel)) != 0) {
+        printf("The overlays of both loops are different\n");
+        return EXIT_FAILURE;
+    }
+
+    Benchmark::reportHeader();
+
+    Benchmark scalarBench("overlay one pixel at a time");
+    scalarBench.start();
+    for (i = 0; i < frames; i++) {
+        compositeScalar(&image[0], &labels[0], window, &scalar[0]);
+    }
+    scalarBench.stop(frames);
+    scalarBench.report();
+
+    Benchmark simdBench("overlay compositeUsers");
+    simdBench.start();
+    for (i = 0; i < frames; i++) {
+        compositeUsers(&image[0], 
+                       &labels[0], 
+                       IMAGE_X_RES, 
+                       window.left, 
+                       window.top, 
+                       window.width, 
+                       window.height, 
+                       &simd[0]);
+    }
+    simdBench.stop(frames);
+    simdBench.report();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file bench/bench_objload.cpp
+ *
+ *  @brief Benchmark of the loading of the models.
+ *
+ *  Loads every obj model of the game with glmReadOBJ() and
+ *  glmUnitize(), like the model classes do, and reports the time of
+ *  every model and of the whole set. Other obj files can be given as
+ *  arguments. It must be run from the directory of the game.
+ *
+ *  Usage: bench_objload [-i iterations] [model.obj ...]
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <unistd.h>
+
+# include "../glm/include/glm.h"
+# include "Benchmark.h"
+
+/**
+ *  The models loaded by ZamusModel, LinqModel and FlameModel.
+ */
+static const char *modelSet[] = {
+    "./models/zamusobj/pieZamus.obj",
+    "./models/zamusobj/antepiernaZamus.obj",
+    "./models/zamusobj/musloZamus.obj",
+    "./models/zamusobj/torsoZamus.obj",
+    "./models/zamusobj/cascoZamus.obj",
+    "./models/zamusobj/hombrera.obj",
+    "./models/zamusobj/brazo2Zamus.obj",
+    "./models/zamusobj/brazoZamus.obj",
+    "./models/zamusobj/cannonZamus.obj",
+    "./models/linqobj/pieLinq.obj",
+    "./models/linqobj/antepiernaLinq.obj",
+    "./models/linqobj/piernaLinq.obj",
+    "./models/linqobj/torsoLinq.obj",
+    "./models/linqobj/cabezaLinq.obj",
+    "./models/linqobj/hombroLinq.obj",
+    "./models/linqobj/brazoLinq.obj",
+    "./models/linqobj/antebrazoLinq.obj",
+    "./models/linqobj/escudoLinq.obj",
+    "./models/linqobj/espadaLinq.obj",
+    "./models/linqobj/icestaff.obj",
+    "./models/flameobj/flame.obj"
+};
+
+/**
+ *  Prints the options of the program.
+ */
+static void usage (const char *name)
+{
+    printf("Usage: %s [options] [model.obj ...]\n", name);
+    printf("  -i iterations loads of every model (default 20)\n");
+}
+
+/**
+ * Main Program
+ */
+int main (int argc, char* argv[]) 
+{
+    int option;
+    int iterations;
+    int numModels;
+    int i;
+    int j;
+    const char **models;
+    FILE *file;
+    GLMmodel *model;
+
+    Benchmark allBench("whole model set", "models");
+
+    iterations = 20;
+
+    while ((option = getopt(argc, argv, "i:h")) != -1) {
+        switch (option) {
+            case 'i':
+                iterations = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (iterations < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (optind < argc) {
+        models    = (const char **) &argv[optind];
+        numModels = argc - optind;
+    }
+    else {
+        models    = modelSet;
+        numModels = sizeof(modelSet) / sizeof(modelSet[0]);
+    }
+
+    // glmReadOBJ() exits when a file is missing
+    for (i = 0; i < numModels; i++) {
+        file = fopen(models[i], "r");
+        if (file == NULL) {
+            printf("Could not open %s\n", models[i]);
+            return EXIT_FAILURE;
+        }
+        fclose(file);
+    }
+
+    Benchmark::reportHeader();
+
+    for (i = 0; i < numModels; i++) {
+        Benchmark bench(models[i], "models");
+
+        for (j = 0; j < iterations; j++) {
+            bench.start();
+            allBench.start();
+
+            model = glmReadOBJ(models[i]);
+            glmUnitize(model);
+
+            allBench.stop();
+            bench.stop();
+
+            glmDelete(model);
+        }
+
+        bench.report();
+    }
+
+    allBench.report();
+
+    return EXIT_SUCCESS;
+}
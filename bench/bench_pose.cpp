@@ -0,0 +1,236 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file bench/bench_pose.cpp
+ *
+ *  @brief Benchmark of the pose detectors.
+ *
+ *  Runs every AbstractPoseDetection subclass (Zamus, Linq, Buster and
+ *  Ice Rod) over the skeletons of a recording or of the scripted
+ *  players and reports the time of each detectPose() call, of the
+ *  features of the poses and of every pose of the poses file over
+ *  every tracked skeleton.
+ *
+ *  Usage: bench_pose [-p players] [-f frames] [-r recording]
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ */
+
+# include <unistd.h>
+
+# include "../src/common.h"
+# include "../src/config.h"
+# include "../src/UserDetector.h"
+# include "../src/Zamus.h"
+# include "../src/Linq.h"
+# include "../src/BusterDetector.h"
+# include "../src/IceRodDetector.h"
+# include "../src/PoseLibrary.h"
+# include "../src/SyntheticBackend.h"
+# include "../src/ReplayBackend.h"
+# include "Benchmark.h"
+
+/**
+ *  Poses of config/Poses.txt.
+ */
+static const char *poseNames[] =
+{
+    "zamus",
+    "linq_stage1",
+    "linq_stage2",
+    "linq_stage3",
+    "buster_shoot",
+    "buster_on",
+    "buster_off",
+    "icerod_straight",
+    "icerod_bent"
+};
+
+# define NUM_POSES (sizeof(poseNames) / sizeof(poseNames[0]))
+
+/**
+ *  Prints the options of the program.
+ */
+static void usage (const char *name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  -p players    scripted players, 1 to %d (default 2)\n", MAX_USERS);
+    printf("  -f frames     frames to run (default 100000)\n");
+    printf("  -r recording  use the skeletons of a recording\n");
+}
+
+/**
+ * Main Program
+ */
+int main (int argc, char* argv[]) 
+{
+    int option;
+    int players;
+    int frames;
+    int i;
+    int slot;
+    int pose;
+    int matched;
+    int poses[NUM_POSES];
+    char *replayPath;
+
+    SensorBackend *backend;
+    ReplayBackend replay;
+    SensorFrame frame;
+
+    Benchmark zamusBench("Zamus::detectPose");
+    Benchmark linqBench("Linq::detectPose");
+    Benchmark busterBench("BusterDetector::detectPose");
+    Benchmark iceRodBench("IceRodDetector::detectPose");
+    Benchmark allBench("all detectors");
+    Benchmark featuresBench("PoseLibrary::computeFeatures");
+    Benchmark matchesBench("PoseLibrary::matches", "poses");
+
+    players    = 2;
+    frames     = 100000;
+    replayPath = NULL;
+
+    while ((option = getopt(argc, argv, "p:f:r:h")) != -1) {
+        switch (option) {
+            case 'p':
+                players = atoi(optarg);
+                break;
+            case 'f':
+                frames = atoi(optarg);
+                break;
+            case 'r':
+                replayPath = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (replayPath != NULL) {
+        if (!replay.open(replayPath)) {
+            return EXIT_FAILURE;
+        }
+        if (replay.retNumFrames() == 0) {
+            printf("The recording %s has no frames\n", replayPath);
+            return EXIT_FAILURE;
+        }
+        players = replay.retPlayers();
+    }
+
+    if (players < 1 || players > MAX_USERS || frames < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    SyntheticBackend synthetic(players);
+
+    if (replayPath != NULL) {
+        backend = &replay;
+    }
+    else {
+        backend = &synthetic;
+    }
+
+    // The detectors in the order of the game
+    UserDetector userDetector(backend);
+    ProjectileSystem projectiles;
+    Zamus zamusDetector(&userDetector, &projectiles);
+    Linq linqDetector(&userDetector, &projectiles);
+    BusterDetector busterDetector(&zamusDetector, &userDetector);
+    IceRodDetector iceRodDetector(&linqDetector, &userDetector);
+
+    for (pose = 0; pose < (int) NUM_POSES; pose++) {
+        poses[pose] = g_PoseLibrary.findPose(poseNames[pose]);
+    }
+    matched = 0;
+
+    for (i = 0; i < frames; i++) {
+
+        if (!backend -> readFrame(frame, false, false)) {
+            backend -> rewind();
+            backend -> readFrame(frame, false, false);
+        }
+
+        userDetector.updateFrame(&frame);
+
+        // The features were computed in updateFrame(), it is the
+        // same work
+        featuresBench.start();
+        g_PoseLibrary.computeFeatures(&frame);
+        featuresBench.stop();
+
+        allBench.start();
+
+        zamusBench.start();
+        zamusDetector.detectPose();
+        zamusBench.stop();
+
+        linqBench.start();
+        linqDetector.detectPose();
+        linqBench.stop();
+
+        busterBench.start();
+        busterDetector.detectPose();
+        busterBench.stop();
+
+        iceRodBench.start();
+        iceRodDetector.detectPose();
+        iceRodBench.stop();
+
+        allBench.stop();
+
+        // Every pose over every skeleton, poses that the detectors
+        // do not check in the current stages too
+        for (slot = 0; slot < frame.numUsers; slot++) {
+            if (!frame.users[slot].tracking) {
+                continue;
+            }
+
+            matchesBench.start();
+            for (pose = 0; pose < (int) NUM_POSES; pose++) {
+                matched += g_PoseLibrary.matches(poses[pose], slot);
+            }
+            matchesBench.stop(NUM_POSES);
+        }
+
+        // The shoots are not part of the poses
+        projectiles.advance();
+    }
+
+    printf("%d frames of %d players, %d poses matched\n", 
+           frames, players, matched);
+    Benchmark::reportHeader();
+    zamusBench.report();
+    linqBench.report();
+    busterBench.report();
+    iceRodBench.report();
+    allBench.report();
+    featuresBench.report();
+    matchesBench.report();
+
+    return EXIT_SUCCESS;
+}
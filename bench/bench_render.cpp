@@ -0,0 +1,362 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file bench/bench_render.cpp
+ *
+ *  @brief Benchmark of the rendering of the game.
+ *
+ *  Plays the game with the scripted players, or with a recording, and
+ *  draws every frame in an offscreen software OpenGL context (Mesa
+ *  OSMesa) with the same view of the game window. The game info is
+ *  not drawn because the GLUT fonts need a window. It must be run
+ *  from the directory of the game to find the models.
+ *
+ *  With -n the batch of the flames is also timed alone, with more
+ *  flames than the game has, spread over the field.
+ *
+ *  Usage: bench_render [-p players] [-f frames] [-r recording] [-n flames]
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ */
+
+# include <unistd.h>
+# include <GL/osmesa.h>
+
+# include "../src/common.h"
+# include "../src/config.h"
+# include "../src/UserDetector.h"
+# include "../src/GameSimulation.h"
+# include "../src/SceneRenderer.h"
+# include "../src/SyntheticBackend.h"
+# include "../src/ReplayBackend.h"
+# include "../src/FlameModel.h"
+# include "../src/FlameBatch.h"
+# include "Benchmark.h"
+
+/**
+ *  Size of the offscreen buffer, the one of the game window.
+ */
+# define RENDER_WIDTH  800
+# define RENDER_HEIGHT 600
+
+/**
+ *  Lights and materials of the game window.
+ */
+static GLfloat light_diffuse[]  = {0.8, 0.8, 0.8, 1.0};
+static GLfloat light_ambient[]  = {0.2, 0.2, 0.2, 1.0};
+static GLfloat light_specular[] = { 0.7, 0.7, 0.3, 1.0 };
+static GLfloat light_position[] = {-10.0,-10.0, 20.0, 0.0};
+static GLfloat mat_diffuse[]  = { 0.9, 0.9, 0.9, 0.9 };
+static GLfloat mat_specular[] = { 0.3, 0.3, 0.3, 0.3 };
+static GLfloat mat_shininess[] = { 10.0 };
+
+/**
+ *  Sets the OpenGL state of the game window.
+ */
+static void initGL ()
+{
+    glViewport(0, 0, RENDER_WIDTH, RENDER_HEIGHT);
+    glShadeModel(GL_SMOOTH);
+
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, light_ambient);
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, light_diffuse);
+    glLightfv(GL_LIGHT0, GL_SPECULAR, light_specular);
+    glLightfv(GL_LIGHT0, GL_POSITION, light_position);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_LIGHT0);
+
+    glEnable(GL_COLOR_MATERIAL);
+    glMaterialfv(GL_FRONT, GL_SPECULAR, mat_specular);
+    glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_diffuse);
+    glMaterialfv(GL_FRONT, GL_SHININESS, mat_shininess);
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_NORMALIZE);
+    glEnable(GL_TEXTURE_2D);
+}
+
+/**
+ *  Sets the projection and the view of the game window.
+ */
+static void setView ()
+{
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluPerspective(40.0, 1.05, 1.0, 10000.0);
+    gluLookAt(320.0, -300.0, 4200.0,
+              320.0, 240.0, 1500.0,
+              0.0,-1.0, 0.0);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+}
+
+/**
+ *  Returns a random number between min and max.
+ */
+static float randomIn (float min, float max)
+{
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+/**
+ *  Times FlameBatch::draw() with a number of flames spread over the
+ *  field, with random sizes and spins.
+ *  @param flames number of flames.
+ *  @param frames number of frames to time.
+ */
+static void runFlameBatch (int flames, int frames)
+{
+    int i;
+    int j;
+    char name[64];
+
+    FlameModel flameModel;
+    FlameBatch batch;
+
+    sprintf(name, "FlameBatch %d flames", flames);
+    Benchmark bench(name);
+
+    srand(1);
+
+    for (i = 0; i < frames; i++) {
+        glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        setView();
+
+        for (j = 0; j < flames; j++) {
+            batch.add(randomIn(0.0, 800.0), 
+                      randomIn(-600.0, 600.0), 
+                      randomIn(-3500.0, 0.0), 
+                      rand() % 3 + 1, 
+                      randomIn(0.0, 360.0));
+        }
+
+        bench.start();
+        batch.draw(flameModel.flame, 700.0);
+        glFinish();
+        bench.stop();
+    }
+
+    bench.report();
+}
+
+/**
+ *  Starts a new game, with a new user detector and a new renderer.
+ *  @param backend sensor backend of the frames.
+ *  @param userDetector user detector of the game.
+ *  @param simulation game simulation.
+ *  @param renderer renderer of the game.
+ *  @param players number of players of the game.
+ *  @param seed seed of the random numbers of the game.
+ */
+static void newGame (SensorBackend *backend,
+                     UserDetector *&userDetector, 
+                     GameSimulation *&simulation,
+                     SceneRenderer *&renderer,
+                     int players,
+                     unsigned int seed)
+{
+    delete renderer;
+    delete simulation;
+    delete userDetector;
+
+    userDetector = new UserDetector(backend);
+    simulation   = new GameSimulation(userDetector, players, seed);
+    renderer     = new SceneRenderer(userDetector,
+                                     simulation -> retZamusDetector(),
+                                     simulation -> retLinqDetector());
+}
+
+/**
+ *  Prints the options of the program.
+ */
+static void usage (const char *name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  -p players    scripted players, 1 to %d (default 2)\n", MAX_USERS);
+    printf("  -f frames     frames to draw (default 3000)\n");
+    printf("  -r recording  play a recording instead of scripted players\n");
+    printf("  -n flames     flames of the batch timed alone\n");
+}
+
+/**
+ * Main Program
+ */
+int main (int argc, char* argv[]) 
+{
+    int option;
+    int players;
+    int frames;
+    int i;
+    int flames;
+    unsigned int seed;
+    char *replayPath;
+    GLubyte *buffer;
+    OSMesaContext context;
+
+    UserDetector *userDetector;
+    GameSimulation *simulation;
+    SceneRenderer *renderer;
+    SensorBackend *backend;
+    ReplayBackend replay;
+    SensorFrame frame;
+
+    Benchmark frameBench("frame");
+    Benchmark sceneBench("SceneRenderer::drawScene");
+    Benchmark fireBench("drawFireBalls");
+
+    players    = 2;
+    frames     = 3000;
+    replayPath = NULL;
+    flames     = 0;
+
+    while ((option = getopt(argc, argv, "p:f:r:n:h")) != -1) {
+        switch (option) {
+            case 'p':
+                players = atoi(optarg);
+                break;
+            case 'f':
+                frames = atoi(optarg);
+                break;
+            case 'r':
+                replayPath = optarg;
+                break;
+            case 'n':
+                flames = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (replayPath != NULL) {
+        if (!replay.open(replayPath)) {
+            return EXIT_FAILURE;
+        }
+        if (replay.retNumFrames() == 0) {
+            printf("The recording %s has no frames\n", replayPath);
+            return EXIT_FAILURE;
+        }
+        players = replay.retPlayers();
+        seed = replay.retSeed();
+    }
+    else {
+        seed = 1;
+    }
+
+    if (players < 1 || players > MAX_USERS || frames < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    SyntheticBackend synthetic(players);
+
+    if (replayPath != NULL) {
+        backend = &replay;
+    }
+    else {
+        backend = &synthetic;
+    }
+
+    // Offscreen software context
+    context = OSMesaCreateContextExt(OSMESA_RGBA, 24, 0, 0, NULL);
+    buffer  = (GLubyte *) malloc(RENDER_WIDTH * RENDER_HEIGHT * 4);
+
+    if (context == NULL || buffer == NULL ||
+        !OSMesaMakeCurrent(context, buffer, GL_UNSIGNED_BYTE, 
+                           RENDER_WIDTH, RENDER_HEIGHT)) {
+        printf("Could not create the OSMesa context\n");
+        return EXIT_FAILURE;
+    }
+
+    initGL();
+
+    userDetector = NULL;
+    simulation   = NULL;
+    renderer     = NULL;
+    newGame(backend, userDetector, simulation, renderer, players, seed);
+
+    for (i = 0; i < frames; i++) {
+
+        if (!backend -> readFrame(frame, false, false)) {
+            backend -> rewind();
+            backend -> readFrame(frame, false, false);
+            newGame(backend, userDetector, simulation, renderer, players, seed);
+        }
+
+        simulation -> step(&frame);
+        simulation -> advanceTo(frame.timestamp);
+
+        if (simulation -> retGame() -> isGameOver()) {
+            backend -> gameOver();
+            newGame(backend, userDetector, simulation, renderer, players, seed);
+            continue;
+        }
+
+        frameBench.start();
+
+        glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        setView();
+        glPushMatrix();
+
+        sceneBench.start();
+        renderer -> drawScene(simulation -> retAlpha());
+        glFinish();
+        sceneBench.stop();
+
+        fireBench.start();
+        simulation -> retGame() -> drawFireBalls(simulation -> retAlpha());
+        glFinish();
+        fireBench.stop();
+
+        glPopMatrix();
+        glFinish();
+
+        frameBench.stop();
+    }
+
+    printf("%d frames of %d players, %dx%d\n", 
+           frames, players, RENDER_WIDTH, RENDER_HEIGHT);
+    Benchmark::reportHeader();
+    sceneBench.report();
+    fireBench.report();
+    frameBench.report();
+
+    if (flames > 0) {
+        runFlameBatch(flames, frames);
+    }
+
+    delete renderer;
+    delete simulation;
+    delete userDetector;
+
+    OSMesaDestroyContext(context);
+    free(buffer);
+
+    return EXIT_SUCCESS;
+}
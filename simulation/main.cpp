@@ -0,0 +1,281 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file simulation/main.cpp
+ *
+ *  @brief Headless simulation program.
+ *
+ *  Runs the game logic of Super Fireman Brothers without window and
+ *  without Kinect, as fast as the processor allows. The players are
+ *  scripted or come from a recording of a real session. When a game
+ *  is over a new one is started.
+ *
+ *  Usage: SuperFiremanBrothersSim [-p players] [-f frames] [-s seed]
+ *                                 [-r recording] [-w recording] [-l] [-t]
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ */
+
+# include <unistd.h>
+
+# include "../src/common.h"
+# include "../src/config.h"
+# include "../src/UserDetector.h"
+# include "../src/GameSimulation.h"
+# include "../src/SyntheticBackend.h"
+# include "../src/ReplayBackend.h"
+# include "../src/SkeletonRecorder.h"
+
+/**
+ *  Prints the options of the program.
+ */
+static void usage (const char *name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  -p players    scripted players, 1 to %d (default 2)\n", MAX_USERS);
+    printf("  -f frames     frames to simulate (default 100000, or the\n");
+    printf("                frames of the recording when replaying)\n");
+    printf("  -s seed       seed of the random numbers (default 1, or\n");
+    printf("                the seed of the recording when replaying)\n");
+    printf("  -r recording  replay a recording instead of scripted players\n");
+    printf("  -w recording  record the frames of the simulation\n");
+    printf("  -l            take the frames like the live game, which\n");
+    printf("                misses some of them\n");
+    printf("  -t            print the latencies of the stages of the frames\n");
+}
+
+/**
+ *  Starts a new game, with a new user detector so the players must
+ *  transform again.
+ *  @param userDetector user detector of the game.
+ *  @param simulation game simulation.
+ *  @param backend sensor backend of the frames.
+ *  @param recorder recorder of the frames, NULL if they are not recorded.
+ *  @param players number of players of the game.
+ *  @param seed seed of the random numbers of the game.
+ */
+static void newGame (UserDetector *&userDetector, 
+                     GameSimulation *&simulation,
+                     SensorBackend *backend,
+                     SkeletonRecorder *recorder,
+                     int players,
+                     unsigned int seed)
+{
+    delete simulation;
+    delete userDetector;
+
+    userDetector = new UserDetector(backend);
+    userDetector -> changeRecorder(recorder);
+    simulation   = new GameSimulation(userDetector, players, seed);
+}
+
+/**
+ * Main Program
+ */
+int main (int argc, char* argv[]) 
+{
+    int option;
+    int players;
+    int frames;
+    int games;
+    int i;
+    unsigned int seed;
+    unsigned int liveSeed;
+    bool seedGiven;
+    bool live;
+    XnUInt64 start;
+    double elapsed;
+    char *replayPath;
+    char *recordPath;
+
+    UserDetector *userDetector;
+    GameSimulation *simulation;
+    SensorBackend *backend;
+    ReplayBackend replay;
+    SkeletonRecorder recorder;
+    SensorFrame frame;
+
+    players    = 2;
+    frames     = 0;
+    seed       = 1;
+    seedGiven  = false;
+    live       = false;
+    replayPath = NULL;
+    recordPath = NULL;
+
+    while ((option = getopt(argc, argv, "p:f:s:r:w:lth")) != -1) {
+        switch (option) {
+            case 'p':
+                players = atoi(optarg);
+                break;
+            case 'f':
+                frames = atoi(optarg);
+                break;
+            case 's':
+                seed = strtoul(optarg, NULL, 10);
+                seedGiven = true;
+                break;
+            case 'r':
+                replayPath = optarg;
+                break;
+            case 'w':
+                recordPath = optarg;
+                break;
+            case 'l':
+                live = true;
+                break;
+            case 't':
+                g_Profiler.enable(true);
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (replayPath != NULL) {
+        if (!replay.open(replayPath)) {
+            return EXIT_FAILURE;
+        }
+        if (replay.retNumFrames() == 0) {
+            printf("The recording %s has no frames\n", replayPath);
+            return EXIT_FAILURE;
+        }
+
+        players = replay.retPlayers();
+        if (!seedGiven) {
+            seed = replay.retSeed();
+        }
+        if (frames == 0) {
+            frames = replay.retNumFrames();
+        }
+
+        printf("Replaying %u frames of %d players\n", 
+               replay.retNumFrames(), 
+               players);
+    }
+    else if (frames == 0) {
+        frames = 100000;
+    }
+
+    if (players < 1 || players > MAX_USERS || frames < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (recordPath != NULL && !recorder.open(recordPath, players, seed)) {
+        return EXIT_FAILURE;
+    }
+
+    SyntheticBackend synthetic(players);
+
+    if (replayPath != NULL) {
+        backend = &replay;
+    }
+    else {
+        backend = &synthetic;
+    }
+
+    userDetector = NULL;
+    simulation   = NULL;
+    newGame(userDetector, 
+            simulation, 
+            backend,
+            recordPath != NULL ? &recorder : NULL, 
+            players,
+            seed);
+    games = 1;
+    liveSeed = seed;
+
+    start = Profiler::now();
+
+    for (i = 0; i < frames; i++) {
+        {
+            ProfileZone zone(PROFILE_FRAME);
+
+            // At the end of the backend it starts again with a new game,
+            // the same seed makes it play the same way
+            if (!backend -> readFrame(frame, false, false)) {
+                backend -> rewind();
+                backend -> readFrame(frame, false, false);
+
+                newGame(userDetector, 
+                        simulation, 
+                        backend,
+                        recordPath != NULL ? &recorder : NULL, 
+                        players,
+                        seed);
+                games++;
+            }
+
+            // The live game only takes the newest frame when it draws,
+            // the frames in between are not played nor recorded
+            if (live && rand_r(&liveSeed) % 4 == 0) {
+                continue;
+            }
+
+            // The ticks follow the timestamps of the frames, not the
+            // wall clock, so the games do not depend on the host
+            simulation -> step(&frame);
+            simulation -> advanceTo(frame.timestamp);
+
+            if (simulation -> retGame() -> isGameOver()) {
+                printf("Game %d over at level %d, checksum %08x\n", 
+                       games, 
+                       simulation -> retGame() -> retLevel(),
+                       simulation -> retGame() -> retChecksum());
+
+                backend -> gameOver();
+                newGame(userDetector, 
+                        simulation, 
+                        backend,
+                        recordPath != NULL ? &recorder : NULL, 
+                        players,
+                        seed);
+                games++;
+            }
+        }
+
+        g_Profiler.dumpIfDue();
+    }
+
+    elapsed = (Profiler::now() - start) / 1000000000.0;
+
+    printf("%d frames, %d games in %.3f s (%.0f frames/s)\n", 
+           frames, 
+           games, 
+           elapsed, 
+           frames / elapsed);
+
+    if (g_Profiler.isEnabled()) {
+        g_Profiler.dump();
+    }
+
+    delete simulation;
+    delete userDetector;
+
+    return EXIT_SUCCESS;
+}
@@ -44,9 +44,10 @@
 AbstractPoseDetection :: AbstractPoseDetection()
 {
     userDetector = NULL;
-    poseTime = map <XnUserID, double>();
+    poseTimer = -1;
+    holdPose = -1;
     requiredPoseTime = 0.0f;
-    tc = TimeCounter();
+    lastTimestamp = 0;
 }
 
 /** 
@@ -56,9 +57,17 @@ AbstractPoseDetection :: AbstractPoseDetection()
 AbstractPoseDetection :: AbstractPoseDetection(UserDetector *userD)
 {
     userDetector = userD;
-    poseTime = map <XnUserID, double>();
+    poseTimer = userD -> retUserTable() -> addPoseTimer();
+
+    if (poseTimer == -1) {
+        reportError("Too many pose detectors for the user table\n");
+    }
+
+    g_PoseLibrary.open(POSE_FILE);
+
+    holdPose = -1;
     requiredPoseTime = 0.0f;
-    tc = TimeCounter();
+    lastTimestamp = 0;
 }
 
 /** 
@@ -69,35 +78,56 @@ AbstractPoseDetection :: AbstractPoseDetection(UserDetector *userD)
 void AbstractPoseDetection :: detectPose()
 {
     int i;
-    int numUsers;
-    XnUserID id;
+    int slot;
+    int numSlots;
+    const int *slots;
 
     double timeDifference;
+    double *poseTime;
 
-    vector <XnUserID> currentUsers;
+    const SensorFrame *frame;
+    UserTable *userTable;
     
-    currentUsers = userDetector -> trackedUsers();
+    numSlots = userDetector -> retNumTrackedSlots();
+    slots    = userDetector -> retTrackedSlots();
 
     // If no user tracked, then no pose can be
     // detected
-    if (currentUsers.size() == 0) {
+    if (numSlots == 0) {
         return;
     }
 
-    timeDifference = tc.takeTime();
+    // Time since the last frame in seconds
+    frame = userDetector -> retFrame();
+    timeDifference = (lastTimestamp == 0) ? 0.0 :
+                     (frame -> timestamp - lastTimestamp) / 1000000.0;
+    lastTimestamp = frame -> timestamp;
+
+    // The hold time can change when the poses file is read again
+    if (holdPose != -1) {
+        requiredPoseTime = g_PoseLibrary.retHoldTime(holdPose);
+    }
+
+    // The pose times of the users are in one column of the table
+    userTable = userDetector -> retUserTable();
+    poseTime  = userTable -> poseTime[poseTimer];
+
+    for(i = 0; i < numSlots; i++) {
+        slot = slots[i];
 
-    for(i = 0; i < currentUsers.size(); i++) {
-        id = currentUsers[i];
-        if(isPosing(id, poseTime[id])) {
+        // The users whose role or stage can not do the pose are
+        // skipped before looking at their joints
+        if(canPose(userTable, slot) && 
+           isPosing(userTable -> ids[slot], poseTime[slot])) {
             // Pose detected
-            if(poseTime[id] >= requiredPoseTime) {
-                poseDetected(id);
+            if(poseTime[slot] >= requiredPoseTime) {
+                poseDetected(userTable -> ids[slot]);
             } 
 
-            poseTime[id] += timeDifference;
+            poseTime[slot] += timeDifference;
         } 
         else {
-            poseTime[id] = 0.0f;
+            poseTime[slot] = 0.0f;
         }
     }
 }
@@ -109,8 +139,37 @@ void AbstractPoseDetection :: detectPose()
  */
 double AbstractPoseDetection ::  userPoseTime (XnUserID userID) 
 {
-    if (poseTime.count(userID) == 1) {
-        return poseTime[userID];
+    int slot;
+    UserTable *userTable;
+
+    userTable = userDetector -> retUserTable();
+    slot      = userTable -> findSlot(userID);
+
+    if (slot != -1) {
+        return userTable -> poseTime[poseTimer][slot];
     }
     return -1;
 }
+
+/** 
+ *  Indicates if an user is in a pose of the library.
+ *  @param userID ID of the user.
+ *  @param pose index of the pose in the library.
+ *  @return true if the user is tracked and in the pose.
+ */
+bool AbstractPoseDetection :: isInPose(XnUserID userID, int pose)
+{
+    return g_PoseLibrary.matches(pose, userDetector -> retSlot(userID));
+}
+
+/** 
+ *  Indicates if the joints of a pose of the library can be
+ *  seen for an user.
+ *  @param userID ID of the user.
+ *  @param pose index of the pose in the library.
+ *  @return true if the joints have enough confidence.
+ */
+bool AbstractPoseDetection :: isPoseVisible(XnUserID userID, int pose)
+{
+    return g_PoseLibrary.isVisible(pose, userDetector -> retSlot(userID));
+}
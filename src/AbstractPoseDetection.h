@@ -40,6 +40,7 @@
 
 # include "common.h"
 # include "UserDetector.h"
+# include "PoseLibrary.h"
 
 /**
  *  @class AbstractPoseDetection
@@ -88,19 +89,26 @@ class AbstractPoseDetection
          *  pose to be detected
          */
         double requiredPoseTime;
+
+        /** 
+         *  Pose of the library whose hold time is the required
+         *  posing time, -1 if the time is fixed.
+         */
+        int holdPose;
         
         /** 
-         *  Map that contains the information about the 
-         *  users and the time that they have been posing,
-         *  it receives de user ID and returns the pose time.
+         *  Column of the user table with the time that the
+         *  users have been posing, -1 if there is none.
          */
-        map <XnUserID, double> poseTime;
+        int poseTimer;
 
         /** 
-         *  Time counter that is used to calculate the differences
-         *  of time between frames to use it for pose time calculation.
+         *  Timestamp of the last frame, it is used to calculate the
+         *  differences of time between frames for the pose time. The
+         *  sensor clock is used so the poses take the same number of
+         *  frames when the game is simulated faster than real time.
          */
-        TimeCounter tc;
+        XnUInt64 lastTimestamp;
         
         /**
          *  Returns the pose time of a specified user.
@@ -127,6 +135,20 @@ class AbstractPoseDetection
          */
         virtual bool isPosing(XnUserID userID, double poseTime = 0) = 0;
 
+        /** 
+         *  Indicates if an user can do the pose in his current role
+         *  and stage, it is checked before isPosing() and only reads
+         *  the user table. By default every tracked user can.
+         *  @param table table of the users.
+         *  @param slot slot of the user in the table.
+         *  @return false if isPosing() would return false without
+         *  changing anything.
+         */
+        virtual bool canPose(const UserTable *table, int slot)
+        {
+            return true;
+        }
+
         /** 
          *  Virtual function wich should be implemented for
          *  the pose detection, it specifies the actions that
@@ -143,7 +165,36 @@ class AbstractPoseDetection
         void setRequiredPoseTime(float time) 
         {
             requiredPoseTime = time;
+            holdPose = -1;
         }
+
+        /** 
+         *  This method takes the required pose time from the hold
+         *  time of a pose of the library, so it follows the changes
+         *  of the poses file.
+         *  @param pose index of the pose in the library.
+         */
+        void setHoldPose(int pose) 
+        {
+            holdPose = pose;
+        }
+
+        /** 
+         *  Indicates if an user is in a pose of the library.
+         *  @param userID ID of the user.
+         *  @param pose index of the pose in the library.
+         *  @return true if the user is tracked and in the pose.
+         */
+        bool isInPose(XnUserID userID, int pose);
+
+        /** 
+         *  Indicates if the joints of a pose of the library can be
+         *  seen for an user.
+         *  @param userID ID of the user.
+         *  @param pose index of the pose in the library.
+         *  @return true if the joints have enough confidence.
+         */
+        bool isPoseVisible(XnUserID userID, int pose);
 };
 
 # endif
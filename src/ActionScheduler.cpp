@@ -0,0 +1,251 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ActionScheduler.cpp
+ *
+ *  @brief Implementation file for the class ActionScheduler.
+ *
+ *  This file contains the implementation of the cooldowns, charges
+ *  and bursts of the actions of the users.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "ActionScheduler.h"
+
+/**
+ *  Returns a time in seconds in usec.
+ */
+static XnUInt64 toUsec(double seconds)
+{
+    if (seconds <= 0.0) {
+        return 0;
+    }
+
+    return (XnUInt64) (seconds * 1000000.0 + 0.5);
+}
+
+/**
+ *  Constructor of the class.
+ *  @param table table of the users, a column of action timers
+ *  is reserved in it.
+ *  @param pattern timing of the action.
+ */
+ActionScheduler :: ActionScheduler (UserTable *table, 
+                                    const ActionPattern &pattern)
+{
+    userTable = table;
+    action    = userTable -> addAction();
+
+    if (action == -1) {
+        reportError("Too many action schedulers for the user table\n");
+    }
+
+    if ((pattern.burst < 1) || (pattern.burst > ACTION_MAX_BURST)) {
+        reportError("Wrong number of shoots in the burst of an action\n");
+    }
+
+    cooldown      = toUsec(pattern.cooldown);
+    needsCharge   = pattern.needsCharge;
+    chargeTime    = toUsec(pattern.charge);
+    chargeWindow  = toUsec(pattern.chargeWindow);
+    burst         = pattern.burst;
+    burstInterval = toUsec(pattern.burstInterval);
+
+    numTimers = 0;
+    nextOrder = 0;
+}
+
+/**
+ *  Charges the action of an user, it is called in every frame
+ *  that the user is charging.
+ *  @param slot slot of the user.
+ *  @param now time of the frame (usec).
+ */
+void ActionScheduler :: charge (int slot, XnUInt64 now)
+{
+    bool *charging;
+    XnUInt64 *start;
+    XnUInt64 *last;
+
+    charging = userTable -> charging[action];
+    start    = userTable -> chargeStart[action];
+    last     = userTable -> chargeLast[action];
+
+    // A charge that was left for too long starts again
+    if (!charging[slot] || (now - last[slot] > chargeWindow)) {
+        charging[slot] = true;
+        start[slot]    = now;
+    }
+
+    last[slot] = now;
+}
+
+/**
+ *  Uses the action of an user. The action is used if its
+ *  cooldown is over and, if it needs a charge, the user charged
+ *  it long enough and not too long ago. The charge is spent in
+ *  any case. The rest of the shoots of the burst are scheduled.
+ *  @param slot slot of the user.
+ *  @param now time of the frame (usec).
+ *  @return true if the first shoot must be fired now.
+ */
+bool ActionScheduler :: release (int slot, XnUInt64 now)
+{
+    int i;
+    bool charged;
+    ActionTimer timer;
+
+    if (now < userTable -> readyTime[action][slot]) {
+        return false;
+    }
+
+    if (needsCharge) {
+        if (!userTable -> charging[action][slot]) {
+            return false;
+        }
+
+        charged = (userTable -> chargeLast[action][slot] - 
+                   userTable -> chargeStart[action][slot] >= chargeTime) &&
+                  (now - userTable -> chargeLast[action][slot] <= 
+                   chargeWindow);
+
+        userTable -> charging[action][slot] = false;
+
+        if (!charged) {
+            return false;
+        }
+    }
+
+    userTable -> readyTime[action][slot] = now + cooldown;
+
+    // The first shoot is fired by the caller, the rest wait in the heap
+    timer.slot   = slot;
+    timer.userID = userTable -> ids[slot];
+
+    for (i = 1; i < burst; i++) {
+        timer.time  = now + i * burstInterval;
+        timer.shoot = i;
+        push(timer);
+    }
+
+    return true;
+}
+
+/**
+ *  Takes the next pending shoot whose time has come.
+ *  @param now time of the frame (usec).
+ *  @param timer the shoot taken.
+ *  @return true if a shoot was taken, false if there are no
+ *  more for now.
+ */
+bool ActionScheduler :: popDue (XnUInt64 now, ActionTimer &timer)
+{
+    while ((numTimers > 0) && (timers[0].time <= now)) {
+        timer = timers[0];
+        pop();
+
+        // The shoots of the users that are gone are dropped
+        if (userTable -> used[timer.slot] && 
+            !userTable -> lost[timer.slot] &&
+            (userTable -> ids[timer.slot] == timer.userID)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  Indicates if a timer goes before another one.
+ */
+bool ActionScheduler :: before (const ActionTimer &a, const ActionTimer &b)
+{
+    if (a.time != b.time) {
+        return a.time < b.time;
+    }
+
+    return (XnInt32) (a.order - b.order) < 0;
+}
+
+/**
+ *  Adds a pending shoot.
+ *  @param timer shoot to be added.
+ */
+void ActionScheduler :: push (const ActionTimer &timer)
+{
+    int i;
+    int parent;
+
+    // The heap has room for a full burst of every slot, a user
+    // can not have two bursts at once if the cooldown is longer
+    // than the burst
+    if (numTimers == ACTION_MAX_TIMERS) {
+        return;
+    }
+
+    i = numTimers++;
+    timers[i] = timer;
+    timers[i].order = nextOrder++;
+
+    while (i > 0) {
+        parent = (i - 1) / 2;
+
+        if (!before(timers[i], timers[parent])) {
+            break;
+        }
+
+        std::swap(timers[i], timers[parent]);
+        i = parent;
+    }
+}
+
+/**
+ *  Removes the first pending shoot.
+ */
+void ActionScheduler :: pop ()
+{
+    int i;
+    int child;
+
+    timers[0] = timers[--numTimers];
+    i = 0;
+
+    while ((child = 2 * i + 1) < numTimers) {
+        if ((child + 1 < numTimers) && 
+            before(timers[child + 1], timers[child])) {
+            child++;
+        }
+
+        if (!before(timers[child], timers[i])) {
+            break;
+        }
+
+        std::swap(timers[i], timers[child]);
+        i = child;
+    }
+}
@@ -0,0 +1,222 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ActionScheduler.h
+ *
+ *  @brief Header file for the class ActionScheduler.
+ *
+ *  This file contains the definition of the cooldowns, charges and
+ *  bursts of the actions of the users, like the shoots of the Buster
+ *  and the ices of the Ice Rod.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef ACTION_SCHEDULER_H
+# define ACTION_SCHEDULER_H
+
+# include "common.h"
+# include "UserTable.h"
+
+/**
+ *  Maximum number of shoots of a burst.
+ */
+# define ACTION_MAX_BURST 8
+
+/**
+ *  Maximum number of pending shoots of all the users.
+ */
+# define ACTION_MAX_TIMERS (USER_SLOTS * ACTION_MAX_BURST)
+
+/**
+ *  @class ActionPattern
+ *
+ *  @brief Timing of an action, all the times are in seconds.
+ */
+class ActionPattern
+{
+    public:
+
+        /**
+         *  Minimum time between two uses of the action.
+         */
+        double cooldown;
+
+        /**
+         *  Indicates if the action must be charged before it is
+         *  released, the time that it must be charged and the time
+         *  that the charge lasts after the user stops charging.
+         */
+        bool needsCharge;
+        double charge;
+        double chargeWindow;
+
+        /**
+         *  Shoots of every use of the action, and time between two
+         *  shoots of the burst.
+         */
+        int burst;
+        double burstInterval;
+};
+
+/**
+ *  @class ActionTimer
+ *
+ *  @brief Pending shoot of a burst.
+ */
+class ActionTimer
+{
+    public:
+
+        /**
+         *  Time of the shoot (usec) and order of the timer, the timers
+         *  with the same time are fired in the order they were added.
+         */
+        XnUInt64 time;
+        XnUInt32 order;
+
+        /**
+         *  Slot and user ID of the user, the timer is dropped if the
+         *  slot has another user when it is fired.
+         */
+        int slot;
+        XnUserID userID;
+
+        /**
+         *  Index of the shoot in the burst.
+         */
+        int shoot;
+};
+
+/**
+ *  @class ActionScheduler
+ *
+ *  @brief Cooldowns, charges and bursts of an action of the users.
+ *
+ *  The times are the timestamps (usec) of the sensor frames, so the
+ *  actions keep the same rate whatever the frame rate is, and the
+ *  replays fire at the same times. The state of every user is a time
+ *  in a column of the user table: the scheduler compares it with the
+ *  time of the frame when the user uses the action, so the users that
+ *  do not use it cost nothing. The shoots of the bursts that are not
+ *  fired yet wait in a binary min-heap ordered by their time.
+ *
+ *  @see ActionPattern
+ */
+class ActionScheduler
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         *  @param table table of the users, a column of action timers
+         *  is reserved in it.
+         *  @param pattern timing of the action.
+         */
+        ActionScheduler(UserTable *table, const ActionPattern &pattern);
+
+        /**
+         *  Class destructor.
+         */
+        ~ActionScheduler() {}
+
+        /**
+         *  Charges the action of an user, it is called in every frame
+         *  that the user is charging.
+         *  @param slot slot of the user.
+         *  @param now time of the frame (usec).
+         */
+        void charge(int slot, XnUInt64 now);
+
+        /**
+         *  Uses the action of an user. The action is used if its
+         *  cooldown is over and, if it needs a charge, the user charged
+         *  it long enough and not too long ago. The charge is spent in
+         *  any case. The rest of the shoots of the burst are scheduled.
+         *  @param slot slot of the user.
+         *  @param now time of the frame (usec).
+         *  @return true if the first shoot must be fired now.
+         */
+        bool release(int slot, XnUInt64 now);
+
+        /**
+         *  Takes the next pending shoot whose time has come.
+         *  @param now time of the frame (usec).
+         *  @param timer the shoot taken.
+         *  @return true if a shoot was taken, false if there are no
+         *  more for now.
+         */
+        bool popDue(XnUInt64 now, ActionTimer &timer);
+
+        /**
+         *  Returns the number of pending shoots.
+         */
+        int retNumPending() const { return numTimers; }
+
+    private:
+
+        /**
+         *  Table of the users and column of the action in it.
+         */
+        UserTable *userTable;
+        int action;
+
+        /**
+         *  Timing of the action in usec.
+         */
+        XnUInt64 cooldown;
+        bool needsCharge;
+        XnUInt64 chargeTime;
+        XnUInt64 chargeWindow;
+        int burst;
+        XnUInt64 burstInterval;
+
+        /**
+         *  Min-heap of the pending shoots, and order of the next timer.
+         */
+        ActionTimer timers[ACTION_MAX_TIMERS];
+        int numTimers;
+        XnUInt32 nextOrder;
+
+        /**
+         *  Indicates if a timer goes before another one.
+         */
+        static bool before(const ActionTimer &a, const ActionTimer &b);
+
+        /**
+         *  Adds a pending shoot.
+         *  @param timer shoot to be added.
+         */
+        void push(const ActionTimer &timer);
+
+        /**
+         *  Removes the first pending shoot.
+         */
+        void pop();
+};
+
+# endif
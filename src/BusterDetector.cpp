@@ -37,16 +37,39 @@
 
 # include "BusterDetector.h"
 
+/**
+ *  Returns the timing of the shoots of the Buster, one shoot
+ *  every Z_SHOOT_COOLDOWN seconds while the pose is held.
+ */
+static ActionPattern busterPattern()
+{
+    ActionPattern pattern;
+
+    pattern.cooldown      = Z_SHOOT_COOLDOWN;
+    pattern.needsCharge   = false;
+    pattern.charge        = 0.0;
+    pattern.chargeWindow  = 0.0;
+    pattern.burst         = 1;
+    pattern.burstInterval = 0.0;
+
+    return pattern;
+}
+
 /**
  *  Constructor of the class.
  *  @param zamus pointer to a zamus struture.
  *  @param userD pointer to a user detector structure.
  */
 BusterDetector :: BusterDetector (Zamus *zamus, UserDetector *userD) : 
-    AbstractPoseDetection (userD)
+    AbstractPoseDetection (userD),
+    shoots (userD -> retUserTable(), busterPattern())
 {
     zDetector = zamus;
-    setRequiredPoseTime(Z_BUSTER_POSE_TIME);
+
+    shootPose        = g_PoseLibrary.findPose("buster_shoot");
+    activationPose   = g_PoseLibrary.findPose("buster_on");
+    deactivationPose = g_PoseLibrary.findPose("buster_off");
+    setHoldPose(shootPose);
 }
 
 
@@ -60,27 +83,39 @@ BusterDetector :: BusterDetector (Zamus *zamus, UserDetector *userD) :
  */
 bool BusterDetector :: isPosing(XnUserID userID, double poseTime) 
 {
-    if (busterActivationMsg.count(userID) == 0) {
-        busterActivationMsg.insert(pair <XnUserID, bool> (userID, false));
+    int slot;
+    UserTable *userTable;
+
+    userTable = userDetector -> retUserTable();
+    slot      = userTable -> findSlot(userID);
+
+    if (slot == -1) {
+        return false;
+    }
+
+    // Only the pose that can change the Buster status is checked
+    if (userTable -> busterStatus[slot] == Zamus :: DEACTIVATED) {
+        detectBusterActivationPose(userID);
     }
 
-    detectBusterActivationPose(userID);
-    detectBusterDeactivationPose(userID);
+    if (userTable -> busterStatus[slot] == Zamus :: ACTIVATED) {
+        detectBusterDeactivationPose(userID);
+    }
 
     // Buster Status
-    switch(zDetector -> retBusterStatus(userID)) {
+    switch(userTable -> busterStatus[slot]) {
         case (Zamus :: ACTIVATED):
             
-            if (!busterActivationMsg[userID]) {
+            if (!userTable -> busterActivationMsg[slot]) {
                 printf("Buster Activated user %d\n", userID);
-                busterActivationMsg[userID] = true;
+                userTable -> busterActivationMsg[slot] = true;
             }
             return detectBusterPose(userID);
 
         case (Zamus :: DEACTIVATED):
-            if (busterActivationMsg[userID]) {
+            if (userTable -> busterActivationMsg[slot]) {
                 printf("Buster Deactivated user %d\n", userID);
-                busterActivationMsg[userID] = false;
+                userTable -> busterActivationMsg[slot] = false;
             }
             return false;
 
@@ -92,6 +127,23 @@ bool BusterDetector :: isPosing(XnUserID userID, double poseTime)
 }
 
 
+/** 
+ *  Indicates if an user can use the Buster, only the
+ *  transformed Zamus users can.
+ *  @param table table of the users.
+ *  @param slot slot of the user in the table.
+ *  @return true if the user is a Zamus with the Buster
+ *  activated or deactivated.
+ */
+bool BusterDetector :: canPose(const UserTable *table, int slot) 
+{
+    return (table -> listener[slot] == ZAMUS_TYPE) &&
+           (table -> listenedStage[slot] == Zamus :: TRANSFORMED) &&
+           ((table -> busterStatus[slot] == Zamus :: ACTIVATED) ||
+            (table -> busterStatus[slot] == Zamus :: DEACTIVATED));
+}
+
+
 /** 
  *  Specifies the actions that should be taken 
  *  when the Buster pose is detected.
@@ -111,28 +163,29 @@ void BusterDetector ::  poseDetected(XnUserID userID)
  */
 void BusterDetector :: shootBuster(XnUserID userID)
 {
-    UserGenerator userGen;
-    DepthGenerator depthGen;
     XnSkeletonJointPosition elbow;
     XnSkeletonJointPosition hand;
     XnPoint3D points[2];
     Vector3D dir;
+    int slot;
 
-    if (shootDelay.count(userID) != 1) {
-        shootDelay.insert(pair <XnUserID, int> (userID, 0));
-    }
+    slot = userDetector -> retUserTable() -> findSlot(userID);
 
-    if (shootDelay[userID] > Z_SHOOT_DELAY) {
+    if (slot == -1) {
+        return;
+    }
 
-    userGen  = userDetector -> retUserGenerator();
-    depthGen = userDetector -> retDepthGenerator();
+    // The shoots follow the time of the frames, not their number
+    if (!shoots.release(slot, userDetector -> retFrame() -> timestamp)) {
+        return;
+    }
 
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
+    userDetector -> getProjectivePosition(
         userID, 
         XN_SKEL_LEFT_ELBOW, 
         elbow
     );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
+    userDetector -> getProjectivePosition(
         userID, 
         XN_SKEL_LEFT_HAND, 
         hand
@@ -141,218 +194,39 @@ void BusterDetector :: shootBuster(XnUserID userID)
     points[0] = elbow.position;
     points[1] = hand.position;
 
-    depthGen.ConvertRealWorldToProjective(2, points, points);
-
     dir.x = points[1].X - points[0].X;
     dir.y = points[1].Y - points[0].Y;
     dir.z = points[1].Z - points[0].Z;
 
     zDetector -> addShoot(points[1], dir, userID);
-    //printf("puf %d\n", count++);
-
-    shootDelay[userID] = 0;
-
-    }
-    else {
-        shootDelay[userID] += 1;
-    }
 }
 
 
 /** 
  *  Function that detects if the Buster pose is being applied,
- *  it determines when the zamus user should shoot.
+ *  it determines when the zamus user should shoot. It is
+ *  checked while the Buster is activated.
  *  @param userID id of the user applying the pose.
  *  @param poseTime pose time of the Buster pose.
  */
 bool BusterDetector :: detectBusterPose(XnUserID userID, double poseTime) 
 {
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
-    bool isStraight;
-    bool isFrontRight;
-
-    int index;
-
-    if (!((zDetector -> isListened(userID)) && 
-       (zDetector -> retLisUserStage(userID) == Zamus :: TRANSFORMED) &&
-       (zDetector -> retBusterStatus(userID) == Zamus :: ACTIVATED))) {
-
-        return false;
-    }
-
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE))
-        {
-            return false;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    vrse.normalize();
-    vreh.normalize();
-    
-    // For right arm 
-    isStraight = toAngle(acos(vrse.dot(vreh))) <= 30;
-
-    return isStraight;
+    // Right arm straight
+    return isInPose(userID, shootPose);
 }
 
 
 /** 
- *  Function that detects the activation of the zamus Buster.
+ *  Function that detects the activation of the zamus Buster,
+ *  it is checked while the Buster is deactivated.
  *  @param userID id of the user applying the pose.
  *  @param poseTime pose time of the Buster pose.
  */
 void BusterDetector :: detectBusterActivationPose (XnUserID userID, 
                                                    double poseTime) 
 {
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh, ls, le, lh;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
-    Vector3D vlsrs, vrsls;
-
-    Vector3D vls, vle, vlh;
-    Vector3D vlse, vleh;
-
-    int percent;
-
-    bool isStraight;
-    bool isFrontRight;
-    bool isFrontLeft;
-    bool isCrossed;
-
-    if (!((zDetector -> isListened(userID)) && 
-       (zDetector -> retLisUserStage(userID) == Zamus :: TRANSFORMED) &&
-       (zDetector -> retBusterStatus(userID) == Zamus :: DEACTIVATED))) {
-
-        return;
-    }
-
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_SHOULDER, 
-        ls
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_ELBOW, 
-        le
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_HAND, 
-        lh
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE) ||
-        (ls.fConfidence < CONFIDENCE) ||
-        (le.fConfidence < CONFIDENCE) ||
-        (lh.fConfidence < CONFIDENCE)) 
-        {
-            return;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-    vls = Vector3D((ls.position).X, (ls.position).Y, (ls.position).Z);
-    vle = Vector3D((le.position).X, (le.position).Y, (le.position).Z);
-    vlh = Vector3D((lh.position).X, (lh.position).Y, (lh.position).Z);
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    // Left Shoulder to Elbow
-    vlse = vle - vls;
-    
-    // Left Elbow to hand
-    vleh = vlh - vle;
-
-    vrse.normalize();
-    vreh.normalize();
-    vlse.normalize();
-    vleh.normalize();
-    
-    // For right arm 
-    isStraight = toAngle(acos(vrse.dot(vreh))) <= STRAIGHT_RANGE;
-    
-    isFrontRight = toAngle(acos(vrse.dot(g_Vmz))) <= 30;
-
-    // For left Arm
-    isFrontLeft = toAngle(acos(vlse.dot(g_Vmz))) <= 30;
-
-    isCrossed = (toAngle(acos(vleh.dot(vreh))) <= 120) && 
-                (toAngle(acos(vleh.dot(vreh))) >= 60);
-     
     // Activation course
-    if (isStraight && isFrontRight && isFrontLeft && isCrossed) {
+    if (isInPose(userID, activationPose)) {
         zDetector -> changeBusterStatus(userID, Zamus :: ACTIVATED);
     }
 }
@@ -360,123 +234,15 @@ void BusterDetector :: detectBusterActivationPose (XnUserID userID,
 
 /** 
  *  Function that detects the deactivation of the zamus
- *  Buster.
+ *  Buster, it is checked while the Buster is activated.
  *  @param userID id of the user applying the pose.
  *  @param poseTime pose time of the Buster pose.
  */
 void BusterDetector :: detectBusterDeactivationPose (XnUserID userID, 
                                                      double poseTime) 
 {
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh, ls, le, lh;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
-    Vector3D vlsrs, vrsls;
-
-    Vector3D vls, vle, vlh;
-    Vector3D vlse, vleh;
-
-    int percent;
-
-    bool isStraight;
-    bool isFrontRight;
-    bool isFrontLeft;
-    bool isCrossed;
-    
-   if (!((zDetector -> isListened(userID)) && 
-      (zDetector -> retLisUserStage(userID) == Zamus :: TRANSFORMED) &&
-      (zDetector -> retBusterStatus(userID) == Zamus :: ACTIVATED))) {
-
-        return;
-    }
-
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_SHOULDER, 
-        ls
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_ELBOW, 
-        le
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_HAND, 
-        lh
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE) ||
-        (ls.fConfidence < CONFIDENCE) ||
-        (le.fConfidence < CONFIDENCE) ||
-        (lh.fConfidence < CONFIDENCE)) 
-        {
-            return;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-    vls = Vector3D((ls.position).X, (ls.position).Y, (ls.position).Z);
-    vle = Vector3D((le.position).X, (le.position).Y, (le.position).Z);
-    vlh = Vector3D((lh.position).X, (lh.position).Y, (lh.position).Z);
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    // Left Shoulder to Elbow
-    vlse = vle - vls;
-    
-    // Left Elbow to hand
-    vleh = vlh - vle;
-
-    vrse.normalize();
-    vreh.normalize();
-    vlse.normalize();
-    vleh.normalize();
-    
-    // For left arm 
-    isStraight = toAngle(acos(vlse.dot(vleh))) <= STRAIGHT_RANGE;
-    
-    isFrontLeft = toAngle(acos(vlse.dot(g_Vmz))) <= 30;
-
-    // For right Arm
-    isFrontRight = toAngle(acos(vrse.dot(g_Vmz))) <= 30;
-
-    isCrossed = (toAngle(acos(vreh.dot(vleh))) <= 120) && 
-                (toAngle(acos(vreh.dot(vleh))) >= 60);
-     
-    // Activation course
-    if (isStraight && isFrontRight && isFrontLeft && isCrossed) {
+    // Deactivation course
+    if (isInPose(userID, deactivationPose)) {
         zDetector -> changeBusterStatus(userID, Zamus :: DEACTIVATED);
     }
 }
@@ -43,6 +43,7 @@
 
 # include "common.h"
 # include "Zamus.h"
+# include "ActionScheduler.h"
 
 /**
  *  @class BusterDetector
@@ -86,6 +87,16 @@ class BusterDetector : public AbstractPoseDetection
          */
         virtual bool isPosing(XnUserID userID, double poseTime = 0.0);
 
+        /** 
+         *  Indicates if an user can use the Buster, only the
+         *  transformed Zamus users can.
+         *  @param table table of the users.
+         *  @param slot slot of the user in the table.
+         *  @return true if the user is a Zamus with the Buster
+         *  activated or deactivated.
+         */
+        virtual bool canPose(const UserTable *table, int slot);
+
         /** 
          *  Specifies the actions that should be taken 
          *  when the Buster pose is detected.
@@ -110,27 +121,30 @@ class BusterDetector : public AbstractPoseDetection
         Zamus *zDetector;
 
         /** 
-         *  Map that contains the delay of the shoots of 
-         *  every user transformed into zamus character.
+         *  Cooldown of the shoots of the users.
          */
-        map <XnUserID, int> shootDelay; 
+        ActionScheduler shoots;
 
         /** 
-         *  Map used to print the buster activation message
-         *  of every user as zamus.
+         *  Poses of the library for the shoot, the activation and
+         *  the deactivation of the Buster.
          */
-        map <XnUserID, bool> busterActivationMsg;
+        int shootPose;
+        int activationPose;
+        int deactivationPose;
 
         /** 
          *  Function that detects if the Buster pose is being applied,
-         *  it determines when the zamus user should shoot.
+         *  it determines when the zamus user should shoot. It is
+         *  checked while the Buster is activated.
          *  @param userID id of the user applying the pose.
          *  @param poseTime pose time of the Buster pose.
          */
         bool detectBusterPose(XnUserID userID, double poseTime = 0.0);
 
         /** 
-         *  Function that detects the activation of the zamus Buster.
+         *  Function that detects the activation of the zamus Buster,
+         *  it is checked while the Buster is deactivated.
          *  @param userID id of the user applying the pose.
          *  @param poseTime pose time of the Buster pose.
          */
@@ -139,7 +153,7 @@ class BusterDetector : public AbstractPoseDetection
 
         /** 
          *  Function that detects the deactivation of the zamus
-         *  Buster.
+         *  Buster, it is checked while the Buster is activated.
          *  @param userID id of the user applying the pose.
          *  @param poseTime pose time of the Buster pose.
          */
@@ -0,0 +1,880 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file CharacterRig.cpp
+ *
+ *  @brief Implementation file for the classes CharacterRig and
+ *  RigRenderer.
+ *
+ *  This file contains the tables of the parts of Zamus, Linq and the
+ *  stick figure of the users that are not transformed, and the
+ *  renderer that draws them.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "CharacterRig.h"
+# include "ModelCache.h"
+# include "RigMath.h"
+# include "Vector3D.h"
+
+/**
+ *  Transformations of the tables: translation, scale, rotation of a
+ *  fixed angle plus some times the angle the user is facing, and the
+ *  scale of Z by the length of the bone.
+ */
+# define RIG_T(x, y, z) {RIG_TRANSLATE, x, y, z, 0.0f, 0.0f}
+# define RIG_S(x, y, z) {RIG_SCALE, x, y, z, 0.0f, 0.0f}
+# define RIG_R(angle, facing, x, y, z) {RIG_ROTATE, x, y, z, angle, facing}
+# define RIG_LENGTH {RIG_STRETCH, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f}
+
+/**
+ *  Confidence masks of the tables.
+ */
+# define RIG_2(a, b) (RIG_BIT(RIG_##a) | RIG_BIT(RIG_##b))
+# define RIG_3(a, b, c) (RIG_2(a, b) | RIG_BIT(RIG_##c))
+
+/**
+ *  Stages of the stick figure with parts of the characters: the legs
+ *  of Zamus are drawn from the stage 0, his chest from the stage 1 and
+ *  his arms in the stage 2. Linq has the left arm in the stages 4 and 5
+ *  and the right one in the stage 5.
+ */
+# define STICK_LEGS  (RIG_STAGE(0) | RIG_STAGE(1) | RIG_STAGE(2) | \
+                      RIG_STAGE(3))
+# define STICK_CHEST (RIG_STAGE(1) | RIG_STAGE(2) | RIG_STAGE(3))
+# define STICK_ZAMUS_ARMS RIG_STAGE(2)
+# define STICK_LINQ_LEFT  (RIG_STAGE(4) | RIG_STAGE(5))
+# define STICK_LINQ_RIGHT RIG_STAGE(5)
+
+/**
+ *  Limb of the stick figure, a cylinder between two points and a ball
+ *  at the second one.
+ */
+# define STICK_LIMB_PARTS(from, to, stages) \
+    {STICK_LIMB, RIG_BONE, {from, to}, 0, stages, \
+        {RIG_LENGTH}}, \
+    {STICK_JOINT, RIG_JOINT, {to}, 0, stages, \
+        {{RIG_END}}}
+
+/**
+ *  Parts of Zamus.
+ */
+static const RigPart zamusParts[] =
+{
+    // Head
+    {ZAMUS_HEAD, RIG_BONE, {RIG_HEAD, RIG_NECK}, 
+        RIG_2(HEAD, NECK), RIG_ALL_STAGES,
+        {RIG_S(400.0, 400.0, 400.0), RIG_T(0.0, -0.1, 0.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+
+    // Chest
+    {ZAMUS_CHEST, RIG_BONE, {RIG_NECK, RIG_TORSO}, 
+        RIG_2(TORSO, NECK), RIG_ALL_STAGES,
+        {RIG_S(400.0, 400.0, 400.0), RIG_R(90, 0, -1.0, 0.0, 0.0), 
+         RIG_R(0, 1, 0.0, -1.0, 0.0), RIG_T(0.0, -0.1, 0.0)}},
+
+    // Shoulders
+    {ZAMUS_SHOULDER, RIG_JOINT, {RIG_LEFT_SHOULDER}, 
+        RIG_2(LEFT_SHOULDER, RIGHT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_R(0, -1, 0.0, -2.0, 0.0), RIG_T(-30.0, -40.0, 0.0), 
+         RIG_S(500.0, -500.0, 500.0)}},
+    {ZAMUS_SHOULDER, RIG_JOINT, {RIG_RIGHT_SHOULDER}, 
+        RIG_2(LEFT_SHOULDER, RIGHT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_R(0, -1, 0.0, -1.0, 0.0), RIG_T(30.0, -40.0, 0.0), 
+         RIG_S(500.0, -500.0, 500.0)}},
+
+    // Arm of the right joints
+    {ZAMUS_ARM, RIG_BONE, {RIG_RIGHT_SHOULDER, RIG_RIGHT_ELBOW}, 
+        RIG_3(RIGHT_ELBOW, RIGHT_HAND, RIGHT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(500.0, 500.0, 500.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_FOREARM, RIG_BONE, {RIG_RIGHT_ELBOW, RIG_RIGHT_HAND}, 
+        RIG_3(RIGHT_ELBOW, RIGHT_HAND, RIGHT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 60.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Arm of the left joints, with the cannon
+    {ZAMUS_ARM, RIG_BONE, {RIG_LEFT_SHOULDER, RIG_LEFT_ELBOW}, 
+        RIG_3(LEFT_ELBOW, LEFT_HAND, LEFT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(500.0, 500.0, 500.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_CANNON, RIG_BONE, {RIG_LEFT_ELBOW, RIG_LEFT_HAND}, 
+        RIG_3(LEFT_ELBOW, LEFT_HAND, LEFT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 80.0), RIG_S(300.0, 300.0, 300.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Leg of the right joints
+    {ZAMUS_THIGH, RIG_BONE, {RIG_RIGHT_HIP, RIG_RIGHT_KNEE}, 
+        RIG_3(RIGHT_HIP, RIGHT_KNEE, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_LEG, RIG_BONE, {RIG_RIGHT_KNEE, RIG_RIGHT_FOOT}, 
+        RIG_3(RIGHT_HIP, RIGHT_KNEE, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(100.0, 100.0, 100.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+
+    // Leg of the left joints
+    {ZAMUS_THIGH, RIG_BONE, {RIG_LEFT_HIP, RIG_LEFT_KNEE}, 
+        RIG_3(LEFT_HIP, LEFT_KNEE, LEFT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_LEG, RIG_BONE, {RIG_LEFT_KNEE, RIG_LEFT_FOOT}, 
+        RIG_3(LEFT_HIP, LEFT_KNEE, LEFT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-100.0, 100.0, 100.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Feet
+    {ZAMUS_FOOT, RIG_JOINT, {RIG_LEFT_FOOT}, 
+        RIG_2(LEFT_FOOT, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_S(40.0, -40.0, -40.0), RIG_R(0, 1, 0.0, -1.0, 0.0), 
+         RIG_T(0.0, -0.25, 0.5)}},
+    {ZAMUS_FOOT, RIG_JOINT, {RIG_RIGHT_FOOT}, 
+        RIG_2(LEFT_FOOT, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_S(-40.0, -40.0, -40.0), RIG_R(0, -1, 0.0, -1.0, 0.0), 
+         RIG_T(0.0, -0.25, 0.5)}}
+};
+
+/**
+ *  Parts of Linq.
+ */
+static const RigPart linqParts[] =
+{
+    // Head
+    {LINQ_HEAD, RIG_BONE, {RIG_HEAD, RIG_NECK}, 
+        RIG_2(HEAD, NECK), RIG_ALL_STAGES,
+        {RIG_S(450.0, 450.0, 450.0), RIG_T(0.0, -0.1, 0.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+
+    // Chest
+    {LINQ_CHEST, RIG_BONE, {RIG_NECK, RIG_TORSO}, 
+        RIG_2(TORSO, NECK), RIG_ALL_STAGES,
+        {RIG_S(300.0, 300.0, 300.0), RIG_R(90, 0, -1.0, 0.0, 0.0), 
+         RIG_R(0, 1, 0.0, -1.0, 0.0), RIG_T(0.0, -0.2, 0.0)}},
+
+    // Shoulders
+    {LINQ_SHOULDER, RIG_JOINT, {RIG_LEFT_SHOULDER}, 
+        RIG_2(LEFT_SHOULDER, RIGHT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_R(0, -1, 0.0, -2.0, 0.0), RIG_S(500.0, -500.0, 500.0)}},
+    {LINQ_SHOULDER, RIG_JOINT, {RIG_RIGHT_SHOULDER}, 
+        RIG_2(LEFT_SHOULDER, RIGHT_SHOULDER), RIG_ALL_STAGES,
+        {RIG_R(0, -1, 0.0, -1.0, 0.0), RIG_S(500.0, -500.0, 500.0)}},
+
+    // Arm of the right joints
+    {LINQ_ARM, RIG_BONE, {RIG_RIGHT_SHOULDER, RIG_RIGHT_ELBOW}, 
+        RIG_3(RIGHT_SHOULDER, RIGHT_ELBOW, RIGHT_HAND), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(350.0, 350.0, 350.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {LINQ_FOREARM, RIG_BONE, {RIG_RIGHT_ELBOW, RIG_RIGHT_HAND}, 
+        RIG_3(RIGHT_SHOULDER, RIGHT_ELBOW, RIGHT_HAND), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 60.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Arm of the left joints
+    {LINQ_ARM, RIG_BONE, {RIG_LEFT_SHOULDER, RIG_LEFT_ELBOW}, 
+        RIG_3(LEFT_SHOULDER, LEFT_ELBOW, LEFT_HAND), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(350.0, 350.0, 350.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {LINQ_FOREARM, RIG_BONE, {RIG_LEFT_ELBOW, RIG_LEFT_HAND}, 
+        RIG_3(LEFT_SHOULDER, LEFT_ELBOW, LEFT_HAND), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 60.0), RIG_S(-250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Shield and ice staff
+    {LINQ_SHIELD, RIG_BONE, {RIG_SHIELD_CENTER, RIG_SHIELD_FRONT}, 
+        RIG_BIT(RIG_LEFT_HAND), RIG_ALL_STAGES,
+        {RIG_S(300.0, 300.0, 300.0), RIG_R(90, 0, 0.0, 1.0, 0.0), 
+         RIG_R(180, 0, 1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {LINQ_STAFF, RIG_BONE, {RIG_LEFT_HAND, RIG_STAFF_TIP}, 
+        RIG_BIT(RIG_LEFT_HAND), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, -50.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(-90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Leg of the right joints
+    {LINQ_THIGH, RIG_BONE, {RIG_RIGHT_HIP, RIG_RIGHT_KNEE}, 
+        RIG_3(RIGHT_HIP, RIGHT_KNEE, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(180.0, 180.0, 180.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {LINQ_LEG, RIG_BONE, {RIG_RIGHT_KNEE, RIG_RIGHT_FOOT}, 
+        RIG_3(RIGHT_HIP, RIGHT_KNEE, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(80.0, 80.0, 80.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+
+    // Leg of the left joints
+    {LINQ_THIGH, RIG_BONE, {RIG_LEFT_HIP, RIG_LEFT_KNEE}, 
+        RIG_3(LEFT_HIP, LEFT_KNEE, LEFT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-180.0, 180.0, 180.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    {LINQ_LEG, RIG_BONE, {RIG_LEFT_KNEE, RIG_LEFT_FOOT}, 
+        RIG_3(LEFT_HIP, LEFT_KNEE, LEFT_FOOT), RIG_ALL_STAGES,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-80.0, 80.0, 80.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Feet
+    {LINQ_FOOT, RIG_JOINT, {RIG_LEFT_FOOT}, 
+        RIG_2(LEFT_FOOT, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_S(40.0, -40.0, -40.0), RIG_R(0, 1, 0.0, -1.0, 0.0), 
+         RIG_T(0.0, -0.25, 0.5)}},
+    {LINQ_FOOT, RIG_JOINT, {RIG_RIGHT_FOOT}, 
+        RIG_2(LEFT_FOOT, RIGHT_FOOT), RIG_ALL_STAGES,
+        {RIG_S(-40.0, -40.0, -40.0), RIG_R(0, -1, 0.0, -1.0, 0.0), 
+         RIG_T(0.0, -0.25, 0.5)}}
+};
+
+/**
+ *  Parts of the stick figure of the users that are not transformed,
+ *  the parts of Zamus and Linq appear with the stages of the
+ *  transformation. No confidence is needed.
+ */
+static const RigPart stickParts[] =
+{
+    // Legs of Zamus
+    {ZAMUS_THIGH, RIG_BONE, {RIG_RIGHT_HIP, RIG_RIGHT_KNEE}, 
+        0, STICK_LEGS,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_LEG, RIG_BONE, {RIG_RIGHT_KNEE, RIG_RIGHT_FOOT}, 
+        0, STICK_LEGS,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(100.0, 100.0, 100.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_THIGH, RIG_BONE, {RIG_LEFT_HIP, RIG_LEFT_KNEE}, 
+        0, STICK_LEGS,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_LEG, RIG_BONE, {RIG_LEFT_KNEE, RIG_LEFT_FOOT}, 
+        0, STICK_LEGS,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-100.0, 100.0, 100.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_FOOT, RIG_JOINT, {RIG_LEFT_FOOT}, 
+        0, STICK_LEGS,
+        {RIG_S(40.0, -40.0, -40.0), RIG_R(0, 1, 0.0, -1.0, 0.0), 
+         RIG_T(0.0, -0.25, 0.5)}},
+    {ZAMUS_FOOT, RIG_JOINT, {RIG_RIGHT_FOOT}, 
+        0, STICK_LEGS,
+        {RIG_S(-40.0, -40.0, -40.0), RIG_R(0, -1, 0.0, -1.0, 0.0), 
+         RIG_T(0.0, -0.25, 0.5)}},
+
+    // Stick legs
+    STICK_LIMB_PARTS(RIG_LEFT_KNEE, RIG_LEFT_FOOT, ~STICK_LEGS),
+    STICK_LIMB_PARTS(RIG_RIGHT_KNEE, RIG_RIGHT_FOOT, ~STICK_LEGS),
+    STICK_LIMB_PARTS(RIG_LEFT_HIP, RIG_LEFT_KNEE, ~STICK_LEGS),
+    STICK_LIMB_PARTS(RIG_RIGHT_HIP, RIG_RIGHT_KNEE, ~STICK_LEGS),
+
+    // Chest of Zamus or the stick torso
+    {ZAMUS_CHEST, RIG_BONE, {RIG_NECK, RIG_TORSO}, 
+        0, STICK_CHEST,
+        {RIG_S(400.0, 400.0, 400.0), RIG_R(90, 0, -1.0, 0.0, 0.0), 
+         RIG_R(0, 1, 0.0, -1.0, 0.0), RIG_T(0.0, -0.1, 0.0)}},
+    {STICK_QUAD, RIG_QUAD, 
+        {RIG_LEFT_SHOULDER, RIG_RIGHT_SHOULDER, RIG_RIGHT_HIP, RIG_LEFT_HIP}, 
+        0, ~STICK_CHEST,
+        {{RIG_END}}},
+
+    // Arms of Zamus
+    {ZAMUS_SHOULDER, RIG_JOINT, {RIG_LEFT_SHOULDER}, 
+        0, STICK_ZAMUS_ARMS,
+        {RIG_R(0, -1, 0.0, -2.0, 0.0), RIG_T(-30.0, -40.0, 0.0), 
+         RIG_S(500.0, -500.0, 500.0)}},
+    {ZAMUS_SHOULDER, RIG_JOINT, {RIG_RIGHT_SHOULDER}, 
+        0, STICK_ZAMUS_ARMS,
+        {RIG_R(0, -1, 0.0, -1.0, 0.0), RIG_T(30.0, -40.0, 0.0), 
+         RIG_S(500.0, -500.0, 500.0)}},
+    {ZAMUS_ARM, RIG_BONE, {RIG_RIGHT_SHOULDER, RIG_RIGHT_ELBOW}, 
+        0, STICK_ZAMUS_ARMS,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(500.0, 500.0, 500.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_FOREARM, RIG_BONE, {RIG_RIGHT_ELBOW, RIG_RIGHT_HAND}, 
+        0, STICK_ZAMUS_ARMS,
+        {RIG_T(0.0, 0.0, 60.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_ARM, RIG_BONE, {RIG_LEFT_SHOULDER, RIG_LEFT_ELBOW}, 
+        0, STICK_ZAMUS_ARMS,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(500.0, 500.0, 500.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {ZAMUS_CANNON, RIG_BONE, {RIG_LEFT_ELBOW, RIG_LEFT_HAND}, 
+        0, STICK_ZAMUS_ARMS,
+        {RIG_T(0.0, 0.0, 80.0), RIG_S(300.0, 300.0, 300.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+
+    // Left arm of Linq or the stick one
+    {LINQ_SHOULDER, RIG_JOINT, {RIG_LEFT_SHOULDER}, 
+        0, STICK_LINQ_LEFT,
+        {RIG_R(0, -1, 0.0, -2.0, 0.0), RIG_S(500.0, -500.0, 500.0)}},
+    {LINQ_THIGH, RIG_BONE, {RIG_LEFT_SHOULDER, RIG_LEFT_ELBOW}, 
+        0, STICK_LINQ_LEFT,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-180.0, 180.0, 180.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    {LINQ_LEG, RIG_BONE, {RIG_LEFT_ELBOW, RIG_LEFT_HAND}, 
+        0, STICK_LINQ_LEFT,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(-80.0, 80.0, 80.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    STICK_LIMB_PARTS(RIG_LEFT_SHOULDER, RIG_LEFT_ELBOW, 
+                     ~(STICK_ZAMUS_ARMS | STICK_LINQ_LEFT)),
+    STICK_LIMB_PARTS(RIG_LEFT_ELBOW, RIG_LEFT_HAND, 
+                     ~(STICK_ZAMUS_ARMS | STICK_LINQ_LEFT)),
+
+    // Right arm of Linq or the stick one
+    {LINQ_SHOULDER, RIG_JOINT, {RIG_RIGHT_SHOULDER}, 
+        0, STICK_LINQ_RIGHT,
+        {RIG_R(0, -1, 0.0, -1.0, 0.0), RIG_S(500.0, -500.0, 500.0)}},
+    {LINQ_ARM, RIG_BONE, {RIG_RIGHT_SHOULDER, RIG_RIGHT_ELBOW}, 
+        0, STICK_LINQ_RIGHT,
+        {RIG_T(0.0, 0.0, 50.0), RIG_S(350.0, 350.0, 350.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, 1, 0.0, -1.0, 0.0)}},
+    {LINQ_FOREARM, RIG_BONE, {RIG_RIGHT_ELBOW, RIG_RIGHT_HAND}, 
+        0, STICK_LINQ_RIGHT,
+        {RIG_T(0.0, 0.0, 60.0), RIG_S(250.0, 250.0, 250.0), 
+         RIG_R(90, 0, -1.0, 0.0, 0.0), RIG_R(0, -1, 0.0, -1.0, 0.0)}},
+    STICK_LIMB_PARTS(RIG_RIGHT_SHOULDER, RIG_RIGHT_ELBOW, ~STICK_LINQ_RIGHT),
+    STICK_LIMB_PARTS(RIG_RIGHT_ELBOW, RIG_RIGHT_HAND, ~STICK_LINQ_RIGHT),
+
+    // Head
+    {STICK_HEAD, RIG_JOINT, {RIG_HEAD}, 
+        0, RIG_ALL_STAGES,
+        {{RIG_END}}}
+};
+
+/**
+ *  Characters of the game.
+ */
+const CharacterRig g_ZamusRig = 
+{
+    {RIG_RIGHT_HIP, RIG_LEFT_SHOULDER, RIG_LEFT_HIP, RIG_RIGHT_SHOULDER},
+    sizeof(zamusParts) / sizeof(RigPart),
+    zamusParts
+};
+
+const CharacterRig g_LinqRig = 
+{
+    {RIG_RIGHT_HIP, RIG_LEFT_SHOULDER, RIG_LEFT_HIP, RIG_RIGHT_SHOULDER},
+    sizeof(linqParts) / sizeof(RigPart),
+    linqParts
+};
+
+const CharacterRig g_NeutralRig = 
+{
+    {RIG_RIGHT_SHOULDER, RIG_LEFT_SHOULDER, RIG_RIGHT_HIP, RIG_LEFT_SHOULDER},
+    sizeof(stickParts) / sizeof(RigPart),
+    stickParts
+};
+
+/**
+ *  OpenNI joint of every point that is a joint.
+ */
+static const XnSkeletonJoint rigJoints[RIG_JOINTS] =
+{
+    XN_SKEL_HEAD,
+    XN_SKEL_NECK,
+    XN_SKEL_LEFT_SHOULDER,
+    XN_SKEL_RIGHT_SHOULDER,
+    XN_SKEL_LEFT_HIP,
+    XN_SKEL_RIGHT_HIP,
+    XN_SKEL_TORSO,
+    XN_SKEL_LEFT_ELBOW,
+    XN_SKEL_RIGHT_ELBOW,
+    XN_SKEL_LEFT_HAND,
+    XN_SKEL_RIGHT_HAND,
+    XN_SKEL_LEFT_KNEE,
+    XN_SKEL_RIGHT_KNEE,
+    XN_SKEL_LEFT_FOOT,
+    XN_SKEL_RIGHT_FOOT
+};
+
+/**
+ *  Constructor of the class.
+ */
+RigRenderer :: RigRenderer ()
+{
+    int i;
+
+    for (i = 0; i < RIG_MESHES; i++) {
+        models[i] = NULL;
+        lists[i]  = 0;
+    }
+
+    numRigs      = 0;
+    numInstances = 0;
+    numDrawn     = 0;
+}
+
+/**
+ *  Sets the models of the meshes of the characters.
+ *  @param zamus models of Zamus.
+ *  @param linq models of Linq.
+ */
+void RigRenderer :: changeModels (const ZamusModel &zamus, 
+                                  const LinqModel &linq)
+{
+    int i;
+
+    models[ZAMUS_FOOT]     = zamus.foot;
+    models[ZAMUS_LEG]      = zamus.leg;
+    models[ZAMUS_THIGH]    = zamus.thigh;
+    models[ZAMUS_CHEST]    = zamus.chest;
+    models[ZAMUS_HEAD]     = zamus.head;
+    models[ZAMUS_SHOULDER] = zamus.shoulder;
+    models[ZAMUS_ARM]      = zamus.arm;
+    models[ZAMUS_FOREARM]  = zamus.forearm;
+    models[ZAMUS_CANNON]   = zamus.cannon;
+
+    models[LINQ_FOOT]     = linq.foot;
+    models[LINQ_LEG]      = linq.leg;
+    models[LINQ_THIGH]    = linq.thigh;
+    models[LINQ_CHEST]    = linq.chest;
+    models[LINQ_HEAD]     = linq.head;
+    models[LINQ_SHOULDER] = linq.shoulder;
+    models[LINQ_ARM]      = linq.arm;
+    models[LINQ_FOREARM]  = linq.forearm;
+    models[LINQ_SHIELD]   = linq.shield;
+    models[LINQ_STAFF]    = linq.staff;
+
+    // The lists of the models are compiled again when drawing
+    for (i = 0; i < STICK_LIMB; i++) {
+        lists[i] = 0;
+    }
+}
+
+/**
+ *  Compiles the meshes that have no display list.
+ */
+void RigRenderer :: compileMeshes ()
+{
+    int i;
+    GLUquadricObj *quadric;
+
+    for (i = 0; i < STICK_LIMB; i++) {
+        if (lists[i] == 0) {
+            lists[i] = modelList(models[i]);
+        }
+    }
+
+    if (lists[STICK_LIMB] != 0) {
+        return;
+    }
+
+    // The shapes of the stick figure
+    quadric = gluNewQuadric();
+    gluQuadricNormals(quadric, GLU_SMOOTH);
+    gluQuadricOrientation(quadric, GLU_OUTSIDE);
+
+    lists[STICK_LIMB] = glGenLists(3);
+    lists[STICK_JOINT] = lists[STICK_LIMB] + 1;
+    lists[STICK_HEAD] = lists[STICK_LIMB] + 2;
+
+    glNewList(lists[STICK_LIMB], GL_COMPILE);
+        gluCylinder(quadric, 15.0f, 15.0f, 1.0f, 10, 1);
+    glEndList();
+
+    glNewList(lists[STICK_JOINT], GL_COMPILE);
+        glutSolidSphere(20.0, 10, 10);
+    glEndList();
+
+    glNewList(lists[STICK_HEAD], GL_COMPILE);
+        glutSolidSphere(40.0, 15, 15);
+    glEndList();
+
+    gluDeleteQuadric(quadric);
+}
+
+/**
+ *  Returns where the transformations of a table start, they are
+ *  folded the first time.
+ *  @param rig the table.
+ *  @return index of the first part in transforms.
+ */
+int RigRenderer :: rigTransforms (const CharacterRig &rig)
+{
+    int i;
+    int slot;
+    const RigOp *op;
+    RigTransform *transform;
+    float *m;
+
+    for (slot = 0; slot < numRigs; slot++) {
+        if (rigs[slot] == &rig) {
+            return slot * RIG_MAX_TABLE;
+        }
+    }
+
+    if ((numRigs == RIG_MAX_RIGS) || (rig.numParts > RIG_MAX_TABLE)) {
+        reportError("Too many characters or parts of a character.");
+    }
+
+    rigs[numRigs] = &rig;
+
+    for (i = 0; i < rig.numParts; i++) {
+        transform = &transforms[numRigs * RIG_MAX_TABLE + i];
+
+        identityMatrix(transform -> before);
+        identityMatrix(transform -> after);
+        transform -> user = NULL;
+
+        m = transform -> before;
+
+        for (op = rig.parts[i].ops; (op < rig.parts[i].ops + RIG_MAX_OPS) &&
+                                    (op -> type != RIG_END); op++) {
+
+            // The one of the user splits the others
+            if ((op -> type == RIG_STRETCH) || 
+                ((op -> type == RIG_ROTATE) && (op -> facing != 0.0f))) {
+
+                if (transform -> user != NULL) {
+                    reportError("A part of a character has two "
+                                "transformations of the user.");
+                }
+
+                transform -> user = op;
+                m = transform -> after;
+                continue;
+            }
+
+            switch (op -> type) {
+                case RIG_TRANSLATE:
+                    translateMatrix(m, op -> x, op -> y, op -> z);
+                    break;
+
+                case RIG_SCALE:
+                    scaleMatrix(m, op -> x, op -> y, op -> z);
+                    break;
+
+                case RIG_ROTATE:
+                    rotateMatrix(m, op -> angle, op -> x, op -> y, op -> z);
+                    break;
+            }
+        }
+    }
+
+    return (numRigs++) * RIG_MAX_TABLE;
+}
+
+/**
+ *  Loads the points of the user from his joints.
+ *  @param skeleton joints of the user in the snapshot.
+ *  @param instance character where they are loaded.
+ */
+void RigRenderer :: loadPoints (const SnapshotJoint *skeleton, 
+                                RigInstance &instance)
+{
+    int i;
+    float (*points)[3];
+    XnUInt32 confident;
+    const SnapshotJoint *joint;
+    Vector3D u;
+    Vector3D v;
+    Vector3D w;
+    Vector3D n;
+
+    points = instance.points;
+    confident = 0;
+
+    for (i = 0; i < RIG_JOINTS; i++) {
+        joint = &skeleton[SkeletonSnapshot::jointIndex(rigJoints[i])];
+
+        points[i][0] = joint -> projective.X;
+        points[i][1] = joint -> projective.Y;
+        points[i][2] = joint -> projective.Z;
+
+        if (joint -> confidence >= RIG_MIN_CONFIDENCE) {
+            confident |= RIG_BIT(i);
+        }
+    }
+
+    // The staff points away from the back of the left hand
+    v = Vector3D(points[RIG_LEFT_HAND][0] - points[RIG_LEFT_ELBOW][0],
+                 points[RIG_LEFT_HAND][1] - points[RIG_LEFT_ELBOW][1],
+                 points[RIG_LEFT_HAND][2] - points[RIG_LEFT_ELBOW][2]);
+    u = Vector3D(points[RIG_LEFT_ELBOW][0] - points[RIG_LEFT_SHOULDER][0],
+                 points[RIG_LEFT_ELBOW][1] - points[RIG_LEFT_SHOULDER][1],
+                 points[RIG_LEFT_ELBOW][2] - points[RIG_LEFT_SHOULDER][2]);
+
+    w = v.cross(u);
+    n = v.cross(w);
+
+    points[RIG_STAFF_TIP][0] = points[RIG_LEFT_HAND][0];
+    points[RIG_STAFF_TIP][1] = points[RIG_LEFT_HAND][1] + n.y;
+    points[RIG_STAFF_TIP][2] = points[RIG_LEFT_HAND][2] + n.z;
+
+    // The shield faces out of the plane of the right arm
+    v = Vector3D(points[RIG_RIGHT_HAND][0] - points[RIG_RIGHT_ELBOW][0],
+                 points[RIG_RIGHT_HAND][1] - points[RIG_RIGHT_ELBOW][1],
+                 points[RIG_RIGHT_HAND][2] - points[RIG_RIGHT_ELBOW][2]);
+    u = Vector3D(points[RIG_RIGHT_ELBOW][0] - points[RIG_RIGHT_SHOULDER][0],
+                 points[RIG_RIGHT_ELBOW][1] - points[RIG_RIGHT_SHOULDER][1],
+                 points[RIG_RIGHT_ELBOW][2] - points[RIG_RIGHT_SHOULDER][2]);
+
+    w = v.cross(u);
+
+    for (i = 0; i < 3; i++) {
+        points[RIG_SHIELD_FRONT][i] = points[RIG_RIGHT_ELBOW][i];
+    }
+
+    points[RIG_SHIELD_FRONT][0] += w.x;
+    points[RIG_SHIELD_FRONT][1] += w.y;
+    points[RIG_SHIELD_FRONT][2] += w.z;
+
+    w.normalize();
+
+    points[RIG_SHIELD_CENTER][0] = points[RIG_RIGHT_ELBOW][0] + w.x * 30;
+    points[RIG_SHIELD_CENTER][1] = points[RIG_RIGHT_ELBOW][1] + w.y * 30;
+    points[RIG_SHIELD_CENTER][2] = points[RIG_RIGHT_ELBOW][2] + w.z * 30;
+
+    instance.confident = confident;
+}
+
+/**
+ *  Computes the matrix of a part of the batch.
+ *  @param index position of the part in the batch.
+ *  @param facing angle the user is facing, in degrees.
+ *  @param m the matrix, in the order of OpenGL.
+ */
+void RigRenderer :: partMatrix (int index, float facing, float *m)
+{
+    float placed[16];
+    const RigTransform *transform;
+    const RigOp *op;
+
+    transform = &transforms[drawnTransforms[index]];
+    op = transform -> user;
+
+    if (op == NULL) {
+        multiplyMatrix(bones[index], transform -> before, m);
+        return;
+    }
+
+    multiplyMatrix(bones[index], transform -> before, placed);
+
+    if (op -> type == RIG_STRETCH) {
+        scaleMatrix(placed, 1.0, 1.0, lengths[index]);
+    }
+    else {
+        rotateMatrix(placed, op -> angle + op -> facing * facing,
+                     op -> x, op -> y, op -> z);
+    }
+
+    multiplyMatrix(placed, transform -> after, m);
+}
+
+/**
+ *  Draws the quad of a part.
+ *  @param part part of the character.
+ *  @param instance character of the part.
+ */
+void RigRenderer :: drawQuad (const RigPart &part, 
+                              const RigInstance &instance)
+{
+    int i;
+    const float *p[4];
+    Vector3D ab;
+    Vector3D ac;
+    Vector3D n;
+
+    for (i = 0; i < 4; i++) {
+        p[i] = instance.points[part.points[i]];
+    }
+
+    ab = Vector3D(p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]);
+    ac = Vector3D(p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]);
+
+    n = ab.cross(ac);
+    n.normalize();
+
+    glBegin(GL_QUADS);
+        glNormal3f(n.x, n.y, n.z);
+        for (i = 0; i < 4; i++) {
+            glVertex3fv(p[i]);
+        }
+    glEnd();
+}
+
+/**
+ *  Adds a character over an user to the batch of the frame.
+ *  @param rig character to be drawn.
+ *  @param skeleton joints of the user in the snapshot.
+ *  @param stage stage of the user, for the parts that depend
+ *  on it.
+ *  @param material material set before drawing the character,
+ *  NULL to use the ones of the meshes.
+ */
+void RigRenderer :: add (const CharacterRig &rig, 
+                         const SnapshotJoint *skeleton, 
+                         int stage,
+                         const RigMaterial *material)
+{
+    int i;
+    int k;
+    int first;
+    float length;
+    float u[3];
+    float v[3];
+    float w[3];
+    const float *p1;
+    const float *p2;
+    XnUInt32 stageBit;
+    const RigPart *part;
+    RigInstance *instance;
+
+    if (numInstances == RIG_MAX_CHARACTERS) {
+        return;
+    }
+
+    first = rigTransforms(rig);
+    instance = &instances[numInstances++];
+
+    loadPoints(skeleton, *instance);
+
+    // Angle the user is facing, around the Y axis
+    for (i = 0; i < 3; i++) {
+        u[i] = instance -> points[rig.facing[0]][i] - 
+               instance -> points[rig.facing[1]][i];
+        v[i] = instance -> points[rig.facing[2]][i] - 
+               instance -> points[rig.facing[3]][i];
+    }
+
+    w[0] = u[1] * v[2] - u[2] * v[1];
+    w[2] = u[0] * v[1] - u[1] * v[0];
+
+    length = sqrt(w[0] * w[0] + w[2] * w[2]);
+    instance -> facing = 0.0f;
+
+    if (length > 0.0f) {
+        instance -> facing = 57.2957795 * acos(w[2] / length);
+
+        if (w[0] <= 0.0) {
+            instance -> facing = -instance -> facing;
+        }
+    }
+
+    instance -> hasMaterial = (material != NULL);
+
+    if (material != NULL) {
+        instance -> material = *material;
+    }
+
+    // The parts of the stage, with the points of their bones
+    stageBit = RIG_STAGE(stage);
+    instance -> firstPart = numDrawn;
+
+    for (i = 0; (i < rig.numParts) && 
+                (numDrawn - instance -> firstPart < RIG_MAX_PARTS); i++) {
+        part = &rig.parts[i];
+
+        if (((part -> stages & stageBit) == 0) ||
+            ((part -> confident & instance -> confident) != 
+             part -> confident)) {
+            continue;
+        }
+
+        p1 = instance -> points[part -> points[0]];
+        p2 = (part -> base == RIG_BONE) ? 
+             instance -> points[part -> points[1]] : p1;
+
+        for (k = 0; k < 3; k++) {
+            boneFrom[k][numDrawn] = p1[k];
+            boneTo[k][numDrawn]   = p2[k];
+        }
+
+        drawn[numDrawn] = part;
+        drawnTransforms[numDrawn++] = first + i;
+    }
+
+    instance -> numParts = numDrawn - instance -> firstPart;
+}
+
+/**
+ *  Draws the characters of the batch, in the order they were
+ *  added, and empties it.
+ */
+void RigRenderer :: draw ()
+{
+    int i;
+    int j;
+    int k;
+    float view[16];
+    float model[16];
+    float m[16];
+    const float *from[3];
+    const float *to[3];
+    const RigPart *part;
+    const RigInstance *instance;
+
+    if (numDrawn > 0) {
+        compileMeshes();
+
+        // The last group of four bones is completed
+        for (j = numDrawn; j % 4 != 0; j++) {
+            for (k = 0; k < 3; k++) {
+                boneFrom[k][j] = 0.0f;
+                boneTo[k][j]   = 0.0f;
+            }
+        }
+
+        for (k = 0; k < 3; k++) {
+            from[k] = boneFrom[k];
+            to[k]   = boneTo[k];
+        }
+
+        // The bones of all the characters at once
+        boneMatrices(from, to, numDrawn, bones, lengths);
+
+        glGetFloatv(GL_MODELVIEW_MATRIX, view);
+
+        for (i = 0; i < numInstances; i++) {
+            instance = &instances[i];
+
+            if (instance -> hasMaterial) {
+                glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, 
+                             instance -> material.color);
+                glMaterialfv(GL_FRONT, GL_SPECULAR, 
+                             instance -> material.specular);
+                glMaterialfv(GL_FRONT, GL_SHININESS, 
+                             &instance -> material.shininess);
+            }
+
+            for (j = instance -> firstPart; 
+                 j < instance -> firstPart + instance -> numParts; j++) {
+                part = drawn[j];
+
+                if (part -> base == RIG_QUAD) {
+                    glLoadMatrixf(view);
+                    drawQuad(*part, *instance);
+                    continue;
+                }
+
+                partMatrix(j, instance -> facing, model);
+                multiplyMatrix(view, model, m);
+
+                glLoadMatrixf(m);
+                glCallList(lists[part -> mesh]);
+            }
+        }
+
+        glLoadMatrixf(view);
+    }
+
+    numInstances = 0;
+    numDrawn     = 0;
+}
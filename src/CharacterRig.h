@@ -0,0 +1,491 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file CharacterRig.h
+ *
+ *  @brief Header file for the classes CharacterRig and RigRenderer.
+ *
+ *  This file contains the description of the characters drawn over the
+ *  users as a table of rigid parts, and the renderer that draws any of
+ *  them.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef CHARACTER_RIG_H
+# define CHARACTER_RIG_H
+
+# include "common.h"
+# include "config.h"
+
+# include "../glm/include/glm.h"
+# include "SkeletonSnapshot.h"
+# include "UserTable.h"
+# include "ZamusModel.h"
+# include "LinqModel.h"
+
+/**
+ *  Maximum number of parts of a character and of transformations of a
+ *  part.
+ */
+# define RIG_MAX_PARTS 32
+# define RIG_MAX_OPS 6
+
+/**
+ *  Confidence that the joints of a part need to be drawn.
+ */
+# define RIG_MIN_CONFIDENCE 0.5
+
+/**
+ *  Bit of a point in the confidence mask of a part.
+ */
+# define RIG_BIT(point) (1u << (point))
+
+/**
+ *  Stages of a part. The stages out of 0..30 share the last bit.
+ */
+# define RIG_STAGE(stage) (((stage) >= 0 && (stage) < 31) ? \
+                           (1u << (stage)) : (1u << 31))
+# define RIG_ALL_STAGES 0xffffffffu
+
+/**
+ *  Points of the skeleton used by the parts: the joints, in the order
+ *  of the old drawing code, and some points computed from them.
+ */
+enum RigPoint {
+    RIG_HEAD = 0,
+    RIG_NECK,
+    RIG_LEFT_SHOULDER,
+    RIG_RIGHT_SHOULDER,
+    RIG_LEFT_HIP,
+    RIG_RIGHT_HIP,
+    RIG_TORSO,
+    RIG_LEFT_ELBOW,
+    RIG_RIGHT_ELBOW,
+    RIG_LEFT_HAND,
+    RIG_RIGHT_HAND,
+    RIG_LEFT_KNEE,
+    RIG_RIGHT_KNEE,
+    RIG_LEFT_FOOT,
+    RIG_RIGHT_FOOT,
+
+    // Tip of the staff held in the left hand
+    RIG_STAFF_TIP,
+
+    // Center of the shield in the right forearm, and a point in
+    // front of it
+    RIG_SHIELD_CENTER,
+    RIG_SHIELD_FRONT,
+
+    RIG_POINTS
+};
+
+/**
+ *  Number of points that are joints of the skeleton.
+ */
+# define RIG_JOINTS 15
+
+/**
+ *  Meshes of the parts. The last ones are not models but simple
+ *  shapes for the stick figure.
+ */
+enum RigMesh {
+    ZAMUS_FOOT = 0,
+    ZAMUS_LEG,
+    ZAMUS_THIGH,
+    ZAMUS_CHEST,
+    ZAMUS_HEAD,
+    ZAMUS_SHOULDER,
+    ZAMUS_ARM,
+    ZAMUS_FOREARM,
+    ZAMUS_CANNON,
+
+    LINQ_FOOT,
+    LINQ_LEG,
+    LINQ_THIGH,
+    LINQ_CHEST,
+    LINQ_HEAD,
+    LINQ_SHOULDER,
+    LINQ_ARM,
+    LINQ_FOREARM,
+    LINQ_SHIELD,
+    LINQ_STAFF,
+
+    // Cylinder of length one along Z, ball of a joint, ball of the
+    // head and a quad between four points
+    STICK_LIMB,
+    STICK_JOINT,
+    STICK_HEAD,
+    STICK_QUAD,
+
+    RIG_MESHES
+};
+
+/**
+ *  Where the parts are placed: between two points with the Z axis from
+ *  the first one to the second one, in one point, or a quad between
+ *  four points drawn as is.
+ */
+enum RigBase {
+    RIG_BONE = 0,
+    RIG_JOINT,
+    RIG_QUAD
+};
+
+/**
+ *  Transformations of a part, RIG_END ends the list.
+ */
+enum RigOpType {
+    RIG_END = 0,
+    RIG_TRANSLATE,
+    RIG_SCALE,
+    RIG_ROTATE,
+
+    // Scale of the Z axis by the length of the bone
+    RIG_STRETCH
+};
+
+/**
+ *  @class RigOp
+ *
+ *  @brief Transformation of a part, applied like the OpenGL ones.
+ */
+class RigOp
+{
+    public:
+
+        /**
+         *  Type of the transformation.
+         */
+        int type;
+
+        /**
+         *  Vector of the translation, factors of the scale or axis of
+         *  the rotation.
+         */
+        float x;
+        float y;
+        float z;
+
+        /**
+         *  Angle of the rotation in degrees, and how many times the
+         *  angle the user is facing is added to it.
+         */
+        float angle;
+        float facing;
+};
+
+/**
+ *  @class RigPart
+ *
+ *  @brief A rigid part of a character.
+ */
+class RigPart
+{
+    public:
+
+        /**
+         *  Mesh of the part.
+         */
+        int mesh;
+
+        /**
+         *  Where the part is placed, and its points: the two points
+         *  of a bone, the point of a joint or the four of a quad.
+         */
+        int base;
+        int points[4];
+
+        /**
+         *  Bits of the points that must have enough confidence.
+         */
+        XnUInt32 confident;
+
+        /**
+         *  Bits of the stages of the user where the part is drawn.
+         */
+        XnUInt32 stages;
+
+        /**
+         *  Transformations of the mesh, after it is placed.
+         */
+        RigOp ops[RIG_MAX_OPS];
+};
+
+/**
+ *  @class CharacterRig
+ *
+ *  @brief Description of a character as a list of parts.
+ *
+ *  The parts are drawn in order. Adding a character is adding its
+ *  table, the renderer is the same for all of them.
+ */
+class CharacterRig
+{
+    public:
+
+        /**
+         *  Points used to know where the user is facing: the normal of
+         *  the body is (facing[0] - facing[1]) x (facing[2] - facing[3]).
+         */
+        int facing[4];
+
+        /**
+         *  Number of parts and parts of the character.
+         */
+        int numParts;
+        const RigPart *parts;
+};
+
+/**
+ *  Characters of the game.
+ */
+extern const CharacterRig g_ZamusRig;
+extern const CharacterRig g_LinqRig;
+extern const CharacterRig g_NeutralRig;
+
+/**
+ *  Maximum number of characters of a frame, of different tables and of
+ *  parts in a table.
+ */
+# define RIG_MAX_CHARACTERS USER_SLOTS
+# define RIG_MAX_RIGS 4
+# define RIG_MAX_TABLE 64
+
+/**
+ *  Maximum number of parts drawn in a frame.
+ */
+# define RIG_MAX_BATCH (RIG_MAX_CHARACTERS * RIG_MAX_PARTS)
+
+/**
+ *  @class RigMaterial
+ *
+ *  @brief Material set before drawing a character.
+ */
+class RigMaterial
+{
+    public:
+
+        /**
+         *  Ambient and diffuse color, specular color and shininess.
+         */
+        GLfloat color[4];
+        GLfloat specular[4];
+        GLfloat shininess;
+};
+
+/**
+ *  @class RigTransform
+ *
+ *  @brief Transformations of a part folded into matrices.
+ *
+ *  Only one transformation of a part depends on the user, the rotation
+ *  with the angle he is facing or the stretch to the length of the
+ *  bone. The ones before and after it are multiplied once.
+ */
+class RigTransform
+{
+    public:
+
+        /**
+         *  Product of the transformations before the one of the user.
+         */
+        float before[16];
+
+        /**
+         *  Transformation of the user, NULL if there is none.
+         */
+        const RigOp *user;
+
+        /**
+         *  Product of the transformations after the one of the user.
+         */
+        float after[16];
+};
+
+/**
+ *  @class RigInstance
+ *
+ *  @brief A character drawn over an user in the frame.
+ */
+class RigInstance
+{
+    public:
+
+        /**
+         *  Points of the user and the bits of the confident ones.
+         */
+        float points[RIG_POINTS][3];
+        XnUInt32 confident;
+
+        /**
+         *  Angle the user is facing, in degrees.
+         */
+        float facing;
+
+        /**
+         *  Material of the character, if it has one.
+         */
+        bool hasMaterial;
+        RigMaterial material;
+
+        /**
+         *  Parts of the character in the batch.
+         */
+        int firstPart;
+        int numParts;
+};
+
+/**
+ *  @class RigRenderer
+ *
+ *  @brief Draws the characters over the users.
+ *
+ *  The characters of a frame are added to a batch and drawn together.
+ *  The matrices of the bones of all of them are built in one pass, with
+ *  quaternions and four bones at a time, and every part is drawn with
+ *  one glLoadMatrix and the display list of its mesh. The meshes are
+ *  compiled into display lists the first time they are drawn.
+ */
+class RigRenderer
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        RigRenderer();
+
+        /**
+         *  Class destructor.
+         */
+        ~RigRenderer() {}
+
+        /**
+         *  Sets the models of the meshes of the characters.
+         *  @param zamus models of Zamus.
+         *  @param linq models of Linq.
+         */
+        void changeModels(const ZamusModel &zamus, const LinqModel &linq);
+
+        /**
+         *  Adds a character over an user to the batch of the frame.
+         *  @param rig character to be drawn.
+         *  @param skeleton joints of the user in the snapshot.
+         *  @param stage stage of the user, for the parts that depend
+         *  on it.
+         *  @param material material set before drawing the character,
+         *  NULL to use the ones of the meshes.
+         */
+        void add(const CharacterRig &rig, 
+                 const SnapshotJoint *skeleton, 
+                 int stage,
+                 const RigMaterial *material = NULL);
+
+        /**
+         *  Draws the characters of the batch, in the order they were
+         *  added, and empties it.
+         */
+        void draw();
+
+    private:
+
+        /**
+         *  Models of the meshes and their display lists, 0 until they
+         *  are compiled.
+         */
+        GLMmodel *models[RIG_MESHES];
+        GLuint lists[RIG_MESHES];
+
+        /**
+         *  Tables already folded into matrices, and the matrices of
+         *  their parts, RIG_MAX_TABLE by table.
+         */
+        const CharacterRig *rigs[RIG_MAX_RIGS];
+        int numRigs;
+        RigTransform transforms[RIG_MAX_RIGS * RIG_MAX_TABLE];
+
+        /**
+         *  Characters of the batch.
+         */
+        RigInstance instances[RIG_MAX_CHARACTERS];
+        int numInstances;
+
+        /**
+         *  Parts of the batch, with their transformations.
+         */
+        const RigPart *drawn[RIG_MAX_BATCH];
+        int drawnTransforms[RIG_MAX_BATCH];
+        int numDrawn;
+
+        /**
+         *  Points of the bones of the parts, one array by axis, and
+         *  their matrices and lengths. The point of a joint is the
+         *  start and the end of its bone.
+         */
+        float boneFrom[3][RIG_MAX_BATCH];
+        float boneTo[3][RIG_MAX_BATCH];
+        float bones[RIG_MAX_BATCH][16];
+        float lengths[RIG_MAX_BATCH];
+
+        /**
+         *  Compiles the meshes that have no display list.
+         */
+        void compileMeshes();
+
+        /**
+         *  Returns where the transformations of a table start, they
+         *  are folded the first time.
+         *  @param rig the table.
+         *  @return index of the first part in transforms.
+         */
+        int rigTransforms(const CharacterRig &rig);
+
+        /**
+         *  Loads the points of the user from his joints.
+         *  @param skeleton joints of the user in the snapshot.
+         *  @param instance character where they are loaded.
+         */
+        void loadPoints(const SnapshotJoint *skeleton, RigInstance &instance);
+
+        /**
+         *  Computes the matrix of a part of the batch.
+         *  @param index position of the part in the batch.
+         *  @param facing angle the user is facing, in degrees.
+         *  @param m the matrix, in the order of OpenGL.
+         */
+        void partMatrix(int index, float facing, float *m);
+
+        /**
+         *  Draws the quad of a part.
+         *  @param part part of the character.
+         *  @param instance character of the part.
+         */
+        void drawQuad(const RigPart &part, const RigInstance &instance);
+};
+
+# endif
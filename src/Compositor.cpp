@@ -0,0 +1,237 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Compositor.cpp
+ *
+ *  @brief Implementation file of the composition of the camera image.
+ *
+ *  This file contains the function that copies the camera image into
+ *  the overlay with the pixels of the users in blue.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <emmintrin.h>
+
+# include "Compositor.h"
+
+/**
+ *  Masks of the blue bytes of sixteen pixels, that are 48 bytes in
+ *  three vectors. The first vector has the blue of the pixels 0 to 4,
+ *  the second of 5 to 9 and the third of 10 to 15. They are indexed
+ *  by the bits of those pixels.
+ */
+static __m128i firstBlues[32];
+static __m128i secondBlues[32];
+static __m128i thirdBlues[64];
+static bool bluesBuilt = false;
+
+/**
+ *  Fills a table of masks of blue bytes.
+ *  @param table the table.
+ *  @param pixels number of pixels of the vector, the table has
+ *  2^pixels masks.
+ *  @param firstBlue byte of the blue of the first pixel.
+ */
+static void buildBlues(__m128i *table, int pixels, int firstBlue)
+{
+    int bits;
+    int i;
+    unsigned char bytes[16];
+
+    for (bits = 0; bits < (1 << pixels); bits++) {
+        for (i = 0; i < 16; i++) {
+            bytes[i] = 0;
+        }
+
+        for (i = 0; i < pixels; i++) {
+            if (bits & (1 << i)) {
+                bytes[firstBlue + 3 * i] = 0xff;
+            }
+        }
+
+        table[bits] = _mm_loadu_si128((const __m128i*) bytes);
+    }
+}
+
+/**
+ *  Returns if a label is of an user.
+ */
+static inline bool isUser(XnLabel label)
+{
+    return (label != 0) && (label <= MAX_USERS);
+}
+
+/**
+ *  Returns a border in pixels, inside 0..size.
+ */
+static unsigned int cropBorder(float border, unsigned int size)
+{
+    border = floor(border + 0.5);
+
+    return (unsigned int) max(0.0f, min((float) size, border));
+}
+
+/**
+ *  Returns the window of an image without the borders of CROPUP,
+ *  CROPDOWN, CROPLEFT and CROPRIGHT. The borders are parts of the size
+ *  of the texture, like the coordinates of the texture.
+ *  @param xRes width of the image.
+ *  @param yRes height of the image.
+ *  @param texResX width of the texture.
+ *  @param texResY height of the texture.
+ *  @return the window, inside the image.
+ */
+CropWindow cropWindow (unsigned int xRes, 
+                       unsigned int yRes,
+                       unsigned int texResX, 
+                       unsigned int texResY)
+{
+    CropWindow window;
+    unsigned int right;
+    unsigned int bottom;
+
+    window.left = cropBorder(CROPLEFT * texResX, xRes);
+    window.top  = cropBorder(CROPUP * texResY, yRes);
+
+    right  = cropBorder(xRes + CROPRIGHT * texResX, xRes);
+    bottom = cropBorder(yRes + CROPDOWN * texResY, yRes);
+
+    window.width  = (right > window.left) ? right - window.left : 0;
+    window.height = (bottom > window.top) ? bottom - window.top : 0;
+
+    return window;
+}
+
+/**
+ *  Copies a window of the camera image into the overlay. The pixels
+ *  with the label of an user get the blue of USER_PIXEL_BLUE, sixteen
+ *  pixels are done at a time.
+ *  @param image the camera image.
+ *  @param labels the label map, of the same size than the image.
+ *  @param xRes width of the image and the label map.
+ *  @param left first column of the window.
+ *  @param top first row of the window.
+ *  @param width width of the window.
+ *  @param height height of the window.
+ *  @param overlay the window, without padding.
+ */
+void compositeUsers(const XnRGB24Pixel *image,
+                    const XnLabel *labels,
+                    unsigned int xRes,
+                    unsigned int left,
+                    unsigned int top,
+                    unsigned int width,
+                    unsigned int height,
+                    XnRGB24Pixel *overlay)
+{
+    unsigned int x;
+    unsigned int y;
+    int bits;
+    const XnRGB24Pixel *imageRow;
+    const XnLabel *labelRow;
+    const __m128i *source;
+    __m128i *target;
+    __m128i bias;
+    __m128i noUser;
+    __m128i lastUser;
+    __m128i blue;
+    __m128i first;
+    __m128i second;
+    __m128i users;
+
+    if (!bluesBuilt) {
+        buildBlues(firstBlues, 5, 2);
+        buildBlues(secondBlues, 5, 1);
+        buildBlues(thirdBlues, 6, 0);
+        bluesBuilt = true;
+    }
+
+    // The labels are unsigned, the comparisons are signed
+    bias     = _mm_set1_epi16((short) 0x8000);
+    noUser   = _mm_set1_epi16((short) 0x8000);
+    lastUser = _mm_set1_epi16((short) (0x8000 + MAX_USERS + 1));
+    blue     = _mm_set1_epi8((char) USER_PIXEL_BLUE);
+
+    for (y = 0; y < height; y++) {
+        imageRow = image + (top + y) * xRes + left;
+        labelRow = labels + (top + y) * xRes + left;
+
+        for (x = 0; x + 16 <= width; x += 16) {
+
+            // One bit by pixel of an user
+            first  = _mm_xor_si128(
+                         _mm_loadu_si128((const __m128i*) &labelRow[x]), bias);
+            second = _mm_xor_si128(
+                         _mm_loadu_si128((const __m128i*) &labelRow[x + 8]), 
+                         bias);
+
+            first  = _mm_and_si128(_mm_cmpgt_epi16(first, noUser),
+                                   _mm_cmplt_epi16(first, lastUser));
+            second = _mm_and_si128(_mm_cmpgt_epi16(second, noUser),
+                                   _mm_cmplt_epi16(second, lastUser));
+
+            bits = _mm_movemask_epi8(_mm_packs_epi16(first, second));
+
+            // The 48 bytes of the pixels, with the blue of the users
+            source = (const __m128i*) &imageRow[x];
+            target = (__m128i*) &overlay[x];
+
+            users = firstBlues[bits & 0x1f];
+            _mm_storeu_si128(&target[0], 
+                             _mm_or_si128(
+                                 _mm_andnot_si128(users, 
+                                                  _mm_loadu_si128(&source[0])),
+                                 _mm_and_si128(users, blue)));
+
+            users = secondBlues[(bits >> 5) & 0x1f];
+            _mm_storeu_si128(&target[1], 
+                             _mm_or_si128(
+                                 _mm_andnot_si128(users, 
+                                                  _mm_loadu_si128(&source[1])),
+                                 _mm_and_si128(users, blue)));
+
+            users = thirdBlues[bits >> 10];
+            _mm_storeu_si128(&target[2], 
+                             _mm_or_si128(
+                                 _mm_andnot_si128(users, 
+                                                  _mm_loadu_si128(&source[2])),
+                                 _mm_and_si128(users, blue)));
+        }
+
+        // The pixels left of the row
+        for (; x < width; x++) {
+            overlay[x] = imageRow[x];
+
+            if (isUser(labelRow[x])) {
+                overlay[x].nBlue = USER_PIXEL_BLUE;
+            }
+        }
+
+        overlay += width;
+    }
+}
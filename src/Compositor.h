@@ -0,0 +1,104 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Compositor.h
+ *
+ *  @brief Header file of the composition of the camera image.
+ *
+ *  This file contains the function that copies the camera image into
+ *  the overlay with the pixels of the users in blue.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef COMPOSITOR_H
+# define COMPOSITOR_H
+
+# include "common.h"
+# include "config.h"
+
+/**
+ *  Blue of the pixels of the users in the overlay.
+ */
+# define USER_PIXEL_BLUE 200
+
+/**
+ *  @class CropWindow
+ *
+ *  @brief Part of the camera image that is shown.
+ */
+class CropWindow
+{
+    public:
+
+        /**
+         *  First column and row, and size of the window.
+         */
+        unsigned int left;
+        unsigned int top;
+        unsigned int width;
+        unsigned int height;
+};
+
+/**
+ *  Returns the window of an image without the borders of CROPUP,
+ *  CROPDOWN, CROPLEFT and CROPRIGHT. The borders are parts of the size
+ *  of the texture, like the coordinates of the texture.
+ *  @param xRes width of the image.
+ *  @param yRes height of the image.
+ *  @param texResX width of the texture.
+ *  @param texResY height of the texture.
+ *  @return the window, inside the image.
+ */
+CropWindow cropWindow(unsigned int xRes, 
+                      unsigned int yRes,
+                      unsigned int texResX, 
+                      unsigned int texResY);
+
+/**
+ *  Copies a window of the camera image into the overlay. The pixels
+ *  with the label of an user get the blue of USER_PIXEL_BLUE, sixteen
+ *  pixels are done at a time.
+ *  @param image the camera image.
+ *  @param labels the label map, of the same size than the image.
+ *  @param xRes width of the image and the label map.
+ *  @param left first column of the window.
+ *  @param top first row of the window.
+ *  @param width width of the window.
+ *  @param height height of the window.
+ *  @param overlay the window, without padding.
+ */
+void compositeUsers(const XnRGB24Pixel *image,
+                    const XnLabel *labels,
+                    unsigned int xRes,
+                    unsigned int left,
+                    unsigned int top,
+                    unsigned int width,
+                    unsigned int height,
+                    XnRGB24Pixel *overlay);
+
+# endif
@@ -39,7 +39,9 @@
 Flame :: Flame ()
 {
     position = Vector3D();
+    lastPosition = position;
     hp = 0.0;
+    spin = 0.0;
     flameModel = NULL;
     dimensions[0] = 0.0;
     dimensions[1] = 0.0;
@@ -52,13 +54,23 @@ Flame :: Flame ()
  *  @param pos is the position of the Flame.
  *  @param lifePoint is how much hp will have the Flame.
  *  @param model is the pointer to the flame model loaded by GLM. 
+ *  @param spinPhase is the initial angle of the flame in degrees.
  */
-Flame :: Flame (Vector3D pos, int lifePoint, GLMmodel *model)
+Flame :: Flame (Vector3D pos, int lifePoint, GLMmodel *model, float spinPhase)
 {
     position = pos;
+    lastPosition = pos;
     hp = lifePoint;
+    spin = spinPhase;
     flameModel = model;
+
+# ifndef SFB_HEADLESS
     glmDimensions(flameModel, dimensions);
+# else
+    dimensions[0] = 0.0;
+    dimensions[1] = 0.0;
+    dimensions[2] = 0.0;
+# endif
 }
 
 /**
@@ -96,7 +108,13 @@ int Flame :: extinguish ()
  */
 void Flame :: advance (float distance)
 {
+    lastPosition = position;
     position.z += distance;
+
+    spin += FLAME_SPIN_SPEED;
+    if (spin >= 360.0) {
+        spin -= 360.0;
+    }
 }
 
 /**
@@ -128,9 +146,9 @@ bool Flame :: isInBoundingBox (Vector3D shoot)
      *  result.
      */
 
-    width  = 50 + (hp * 100);
-    height = 50 + (hp * 100);
-    depth  = 50 + (hp * 100);
+    width  = boundingSize();
+    height = boundingSize();
+    depth  = boundingSize();
 
     diffFlameShoot[0] = fabs(shoot.x - position.x);
     diffFlameShoot[1] = fabs(shoot.y - position.y);
@@ -156,54 +174,42 @@ bool Flame :: isInBoundingBox (Vector3D shoot)
     
 }
 
+# ifndef SFB_HEADLESS
+
 /**
- *  Draw the flame in OpenGL.
+ *  Adds the flame to the batch of the frame, with its shadow.
+ *
+ *  @param batch batch of the flames.
+ *  @param alpha part of a tick since the last advance, the flame is
+ *  drawn between its last two positions.
  */
-void Flame :: drawFlame ()
+void Flame :: addToBatch (FlameBatch &batch, float alpha)
 {
-    int mode;
     float alfa;
-    float scale;
+    Vector3D drawn;
 
-    mode = GLM_SMOOTH | GLM_MATERIAL;
+    // The spin of the last tick is interpolated like the position
+    alfa = spin - FLAME_SPIN_SPEED * (1.0f - alpha);
 
-    alfa = (float)rand() / (float)RAND_MAX;
-    alfa += rand() % 360;
+    drawn = drawPosition(alpha);
 
-    scale = (float)hp / 2.0f;
-
-    glPushMatrix();
-        glTranslatef(position.x, position.y, position.z);
-        glScalef(scale, scale, scale);
-      
-        glRotatef(180, 1.0, 0.0, 0.0);
-        glRotatef(alfa, 0.0, 1.0, 0.0);
-        glmDraw(flameModel, mode);
-        
-    glPopMatrix();
+    batch.add(drawn.x, drawn.y, drawn.z, hp, alfa);
 }
 
 /**
- *  Draw Shadow.
- *  Draws a shadown at the floor level.
- *  This is helfull to the users to get a better perspective
- *  on where is the actually the flame.
+ *  Returns the position where the flame is drawn.
  *
- *  @param floorLevel is a value in the Y axis where the shadows
- *  will be drawn
+ *  @param alpha part of a tick since the last advance.
  */
-void Flame :: drawShadow (float floorLevel)
+Vector3D Flame :: drawPosition (float alpha)
 {
-    GLfloat shadowColor[] = {0.0f, 0.0f, 0.0f, 1.0f};
-    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, shadowColor);
-
-    glPushMatrix();
-        glTranslatef( position.x, floorLevel, position.z);
-        glScalef(hp, 0.1, hp);
-        glutSolidSphere(40.0, 2, 20);
-    glPopMatrix();
+    return Vector3D(lastPosition.x + (position.x - lastPosition.x) * alpha,
+                    lastPosition.y + (position.y - lastPosition.y) * alpha,
+                    lastPosition.z + (position.z - lastPosition.z) * alpha);
 }
 
+# endif
+
 /**
  *  Get z position of the flame.
  */
@@ -211,3 +217,20 @@ float Flame :: getZPos ()
 {
     return position.z;
 }
+
+/**
+ *  Get the position of the flame.
+ */
+Vector3D Flame :: getPosition ()
+{
+    return position;
+}
+
+/**
+ *  Get the half of the side of the bounding box, it shrinks with
+ *  the hp.
+ */
+float Flame :: boundingSize ()
+{
+    return 50 + (hp * 100);
+}
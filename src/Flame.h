@@ -35,9 +35,13 @@
 
 # define FLAME
 
-# include "../glm/include/glm.h"
 # include "common.h"
 
+# ifndef SFB_HEADLESS
+# include "../glm/include/glm.h"
+# include "FlameBatch.h"
+# endif
+
 /**
  *  @class Flame
  *
@@ -67,8 +71,9 @@ class Flame {
          *  @param pos is the position of the Flame.
          *  @param lifePoint is how much hp will have the Flame.
          *  @param model is the pointer to the flame model loaded by GLM. 
+         *  @param spinPhase is the initial angle of the flame in degrees.
          */
-        Flame (Vector3D pos, int lifePoint, GLMmodel *model);
+        Flame (Vector3D pos, int lifePoint, GLMmodel *model, float spinPhase);
 
         /**
          *  Destructor
@@ -105,27 +110,35 @@ class Flame {
          */
         void advance(float distance);
 
-        /**
-         *  Draw the flame in OpenGL.
-         */
-        void drawFlame();
+# ifndef SFB_HEADLESS
 
         /**
-         *  Draw Shadow.
-         *  Draws a shadown at the floor level.
-         *  This is helfull to the users to get a better perspective
-         *  on where is the actually the flame.
+         *  Adds the flame to the batch of the frame, with its shadow.
          *
-         *  @param floorLevel is a value in the Y axis where the shadows
-         *  will be drawn
+         *  @param batch batch of the flames.
+         *  @param alpha part of a tick since the last advance, the
+         *  flame is drawn between its last two positions.
          */
-        void drawShadow(float floorLevel);
+        void addToBatch(FlameBatch &batch, float alpha);
+
+# endif
 
         /**
          *  Get z position of the flame.
          */
         float getZPos();
 
+        /**
+         *  Get the position of the flame.
+         */
+        Vector3D getPosition();
+
+        /**
+         *  Get the half of the side of the bounding box, it shrinks
+         *  with the hp.
+         */
+        float boundingSize();
+
     private:
 
         /**
@@ -133,7 +146,7 @@ class Flame {
          *
          *  (width, height, depth)
          */
-        GLfloat dimensions[3];
+        float dimensions[3];
 
         /**
          *  Pointer to flame model.
@@ -144,11 +157,33 @@ class Flame {
          *  Position of the flame
          */
         Vector3D position;
+
+        /**
+         *  Position of the flame before the last advance.
+         */
+        Vector3D lastPosition;
+
+# ifndef SFB_HEADLESS
+
+        /**
+         *  Returns the position where the flame is drawn.
+         *
+         *  @param alpha part of a tick since the last advance.
+         */
+        Vector3D drawPosition(float alpha);
+
+# endif
         
         /**
          *  Health points
          */
         int hp;
+
+        /**
+         *  Angle of the flame around the Y axis in degrees, it
+         *  grows FLAME_SPIN_SPEED in every advance.
+         */
+        float spin;
 };
 
 
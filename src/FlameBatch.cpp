@@ -0,0 +1,181 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file FlameBatch.cpp
+ *
+ *  @brief Implementation of the class FlameBatch.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <xmmintrin.h>
+
+# include "FlameBatch.h"
+# include "ModelCache.h"
+
+/**
+ *  Constructor of the class.
+ */
+FlameBatch :: FlameBatch ()
+{
+    shadowList = 0;
+}
+
+/**
+ *  Adds a flame to the batch of the frame.
+ *  @param x,y,z position of the flame.
+ *  @param size size of the flame, its hp. The flame is drawn with half
+ *  of it and the shadow with all of it.
+ *  @param spin angle of the flame around the Y axis in degrees.
+ */
+void FlameBatch :: add (float x, float y, float z, float size, float spin)
+{
+    posX.push_back(x);
+    posY.push_back(y);
+    posZ.push_back(z);
+    sizes.push_back(size);
+    spins.push_back(spin);
+}
+
+/**
+ *  Draws the flames of the batch and their shadows, and empties it.
+ *  @param model model of the flames.
+ *  @param floorLevel value in the Y axis where the shadows are drawn.
+ */
+void FlameBatch :: draw (GLMmodel *model, float floorLevel)
+{
+    float view[16];
+
+    if (posX.empty()) {
+        return;
+    }
+
+    // The shadow was a new sphere for every flame
+    if (shadowList == 0) {
+        shadowList = glGenLists(1);
+        glNewList(shadowList, GL_COMPILE);
+        glutSolidSphere(40.0, 2, 20);
+        glEndList();
+    }
+
+    glGetFloatv(GL_MODELVIEW_MATRIX, view);
+
+    drawFlames(modelList(model), view);
+    drawShadows(floorLevel, view);
+
+    glLoadMatrixf(view);
+
+    // The arrays keep their room for the next frame
+    posX.clear();
+    posY.clear();
+    posZ.clear();
+    sizes.clear();
+    spins.clear();
+}
+
+/**
+ *  Draws the flames of the batch.
+ *  @param list display list of the model.
+ *  @param view the matrix of the view, in the order of OpenGL.
+ */
+void FlameBatch :: drawFlames (GLuint list, const float *view)
+{
+    unsigned int i;
+    float angle;
+    float scale;
+    float m[16];
+
+    __m128 v0, v1, v2, v3;
+    __m128 c, s;
+
+    v0 = _mm_loadu_ps(view);
+    v1 = _mm_loadu_ps(view + 4);
+    v2 = _mm_loadu_ps(view + 8);
+    v3 = _mm_loadu_ps(view + 12);
+
+    for (i = 0; i < posX.size(); i++) {
+        angle = spins[i] * (float)M_PI / 180.0f;
+        scale = sizes[i] / 2.0f;
+
+        c = _mm_set1_ps(scale * cosf(angle));
+        s = _mm_set1_ps(scale * sinf(angle));
+
+        // The view by the translation, the scale, the half turn about
+        // X that puts the model upside up and the spin about Y. The
+        // columns of the model are (c, 0, s), (0, -1, 0), (s, 0, -c).
+        _mm_storeu_ps(m, _mm_add_ps(_mm_mul_ps(c, v0), _mm_mul_ps(s, v2)));
+        _mm_storeu_ps(m + 4, _mm_mul_ps(_mm_set1_ps(-scale), v1));
+        _mm_storeu_ps(m + 8, _mm_sub_ps(_mm_mul_ps(s, v0), _mm_mul_ps(c, v2)));
+        _mm_storeu_ps(m + 12, 
+                      _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(posX[i]), v0),
+                                            _mm_mul_ps(_mm_set1_ps(posY[i]), v1)),
+                                 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(posZ[i]), v2),
+                                            v3)));
+
+        glLoadMatrixf(m);
+        glCallList(list);
+    }
+}
+
+/**
+ *  Draws the shadows of the flames of the batch.
+ *  @param floorLevel value in the Y axis of the shadows.
+ *  @param view the matrix of the view, in the order of OpenGL.
+ */
+void FlameBatch :: drawShadows (float floorLevel, const float *view)
+{
+    unsigned int i;
+    float m[16];
+
+    __m128 v0, v2;
+    __m128 floor;
+
+    GLfloat shadowColor[] = {0.0f, 0.0f, 0.0f, 1.0f};
+    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, shadowColor);
+
+    v0 = _mm_loadu_ps(view);
+    v2 = _mm_loadu_ps(view + 8);
+
+    // The Y axis is the same for all of them, flattened to the floor,
+    // and so the part of the translation in Y
+    _mm_storeu_ps(m + 4, _mm_mul_ps(_mm_set1_ps(0.1f), _mm_loadu_ps(view + 4)));
+    floor = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(floorLevel), 
+                                  _mm_loadu_ps(view + 4)),
+                       _mm_loadu_ps(view + 12));
+
+    for (i = 0; i < posX.size(); i++) {
+        _mm_storeu_ps(m, _mm_mul_ps(_mm_set1_ps(sizes[i]), v0));
+        _mm_storeu_ps(m + 8, _mm_mul_ps(_mm_set1_ps(sizes[i]), v2));
+        _mm_storeu_ps(m + 12, 
+                      _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(posX[i]), v0),
+                                            _mm_mul_ps(_mm_set1_ps(posZ[i]), v2)),
+                                 floor));
+
+        glLoadMatrixf(m);
+        glCallList(shadowList);
+    }
+}
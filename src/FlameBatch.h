@@ -0,0 +1,120 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file FlameBatch.h
+ *
+ *  @brief Header file for the class FlameBatch.
+ *
+ *  This file contains the batch where the flames of a frame are drawn
+ *  together with their shadows.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef FLAME_BATCH_H
+# define FLAME_BATCH_H
+
+# include "common.h"
+# include "../glm/include/glm.h"
+
+/**
+ *  @class FlameBatch
+ *
+ *  @brief Draws the flames of a frame and their shadows.
+ *
+ *  A flame only needs its position, its size and its spin, they are
+ *  kept in one array each. The batch is drawn in two passes, first the
+ *  flames with the display list of the model and then the shadows with
+ *  the display list of a flat sphere, so the material of the shadows
+ *  is set once. The matrix of every instance is built from the columns
+ *  of the view with SSE and loaded with glLoadMatrix, there are no
+ *  pushes nor rotations by flame.
+ */
+class FlameBatch
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        FlameBatch();
+
+        /**
+         *  Class destructor.
+         */
+        ~FlameBatch() {}
+
+        /**
+         *  Adds a flame to the batch of the frame.
+         *  @param x,y,z position of the flame.
+         *  @param size size of the flame, its hp. The flame is drawn
+         *  with half of it and the shadow with all of it.
+         *  @param spin angle of the flame around the Y axis in degrees.
+         */
+        void add(float x, float y, float z, float size, float spin);
+
+        /**
+         *  Draws the flames of the batch and their shadows, and empties
+         *  it.
+         *  @param model model of the flames.
+         *  @param floorLevel value in the Y axis where the shadows are
+         *  drawn.
+         */
+        void draw(GLMmodel *model, float floorLevel);
+
+    private:
+
+        /**
+         *  Display list of the shadow, 0 until it is compiled.
+         */
+        GLuint shadowList;
+
+        /**
+         *  Positions, sizes and spins of the flames.
+         */
+        vector <float> posX;
+        vector <float> posY;
+        vector <float> posZ;
+        vector <float> sizes;
+        vector <float> spins;
+
+        /**
+         *  Draws the flames of the batch.
+         *  @param list display list of the model.
+         *  @param view the matrix of the view, in the order of OpenGL.
+         */
+        void drawFlames(GLuint list, const float *view);
+
+        /**
+         *  Draws the shadows of the flames of the batch.
+         *  @param floorLevel value in the Y axis of the shadows.
+         *  @param view the matrix of the view, in the order of OpenGL.
+         */
+        void drawShadows(float floorLevel, const float *view);
+};
+
+# endif
@@ -32,10 +32,13 @@
 #ifndef FLAMEMODEL_H
 #define FLAMEMODEL_H
 
-# include "../glm/include/glm.h"
 # include "common.h"
 # include "config.h"
 
+# ifndef SFB_HEADLESS
+# include "../glm/include/glm.h"
+# endif
+
 /**
  *  @class FlameModel
  *
@@ -59,11 +62,13 @@ class FlameModel
                 
             flame = NULL;
            
+# ifndef SFB_HEADLESS
             if (!flame) {
                 flame = glmReadOBJ("./models/flameobj/flame.obj");
                 glmUnitize(flame);
                 glmScale(flame, 150);
             }
+# endif
         }
 
 };
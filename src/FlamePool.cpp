@@ -0,0 +1,100 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file FlamePool.cpp
+ *
+ *  @brief Implementation file for the class FlamePool.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class FlamePool.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "FlamePool.h"
+
+/**
+ *  Constructor of the class.
+ *  @param size number of slots.
+ */
+FlamePool :: FlamePool (int size)
+{
+    slots = vector <Flame> (size, Flame());
+    alive.reserve(size);
+    freeSlots.reserve(size);
+    clear();
+}
+
+/**
+ *  Adds a flame to the pool.
+ *  @param flame flame to be added.
+ *  @return slot of the flame, -1 if the pool is full.
+ */
+int FlamePool :: add (const Flame& flame)
+{
+    int slot;
+
+    if (freeSlots.empty()) {
+        return -1;
+    }
+
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    slots[slot] = flame;
+    alive.push_back(slot);
+
+    return slot;
+}
+
+/**
+ *  Removes the flame i of the pool, the last flame takes its place.
+ *  @param i index of the flame.
+ */
+void FlamePool :: remove (int i)
+{
+    freeSlots.push_back(alive[i]);
+
+    alive[i] = alive.back();
+    alive.pop_back();
+}
+
+/**
+ *  Removes all the flames.
+ */
+void FlamePool :: clear ()
+{
+    int i;
+
+    alive.clear();
+    freeSlots.clear();
+
+    // The first slots are used first
+    for (i = slots.size() - 1; i >= 0; i--) {
+        freeSlots.push_back(i);
+    }
+}
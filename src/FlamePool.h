@@ -0,0 +1,133 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file FlamePool.h
+ *
+ *  @brief Header file for the class FlamePool.
+ *
+ *  This file contains the definition of the class FlamePool, where
+ *  the flames of the game are stored.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef FLAME_POOL_H
+# define FLAME_POOL_H
+
+# include "common.h"
+# include "config.h"
+# include "Flame.h"
+
+/**
+ *  @class FlamePool
+ *
+ *  @brief Pool of flames with a fixed number of slots.
+ *
+ *  A flame keeps its slot while it is alive. The free slots are kept
+ *  in a stack and the slots in use in a dense list, the flame i of the
+ *  pool is the i-th slot of that list. When a flame is removed the
+ *  last one of the list takes its place, so the order of the flames
+ *  changes.
+ */
+class FlamePool
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         *  @param size number of slots.
+         */
+        FlamePool(int size = MAX_FIREBALLS);
+
+        /**
+         *  Class destructor.
+         */
+        ~FlamePool() {}
+
+        /**
+         *  Adds a flame to the pool.
+         *  @param flame flame to be added.
+         *  @return slot of the flame, -1 if the pool is full.
+         */
+        int add(const Flame& flame);
+
+        /**
+         *  Removes the flame i of the pool, the last flame takes its
+         *  place.
+         *  @param i index of the flame.
+         */
+        void remove(int i);
+
+        /**
+         *  Removes all the flames.
+         */
+        void clear();
+
+        /**
+         *  Returns the number of flames in the pool.
+         */
+        int size() 
+        {
+            return alive.size();
+        }
+
+        /**
+         *  Indicates if there are no free slots.
+         */
+        bool isFull() 
+        {
+            return freeSlots.empty();
+        }
+
+        /**
+         *  Returns the flame i of the pool.
+         *  @param i index of the flame.
+         */
+        Flame& operator[](int i)
+        {
+            return slots[alive[i]];
+        }
+
+    private:
+
+        /**
+         *  Flames of every slot.
+         */
+        vector <Flame> slots;
+
+        /**
+         *  Stack of the free slots.
+         */
+        vector <int> freeSlots;
+
+        /**
+         *  Slots in use.
+         */
+        vector <int> alive;
+};
+
+# endif
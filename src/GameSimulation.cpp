@@ -0,0 +1,204 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file GameSimulation.cpp
+ *
+ *  @brief Implementation of the class GameSimulation.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "GameSimulation.h"
+
+/**
+ *  Constructor of the class.
+ *  @param ud pointer to the user detector fed with the frames.
+ *  @param maxPlayers number of players of the game.
+ *  @param seed seed of the random numbers of the game.
+ */
+GameSimulation :: GameSimulation (UserDetector *ud, 
+                                  int maxPlayers, 
+                                  unsigned int seed)
+{
+    userDetector   = ud;
+    projectiles    = new ProjectileSystem();
+    zamusDetector  = new Zamus(userDetector, projectiles);
+    linqDetector   = new Linq(userDetector, projectiles);
+    busterDetector = new BusterDetector(zamusDetector, userDetector);
+    iceRodDetector = new IceRodDetector(linqDetector, userDetector);
+    game           = new SuperFiremanBrothers(userDetector,
+                                              zamusDetector,
+                                              linqDetector,
+                                              maxPlayers);
+    game -> setSeed(seed);
+}
+
+
+/**
+ *  Class destructor.
+ */
+GameSimulation :: ~GameSimulation ()
+{
+    delete game;
+    delete iceRodDetector;
+    delete busterDetector;
+    delete linqDetector;
+    delete zamusDetector;
+    delete projectiles;
+}
+
+
+/**
+ *  Reads a new sensor frame.
+ *
+ *  Checks the players and detects the poses, the game
+ *  advances in advanceTo().
+ *  @param frame new sensor frame.
+ */
+void GameSimulation :: step (const SensorFrame *frame)
+{
+    // The poses can be changed while the game runs, before the
+    // features of the frame are computed
+    g_PoseLibrary.reloadIfChanged();
+
+    {
+        ProfileZone zone(PROFILE_CHECK_USERS);
+
+        userDetector -> updateFrame(frame);
+
+        // Checking fot game starting and finishing
+        game -> checkUsers();
+
+        // The feet stomp once by frame, not in every tick
+        game -> readFeet();
+    }
+
+    {
+        ProfileZone zone(PROFILE_DETECT_POSE);
+
+        if (game -> isGameOn()) {
+            
+            userDetector -> changeStopDetection(true);
+            game -> checkGameOver();
+
+            if (!game -> isGameOver()) {
+                busterDetector -> detectPose();
+                iceRodDetector -> detectPose();
+            } 
+        }
+        else {
+            // Detects poses
+            zamusDetector -> detectPose();
+            linqDetector -> detectPose();
+        }
+    }
+}
+
+
+/**
+ *  Advances the game in fixed ticks up to a time.
+ *
+ *  Every tick advances the game and moves the projectiles
+ *  with the last sensor frame, the renderer only draws them.
+ *  @param time current time in microseconds, the wall clock or
+ *  the timestamp of the last frame.
+ */
+void GameSimulation :: advanceTo (XnUInt64 time)
+{
+    clock.advanceTo(time);
+
+    while (clock.tick()) {
+        ProfileZone zone(PROFILE_NEXT_FRAME);
+
+        game -> nextFrame();
+        projectiles -> advance();
+    }
+}
+
+
+/**
+ *  Returns how far the game is between the last tick and the
+ *  next one, to interpolate the drawing.
+ *  @param elapsed time in microseconds after the last advance,
+ *  the ticks follow the frames but the drawing goes on between
+ *  them.
+ *  @return part of a tick, between 0 and 1.
+ */
+float GameSimulation :: retAlpha (XnUInt64 elapsed)
+{
+    return clock.retAlpha(elapsed);
+}
+
+
+/**
+ *  Returns the user detector.
+ *  @return pointer to the user detector.
+ */
+UserDetector* GameSimulation :: retUserDetector ()
+{
+    return userDetector;
+}
+
+
+/**
+ *  Returns the Zamus detector.
+ *  @return pointer to the Zamus detector.
+ */
+Zamus* GameSimulation :: retZamusDetector ()
+{
+    return zamusDetector;
+}
+
+
+/**
+ *  Returns the Linq detector.
+ *  @return pointer to the Linq detector.
+ */
+Linq* GameSimulation :: retLinqDetector ()
+{
+    return linqDetector;
+}
+
+
+/**
+ *  Returns the projectiles of the game.
+ *  @return pointer to the projectiles.
+ */
+ProjectileSystem* GameSimulation :: retProjectiles ()
+{
+    return projectiles;
+}
+
+
+/**
+ *  Returns the game.
+ *  @return pointer to the game.
+ */
+SuperFiremanBrothers* GameSimulation :: retGame ()
+{
+    return game;
+}
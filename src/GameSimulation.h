@@ -0,0 +1,183 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file GameSimulation.h
+ *
+ *  @brief Header file for the class GameSimulation.
+ *
+ *  This file contains the definition of the game logic of Super
+ *  Fireman Brothers without any window or sensor.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef GAME_SIMULATION_H
+# define GAME_SIMULATION_H
+
+# include "common.h"
+# include "config.h"
+# include "SensorFrame.h"
+# include "UserDetector.h"
+# include "BusterDetector.h"
+# include "IceRodDetector.h"
+# include "Zamus.h"
+# include "Linq.h"
+# include "ProjectileSystem.h"
+# include "SimulationClock.h"
+# include "SuperFiremanBrothers.h"
+
+/**
+ *  @class GameSimulation
+ *
+ *  @brief This class runs the game logic one sensor frame at a time.
+ *
+ *  It owns the pose detectors and the game, and advances all of them
+ *  with every frame it is given. The frames may come from the sensor
+ *  thread or from any SensorBackend, so the same logic runs in the
+ *  game and in the headless simulation.
+ *
+ *  @see SensorBackend
+ */
+class GameSimulation
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         *  @param ud pointer to the user detector fed with the frames.
+         *  @param maxPlayers number of players of the game.
+         *  @param seed seed of the random numbers of the game.
+         */
+        GameSimulation(UserDetector *ud, int maxPlayers, unsigned int seed);
+
+        /**
+         *  Class destructor.
+         */
+        ~GameSimulation();
+
+        /**
+         *  Reads a new sensor frame.
+         *
+         *  Checks the players and detects the poses, the game
+         *  advances in advanceTo().
+         *  @param frame new sensor frame.
+         */
+        void step(const SensorFrame *frame);
+
+        /**
+         *  Advances the game in fixed ticks up to a time.
+         *
+         *  Every tick advances the game and moves the projectiles
+         *  with the last sensor frame, the renderer only draws them.
+         *  @param time current time in microseconds, the wall clock
+         *  or the timestamp of the last frame.
+         */
+        void advanceTo(XnUInt64 time);
+
+        /**
+         *  Returns how far the game is between the last tick and the
+         *  next one, to interpolate the drawing.
+         *  @param elapsed time in microseconds after the last advance,
+         *  the ticks follow the frames but the drawing goes on between
+         *  them.
+         *  @return part of a tick, between 0 and 1.
+         */
+        float retAlpha(XnUInt64 elapsed = 0);
+
+        /**
+         *  Returns the user detector.
+         *  @return pointer to the user detector.
+         */
+        UserDetector* retUserDetector();
+
+        /**
+         *  Returns the Zamus detector.
+         *  @return pointer to the Zamus detector.
+         */
+        Zamus* retZamusDetector();
+
+        /**
+         *  Returns the Linq detector.
+         *  @return pointer to the Linq detector.
+         */
+        Linq* retLinqDetector();
+
+        /**
+         *  Returns the projectiles of the game.
+         *  @return pointer to the projectiles.
+         */
+        ProjectileSystem* retProjectiles();
+
+        /**
+         *  Returns the game.
+         *  @return pointer to the game.
+         */
+        SuperFiremanBrothers* retGame();
+
+    private:
+
+        /**
+         *  Pointer to the user detector.
+         */
+        UserDetector *userDetector;
+
+        /**
+         *  Zamus and Linq transformation detectors.
+         */
+        Zamus *zamusDetector;
+        Linq *linqDetector;
+
+        /**
+         *  Shoots of Zamus and ices of Linq.
+         */
+        ProjectileSystem *projectiles;
+
+        /**
+         *  Fixed timestep of the game.
+         */
+        SimulationClock clock;
+
+        /**
+         *  Buster and Ice Rod detectors.
+         */
+        BusterDetector *busterDetector;
+        IceRodDetector *iceRodDetector;
+
+        /**
+         *  The game.
+         */
+        SuperFiremanBrothers *game;
+
+        /**
+         *  Copy constructor and assignment are not allowed, the
+         *  simulation owns the detectors.
+         */
+        GameSimulation(const GameSimulation&);
+        GameSimulation& operator=(const GameSimulation&);
+};
+
+# endif
@@ -24,16 +24,60 @@
 
 # include "IceRodDetector.h"
 
+/**
+ *  Returns the timing of the Ice Rod, it is charged bending the
+ *  arm and every use is a burst of ices.
+ */
+static ActionPattern iceRodPattern()
+{
+    ActionPattern pattern;
+
+    pattern.cooldown      = L_ICE_COOLDOWN;
+    pattern.needsCharge   = true;
+    pattern.charge        = L_ICE_CHARGE;
+    pattern.chargeWindow  = L_ICE_CHARGE_WINDOW;
+    pattern.burst         = L_ICE_BURST;
+    pattern.burstInterval = L_ICE_BURST_INTERVAL;
+
+    return pattern;
+}
+
 /**
  *  Constructor of the class.
  *  @param linq pointer to a linq struture.
  *  @param userD pointer to a user detector structure.
  */
 IceRodDetector :: IceRodDetector (Linq *linq, UserDetector *userD) : 
-    AbstractPoseDetection (userD)
+    AbstractPoseDetection (userD),
+    ices (userD -> retUserTable(), iceRodPattern())
 {
     lDetector = linq;
-    setRequiredPoseTime(L_ICEROD_POSE_TIME);
+
+    straightPose = g_PoseLibrary.findPose("icerod_straight");
+    bentPose     = g_PoseLibrary.findPose("icerod_bent");
+    setHoldPose(straightPose);
+}
+
+/** 
+ *  Detects the Ice Rod pose of the users and fires the
+ *  ices of the bursts whose time has come.
+ */
+void IceRodDetector :: detectPose()
+{
+    ActionTimer timer;
+    const SensorFrame *frame;
+
+    AbstractPoseDetection :: detectPose();
+
+    frame = userDetector -> retFrame();
+
+    if (frame == NULL) {
+        return;
+    }
+
+    while (ices.popDue(frame -> timestamp, timer)) {
+        invokeIce(timer.userID, timer.shoot);
+    }
 }
 
 /** 
@@ -46,23 +90,51 @@ IceRodDetector :: IceRodDetector (Linq *linq, UserDetector *userD) :
  */
 bool IceRodDetector :: isPosing(XnUserID userID, double poseTime) 
 {
+    int slot;
+    XnUInt64 now;
+    UserTable *userTable;
+
+    userTable = userDetector -> retUserTable();
+    slot      = userTable -> findSlot(userID);
+
+    if (slot == -1) {
+        return false;
+    }
+
     detectIceRodPose(userID, poseTime);
 
-    if (lDetector -> retIceRodStatus(userID) == Linq :: DEACTIVATED) {
-        lDetector -> changeIceRodCharge(userID, true);
+    // The bent arm charges the Ice Rod and the straight arm
+    // releases the charge
+    now = userDetector -> retFrame() -> timestamp;
+
+    if (userTable -> iceRodStatus[slot] == Linq :: DEACTIVATED) {
+        ices.charge(slot, now);
     }
-    
-    if (lDetector -> retIceCharge(userID)) {
-        if (lDetector -> retIceRodStatus(userID) == Linq :: ACTIVATED) {
-            lDetector -> changeIceRodCharge(userID, false);
-            return true;
-        } 
+    else if (userTable -> iceRodStatus[slot] == Linq :: ACTIVATED) {
+        return ices.release(slot, now);
     }
 
     return false;
 }
 
 
+/** 
+ *  Indicates if an user can use the Ice Rod, only the
+ *  transformed Linq users can.
+ *  @param table table of the users.
+ *  @param slot slot of the user in the table.
+ *  @return true if the user is a Linq with the Ice Rod
+ *  activated or deactivated.
+ */
+bool IceRodDetector :: canPose(const UserTable *table, int slot) 
+{
+    return (table -> listener[slot] == LINQ_TYPE) &&
+           (table -> listenedStage[slot] == Linq :: TRANSFORMED) &&
+           ((table -> iceRodStatus[slot] == Linq :: ACTIVATED) ||
+            (table -> iceRodStatus[slot] == Linq :: DEACTIVATED));
+}
+
+
 /** 
  *  Specifies the actions that should be taken 
  *  when the Ice Rod pose is detected.
@@ -75,34 +147,27 @@ void IceRodDetector ::  poseDetected(XnUserID userID)
 
 
 /** 
- *  Method that is called when the Ice Rod pose is 
- *  detected.
+ *  Method that is called for every ice of the bursts of
+ *  the Ice Rod.
  *  @param userID user ID of the user who is appliying
  *  the Ice Rod pose.
+ *  @param shoot index of the ice in the burst, the first
+ *  one goes where the arm points and the others to the
+ *  sides.
  */
-void IceRodDetector :: invokeIce(XnUserID userID)
+void IceRodDetector :: invokeIce(XnUserID userID, int shoot)
 {
-    static int iceSpawnDelay = 0;
-
-    //printf("ice %d\n", iceSpawnDelay++);
-
-    UserGenerator userGen;
-    DepthGenerator depthGen;
     XnSkeletonJointPosition elbow;
     XnSkeletonJointPosition hand;
     XnPoint3D points[2];
     Vector3D dir;
-    Vector3D dir2;
-
-    userGen  = userDetector -> retUserGenerator();
-    depthGen = userDetector -> retDepthGenerator();
 
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
+    userDetector -> getProjectivePosition(
         userID, 
         XN_SKEL_LEFT_ELBOW, 
         elbow
     );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
+    userDetector -> getProjectivePosition(
         userID, 
         XN_SKEL_LEFT_HAND, 
         hand
@@ -111,95 +176,35 @@ void IceRodDetector :: invokeIce(XnUserID userID)
     points[0] = elbow.position;
     points[1] = hand.position;
 
-    depthGen.ConvertRealWorldToProjective(2, points, points);
-
     dir.x = points[1].X - points[0].X;
     dir.y = points[1].Y - points[0].Y;
     dir.z = points[1].Z - points[0].Z;
 
+    // The odd ices go to the right and the even ones to the left
+    if (shoot > 0) {
+        dir.y += 8.0;
+        dir.x += ((shoot % 2 == 1) ? 8.0 : -8.0) * ((shoot + 1) / 2);
+    }
+
     lDetector -> addIceSpawn(points[1], dir, userID);
-    dir2 = dir;
-    dir2.y += 8.0;
-    dir2.x += 8.0;
-    lDetector -> addIceSpawn(points[1], dir2, userID);
-    dir2.x -= 16.0;
-    lDetector -> addIceSpawn(points[1], dir2, userID);
 }
 
 
 /** 
  *  Function that detects if the Ice Rod pose is being applied,
- *  it determines when the linq user should invoke magic ice.
+ *  it determines when the linq user should invoke magic ice. It
+ *  is checked for the transformed Linq users.
  *  @param userID id of the user applying the pose.
  *  @param poseTime pose time of the Ice Rod pose.
  */
 bool IceRodDetector :: detectIceRodPose(XnUserID userID, double poseTime) 
 {
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
     bool isStraight;
     bool isNotStraight;
 
-    int index;
-    
-    if (!((lDetector -> isListened(userID)) && 
-       (lDetector -> retLisUserStage(userID) == Linq :: TRANSFORMED))) {
-        return false;
-    }
-
-
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE))
-        {
-            return false;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    vrse.normalize();
-    vreh.normalize();
-    
     // For right arm 
-    isStraight = toAngle(acos(vrse.dot(vreh))) <= 30;
-
-    isNotStraight = toAngle(acos(vrse.dot(vreh))) >= 90;
-
+    isStraight    = isInPose(userID, straightPose);
+    isNotStraight = isInPose(userID, bentPose);
 
     if (isNotStraight) {
         lDetector -> changeIceRodStatus(userID, Linq :: DEACTIVATED);
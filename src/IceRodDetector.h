@@ -41,6 +41,7 @@
 
 # include "common.h"
 # include "Linq.h"
+# include "ActionScheduler.h"
 
 /**
  *  @class IceRodDetector
@@ -74,6 +75,12 @@ class IceRodDetector : public AbstractPoseDetection
          */
         ~IceRodDetector() {}
 
+        /** 
+         *  Detects the Ice Rod pose of the users and fires the
+         *  ices of the bursts whose time has come.
+         */
+        virtual void detectPose();
+
         /** 
          *  Implementation of the isPosing function wich returns 
          *  if the user is doing the Ice Rod pose.
@@ -84,6 +91,16 @@ class IceRodDetector : public AbstractPoseDetection
          */
         virtual bool isPosing(XnUserID userID, double poseTime = 0.0);
 
+        /** 
+         *  Indicates if an user can use the Ice Rod, only the
+         *  transformed Linq users can.
+         *  @param table table of the users.
+         *  @param slot slot of the user in the table.
+         *  @return true if the user is a Linq with the Ice Rod
+         *  activated or deactivated.
+         */
+        virtual bool canPose(const UserTable *table, int slot);
+
         /** 
          *  Specifies the actions that should be taken 
          *  when the Ice Rod pose is detected.
@@ -92,12 +109,15 @@ class IceRodDetector : public AbstractPoseDetection
         virtual void poseDetected(XnUserID userID);
 
         /** 
-         *  Method that is called when the Ice Rod pose is 
-         *  detected.
+         *  Method that is called for every ice of the bursts of
+         *  the Ice Rod.
          *  @param userID user ID of the user who is appliying
          *  the Ice Rod pose.
+         *  @param shoot index of the ice in the burst, the first
+         *  one goes where the arm points and the others to the
+         *  sides.
          */
-        void invokeIce(XnUserID userID);
+        void invokeIce(XnUserID userID, int shoot = 0);
 
 
     private:
@@ -109,9 +129,21 @@ class IceRodDetector : public AbstractPoseDetection
 
         Linq *lDetector;
 
+        /** 
+         *  Charges and bursts of the ices of the users.
+         */
+        ActionScheduler ices;
+
+        /** 
+         *  Poses of the library for the arm straight and bent.
+         */
+        int straightPose;
+        int bentPose;
+
         /** 
          *  Function that detects if the Ice Rod pose is being applied,
-         *  it determines when the linq user should invoke magic ice.
+         *  it determines when the linq user should invoke magic ice. It
+         *  is checked for the transformed Linq users.
          *  @param userID id of the user applying the pose.
          *  @param poseTime pose time of the Ice Rod pose.
          */
@@ -39,22 +39,26 @@
  *
  *  @param userDetector is a pointer to the userDetector of the
  *  game.
+ *  @param projectiles is a pointer to the projectiles of the
+ *  game.
  */
-Linq :: Linq(UserDetector *userDetector) : 
+Linq :: Linq(UserDetector *userDetector, ProjectileSystem *projectiles) : 
         AbstractPoseDetection(userDetector)
 {
     listenerType = LINQ_TYPE;
     userDetector -> addListener(this);                   
-    setRequiredPoseTime(L_POSE_TIME);
-    map <XnUserID, int> iceRodStatus = map <XnUserID, int> ();
-    iceSpawn = vector <LinqSpawnIce> ();
-    charge = map <XnUserID, bool> ();
+    stage1Pose = g_PoseLibrary.findPose("linq_stage1");
+    stage2Pose = g_PoseLibrary.findPose("linq_stage2");
+    stage3Pose = g_PoseLibrary.findPose("linq_stage3");
+    setHoldPose(stage3Pose);
+    userTable = userDetector -> retUserTable();
+    this -> projectiles = projectiles;
 }
 
 /**
  *  Add shoot function.
  *
- *  This function adds a new ice to the vector iceSpawn.
+ *  This function adds a new ice to the projectiles.
  *
  *  @param position is the initial position of the ice
  *  @param direction is the vector that represents the direction
@@ -63,7 +67,7 @@ Linq :: Linq(UserDetector *userDetector) :
  */
 void Linq :: addIceSpawn (XnPoint3D position, Vector3D direction, XnUserID p)
 {
-    iceSpawn.push_back(LinqSpawnIce(position, direction, p));
+    projectiles -> add(LINQ_ICE, position, direction, p);
 }
 
 /**
@@ -74,75 +78,9 @@ void Linq :: addIceSpawn (XnPoint3D position, Vector3D direction, XnUserID p)
  */
 void Linq :: stage1 (XnUserID userID, int stage) 
 { 
-    //printf("Entre al isposing de linq\n");
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
-    bool isStraightRight;
-    bool isSideRight;
-    bool isHigh;
-
-    const float yAdjustement = 150.0;
-    
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE))
-        {
-            return ;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    vrse.normalize();
-    vreh.normalize();
-
-    // For Right Arm
-    isStraightRight = toAngle(acos(vrse.dot(vreh))) <= STRAIGHT_RANGE;
-    
-    // Right arm in next of body
-    isSideRight =  (toAngle(acos(vrse.dot(g_Vmx))) <= 30);
-
-    // Hand High enough
-    isHigh = (vrh.y >= (vrs.y - yAdjustement)) && 
-             (vrh.y <= (vrs.y + yAdjustement));
-
-    // Transformation course
+    // Right arm straight to the side, with the hand high enough
     if (stage == NO_LISTENED) {
-        if (isStraightRight && isSideRight && isHigh) {
+        if (isInPose(userID, stage1Pose)) {
             userDetector -> changeStage(userID, T_STAGE_1);
             printf("Stage 1 Done...\n");
         }
@@ -158,75 +96,9 @@ void Linq :: stage1 (XnUserID userID, int stage)
  */
 void Linq :: stage2 (XnUserID userID, int stage) 
 {
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition ls, le, lh;
-
-    Vector3D vls, vle, vlh;
-    Vector3D vlse, vleh;
-    
-    bool isStraightLeft;
-    bool isSideLeft;
-    bool isHigh;
-
-    const float yAdjustement = 150.0;
-
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_SHOULDER, 
-        ls
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_ELBOW, 
-        le
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_HAND, 
-        lh
-    );
-
-    // Confidence test
-    if( (ls.fConfidence < CONFIDENCE) || 
-        (le.fConfidence < CONFIDENCE) ||
-        (lh.fConfidence < CONFIDENCE))
-        {
-            return;
-        }
-    
-
-    vls = Vector3D((ls.position).X, (ls.position).Y, (ls.position).Z);
-    vle = Vector3D((le.position).X, (le.position).Y, (le.position).Z);
-    vlh = Vector3D((lh.position).X, (lh.position).Y, (lh.position).Z);
-
-    // Left Shoulder to elbow
-    vlse = vle - vls;
-    
-    // Left Elbow to hand
-    vleh = vlh - vle;
-
-    vlse.normalize();
-    vleh.normalize();
-
-    // For left Arm
-    isStraightLeft = toAngle(acos(vlse.dot(vleh))) <= STRAIGHT_RANGE;
-    
-    // Right arm in front of body
-    isSideLeft = toAngle(acos(vlse.dot(g_Vx))) <= 30;
-
-    // Hand high enough
-    isHigh = (vlh.y >= (vls.y - yAdjustement)) && 
-             (vlh.y <= (vls.y + yAdjustement));
-
-
-    // Transformation course
+    // Left arm straight to the side, with the hand high enough
     if (stage == T_STAGE_1) {
-        if (isStraightLeft && isSideLeft && isHigh) {
+        if (isInPose(userID, stage2Pose)) {
             userDetector -> changeStage(userID, T_STAGE_2);
             printf("Stage 2 Done...\n");
         }
@@ -241,132 +113,9 @@ void Linq :: stage2 (XnUserID userID, int stage)
  */
 void Linq :: stage3 (XnUserID userID, int stage) 
 {
-    //printf("Entre al isposing de linq\n");
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh, ls, le, lh, head;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
-    Vector3D vls, vle, vlh;
-    Vector3D vlse, vleh, vhead;
-
-    Vector3D vtemp;
-
-    int percent;
-    
-    const float yAdjustement = 150.0;
-
-    bool isDiagElbowLeft;
-    bool isDiagElbowRight;
-    bool isDiagonalLeft;
-    bool isDiagonalRight;
-    bool isHigh;
-
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_SHOULDER, 
-        ls
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_ELBOW, 
-        le
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_HAND, 
-        lh
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_HEAD, 
-        head
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE) ||
-        (ls.fConfidence < CONFIDENCE) ||
-        (le.fConfidence < CONFIDENCE) ||
-        (lh.fConfidence < CONFIDENCE) ||
-        (head.fConfidence < CONFIDENCE)) 
-        {
-            return;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-    vls = Vector3D((ls.position).X, (ls.position).Y, (ls.position).Z);
-    vle = Vector3D((le.position).X, (le.position).Y, (le.position).Z);
-    vlh = Vector3D((lh.position).X, (lh.position).Y, (lh.position).Z);
-    vhead = Vector3D((head.position).X, 
-                     (head.position).Y, 
-                     (head.position).Z);
-
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    // Left Shoulder to Elbow
-    vlse = vle - vls;
-    
-    // Left Elbow to hand
-    vleh = vlh - vle;
-
-    // Temporary vector
-    
-    vrse.normalize();
-    vreh.normalize();
-    vlse.normalize();
-    vleh.normalize();
-
-    // Left diagonal limbs
-    vtemp = g_Vx + g_Vy;
-    vtemp.normalize();
-    
-    isDiagonalLeft = toAngle(acos(vlse.dot(vtemp))) <= 30;
-    isDiagElbowRight = toAngle(acos(vreh.dot(vtemp))) <= 30;
-    
-    // Right arm in front of body
-    vtemp = g_Vmx + g_Vy;
-    vtemp.normalize();
-
-    isDiagonalRight = toAngle(acos(vrse.dot(vtemp))) <= 30; 
-    isDiagElbowLeft = toAngle(acos(vleh.dot(vtemp))) <= 30;
-
-    isHigh = (vrh.y >= vhead.y) && (vlh.y >= vhead.y);
-  
-    // Transformation course
+    // Arms bent in diagonal over the head
     if (stage == T_STAGE_2) {
-        if (isDiagonalLeft && isDiagonalRight && isDiagElbowLeft &&
-            isDiagElbowRight && isHigh){
+        if (isInPose(userID, stage3Pose)) {
             userDetector -> changeStage(userID, TRANSFORMED);
             printf("Stage 3 Done...\n");
         }
@@ -418,6 +167,23 @@ bool Linq :: isPosing(XnUserID userID, double poseTime)
     return false;
 }
 
+/**
+ *  Indicates if an user can do the pose in his current role
+ *  and stage.
+ *
+ *  @param table is the table of the users.
+ *  @param slot is the slot of the user in the table.
+ *
+ *  @return True if the user is tracked and not transforming in
+ *  Zamus.
+ */
+bool Linq :: canPose(const UserTable *table, int slot)
+{
+    return table -> tracked[slot] && 
+           ((table -> stage[slot] == NO_LISTENED) || 
+            (table -> stage[slot] >= T_STAGE_1));
+}
+
 /**
  *  Function to be applied when the pose is detected.
  *  
@@ -425,9 +191,14 @@ bool Linq :: isPosing(XnUserID userID, double poseTime)
  */
 void Linq :: poseDetected(XnUserID userID)
 {
-    usersListened.insert(pair <XnUserID, int> (userID, TRANSFORMED));
-    iceRodStatus.insert(pair <XnUserID, int> (userID, DEACTIVATED));
-    charge.insert(pair <XnUserID, int> (userID, false));
+    int slot;
+
+    addListened(userID, TRANSFORMED);
+
+    slot = userTable -> findSlot(userID);
+    if (slot != -1) {
+        userTable -> iceRodStatus[slot] = DEACTIVATED;
+    }
 
     userDetector -> remTrackedUser(userID);
 
@@ -446,8 +217,12 @@ void Linq :: poseDetected(XnUserID userID)
  */
 int Linq :: retIceRodStatus(XnUserID userID) 
 {
-    if (iceRodStatus.count(userID) == 1) {
-        return iceRodStatus[userID];
+    int slot;
+
+    slot = userTable -> findSlot(userID);
+
+    if (slot != -1) {
+        return userTable -> iceRodStatus[slot];
     }
 
     return -1;
@@ -461,40 +236,12 @@ int Linq :: retIceRodStatus(XnUserID userID)
  */
 void Linq :: changeIceRodStatus(XnUserID userID, int status)
 {
-    iceRodStatus[userID] = status;
-}
-
-/**
- *  Returns ice rod charge status.
- *
- *  @param userID is the player's id.
- *
- *  @return True if the player can shoot. False in other case.
- */
-bool Linq :: retIceCharge(XnUserID userID) 
-{
-    if (charge.count(userID) == 1) {
-        return charge[userID];
-    }
+    int slot;
 
-    return -1;
-}
+    slot = userTable -> findSlot(userID);
 
-/**
- *  Changes ice rod charge Status.
- *
- *  This is needed to sequence the poses to spawn ice.
- *
- *  @param userID is the player's id.
- *  @param satus is the value to set the charge map.
- */
-void Linq :: changeIceRodCharge(XnUserID userID, bool status)
-{
-    if (charge.count(userID) != 1) {
-        charge.insert(pair <XnUserID, bool> (userID, status));
-    }
-    else {
-        charge[userID] = status;
+    if (slot != -1) {
+        userTable -> iceRodStatus[slot] = status;
     }
 }
 
@@ -541,14 +288,15 @@ void Linq :: newUser(XnUserID userID) {
  */
 void Linq :: lostUser(XnUserID userID) {
      
+    int slot;
+
     // Remove user from listener
-    if (isListened(userID)) {
-        usersListened.erase(userID);
-    }
+    remListened(userID);
     
     // Remove user from listener
-    if (iceRodStatus.count(userID) == 1) {
-        iceRodStatus.erase(userID);
+    slot = userTable -> findSlot(userID);
+    if (slot != -1) {
+        userTable -> iceRodStatus[slot] = -1;
     }
 
     printf("Lost Linq user %d\n", userID);
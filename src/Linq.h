@@ -41,7 +41,7 @@
 # include "AbstractPoseDetection.h"
 # include "UserListener.h"
 # include "UserDetector.h"
-# include "LinqSpawnIce.h"
+# include "ProjectileSystem.h"
 
 /**
  *  @class Linq
@@ -64,8 +64,10 @@ class Linq : public AbstractPoseDetection, UserListener
          *
          *  @param userDetector is a pointer to the userDetector of the
          *  game.
+         *  @param projectiles is a pointer to the projectiles of the
+         *  game.
          */
-        Linq(UserDetector *userDetector);
+        Linq(UserDetector *userDetector, ProjectileSystem *projectiles);
         
         /**
          *  Linq destructor 
@@ -97,14 +99,14 @@ class Linq : public AbstractPoseDetection, UserListener
         };
         
         /**
-         * Vector of linq ice spawns 
+         * Projectiles of the game, where the ices are added.
          */
-        vector <LinqSpawnIce> iceSpawn;
+        ProjectileSystem *projectiles;
 
         /**
          * Add shoot function.
          *
-         * This function adds a new ice to the vector iceSpawn.
+         * This function adds a new ice to the projectiles.
          *
          * @param position is the initial position of the ice
          * @param direction is the vector that represents the direction
@@ -112,6 +114,7 @@ class Linq : public AbstractPoseDetection, UserListener
          * @oaram p is the player's id.
          */
         void addIceSpawn (XnPoint3D position, Vector3D direction, XnUserID p);
+
        
         /**
          *  Returns buster status.
@@ -132,25 +135,6 @@ class Linq : public AbstractPoseDetection, UserListener
          */
         void changeIceRodStatus(XnUserID userID, int status);
         
-        /**
-         *  Returns ice rod charge status.
-         *
-         *  @param userID is the player's id.
-         *
-         *  @return True if the player can shoot. False in other case.
-         */
-        bool retIceCharge(XnUserID userID);
-
-        /**
-         *  Changes ice rod charge Status.
-         *
-         *  This is needed to sequence the poses to spawn ice.
-         *
-         *  @param userID is the player's id.
-         *  @param satus is the value to set the charge map.
-         */
-        void changeIceRodCharge(XnUserID userID, bool status);
-        
         /**
          *  Return listener user stage 
          *
@@ -172,14 +156,11 @@ class Linq : public AbstractPoseDetection, UserListener
      private:
 
         /**
-         *  Ice rod status
-         */
-        map <XnUserID, int> iceRodStatus; 
-        
-        /**
-         *  Map of icerod secuence activaton
+         *  Poses of the library for the stages of the transformation.
          */
-        map <XnUserID, bool> charge;
+        int stage1Pose;
+        int stage2Pose;
+        int stage3Pose;
 
         /**
          *  Pose for stage1 transformation. 
@@ -219,6 +200,18 @@ class Linq : public AbstractPoseDetection, UserListener
          */
         virtual bool isPosing(XnUserID userID, double poseTime = 0.0);
 
+        /**
+         *  Indicates if an user can do the pose in his current role
+         *  and stage.
+         *
+         *  @param table is the table of the users.
+         *  @param slot is the slot of the user in the table.
+         *
+         *  @return True if the user is tracked and not transforming in
+         *  Zamus.
+         */
+        virtual bool canPose(const UserTable *table, int slot);
+
         /**
          *  Function to be applied when the pose is detected.
          *  
@@ -0,0 +1,69 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ModelCache.cpp
+ *
+ *  @brief Implementation of the display lists of the models.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "ModelCache.h"
+
+/**
+ *  Display lists of the models compiled so far. The models are loaded
+ *  once and never freed, so their pointers are the keys.
+ */
+static map<GLMmodel*, GLuint> compiledModels;
+
+/**
+ *  Returns the display list of a model, it is compiled the first time
+ *  with smooth normals and the materials of the model. It needs the
+ *  OpenGL context, so it is called when drawing.
+ *  @param model model to be drawn.
+ *  @return display list of the model, 0 if the model is NULL.
+ */
+GLuint modelList(GLMmodel *model)
+{
+    map<GLMmodel*, GLuint>::iterator it;
+    GLuint list;
+
+    if (model == NULL) {
+        return 0;
+    }
+
+    it = compiledModels.find(model);
+
+    if (it != compiledModels.end()) {
+        return it -> second;
+    }
+
+    list = glmList(model, GLM_SMOOTH | GLM_MATERIAL);
+    compiledModels[model] = list;
+
+    return list;
+}
@@ -22,49 +22,33 @@
  *
  */
 
+
 /**
- *  @file TimeCounter.cpp
- *                                                                      
- *  @brief implementation file for the class TimeCounter.
+ *  @file ModelCache.h
+ *
+ *  @brief Header file of the display lists of the models.
  *
- *  This file contains the implementation of the functions and methods
- *  of the class TimeCounter.
+ *  This file contains the function that compiles the GLM models into
+ *  OpenGL display lists, so the triangles of a model are sent to the
+ *  driver once and every draw of the model is one call.
  *
- *  @authors Alfonso Ros e Ismael Mendonça.
+ *  @authors Alfonso Ros e Ismael Mendonça
  *
  */
 
-# include "TimeCounter.h"
-
-/**
- *  Class constructor
- */
-TimeCounter :: TimeCounter() 
-{
-    lastTime = 0.0f;
-}
+# ifndef MODEL_CACHE_H
+# define MODEL_CACHE_H
 
+# include "common.h"
+# include "../glm/include/glm.h"
 
 /**
- *  Take the time and returns the difference between 
- *  the current time and the last time taken.
- *  @return difference between current time and las time.
+ *  Returns the display list of a model, it is compiled the first time
+ *  with smooth normals and the materials of the model. It needs the
+ *  OpenGL context, so it is called when drawing.
+ *  @param model model to be drawn.
+ *  @return display list of the model, 0 if the model is NULL.
  */
-double TimeCounter :: takeTime() 
-{
- 
-    double time;
-    double difference;
-
-    time = 0.0f;
- 
-    if(!gettimeofday(&t_p, NULL)) {
-        time = (double)t_p.tv_sec + ((double)t_p.tv_usec) / 1000000.0f;
-    } 
-    
-    difference = (lastTime == 0.0f) ?  0.0f : time - lastTime;
-
-    lastTime = time;
+GLuint modelList(GLMmodel *model);
 
-    return difference;
-}
+# endif
@@ -37,8 +37,7 @@
 
 # include "Vector3D.h"
 # include "UserDetector.h"
-# include "ZamusModel.h"
-# include "LinqModel.h"
+# include "CharacterRig.h"
 
 /**
  *  @class NeutralModel
@@ -67,32 +66,7 @@ class NeutralModel
         /**
          *  Constructor.
          */
-        NeutralModel(UserDetector *userDetector,
-                     ZamusModel&  zamusModel,
-                     LinqModel&   linqModel);
-
-        /**
-         *  Joints enum.
-         *
-         *  This enumerate the joints that this class will use.
-         */
-        enum joints{
-            HEAD = 0,
-            NECK,
-            RSHOULDER,
-            RELBOW,
-            RHAND,
-            LSHOULDER,
-            LELBOW,
-            LHAND,
-            TORSO,
-            RHIP,
-            RKNEE,
-            RFOOT,
-            LHIP,
-            LKNEE,
-            LFOOT
-        };
+        NeutralModel(UserDetector *userDetector);
 
         /**
          *  DrawNeutral function.
@@ -102,9 +76,11 @@ class NeutralModel
          *  player is not tracked.
          *
          *  @param player is the ID of the player.
+         *  @param rigRenderer renderer where the stick figure is added,
+         *  it is drawn with the characters of the other players.
          *
          */
-        void drawNeutral (XnUserID player);
+        void drawNeutral (XnUserID player, RigRenderer &rigRenderer);
 
     private:
 
@@ -112,77 +88,6 @@ class NeutralModel
          *  User Generator pointer.
          */
         UserDetector *nm_UserDetector;
-
-        /**
-         *  Depth Generator pointer.
-         */
-        DepthGenerator nm_DepthGenerator;
-
-        /**
-         *  Zamus Model.
-         */
-        ZamusModel zamusModelParts;
-
-        /**
-         *  Linq Model.
-         */
-        LinqModel linqModelParts;
-
-        /**
-         *  Joint position array.
-         */
-        XnPoint3D joint[15];
-
-        /**
-         *  Load actual joint positions.
-         *
-         *  Load the position of the joints in the joint array.
-         *
-         *  @param player is the player ID who needs to load the joints
-         *  from.
-         *  @param skelCap is the skeletonCapability taken from the User
-         *  Generator.
-         */
-        void loadJoints (XnUserID player, SkeletonCapability skelCap);
-
-        /**
-         *  Orient the modeling matrix between two points.
-         *
-         *  Modify the modeling matrix to be centared in one point and
-         *  with the Y axis looking to the second point.
-         *
-         *  @param point1 is where the matrix will be centered.
-         *  @param point2 is where the Y axis will be.
-         */
-        void orientMatrix (XnPoint3D& point1, XnPoint3D& point2);
-
-        /**
-         *  Draw a stick between two points.
-         *
-         *  This function draws a cylincer and a sphere on its top
-         *  between two points.
-         *
-         *  @param point1 is the first point.
-         *  @param point2 is the second point where is going to be the
-         *  sphere.
-         */
-        void drawLimp (XnPoint3D& point1, XnPoint3D& point2);
-
-        /**
-         *  Draw Torso.
-         *
-         *  This function draws a box that represents the torso of the
-         *  player.
-         */
-        void drawTorso ();
-
-        /**
-         *  Draw head.
-         *
-         *  This function draws a sphere in the head joint of the
-         *  player.
-         */
-        void drawHead ();
 };
 
 # endif
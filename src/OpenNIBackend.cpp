@@ -0,0 +1,531 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file OpenNIBackend.cpp
+ *
+ *  @brief Implementation file for the class OpenNIBackend.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class OpenNIBackend, the calibration of the new users and
+ *  the copy of the Kinect frames.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "OpenNIBackend.h"
+
+/**
+ *  Number of points converted to projective coordinates in every
+ *  frame: the joints, the centers of mass and the floor point.
+ */
+# define CONVERTED_POINTS (MAX_USERS * SNAPSHOT_JOINTS + MAX_USERS + 1)
+
+/**
+ *  Function used to cast void* to OpenNIBackend* object
+ *  @param object object to be cast.
+ */
+static OpenNIBackend* cast(void* object) 
+{
+    return static_cast<OpenNIBackend *>(object);
+}
+
+/**
+ *  Method that calls the equivalent new user callback function 
+ *  for the backend introduced.
+ *  @param gen reference to an user generator.
+ *  @param userID user ID of the current user.
+ *  @param backend current passed backend.
+ */
+static void XN_CALLBACK_TYPE c_NewUser(UserGenerator& gen, 
+                                       XnUserID userID, 
+                                       void *backend)
+{
+    cast(backend) -> newUser(userID);
+}
+
+
+/**
+ *  Method that calls the equivalent lost user callback function 
+ *  for the backend introduced.
+ *  @param gen reference to an user generator.
+ *  @param userID user ID of the current user.
+ *  @param backend current passed backend.
+ */
+static void XN_CALLBACK_TYPE c_LostUser(UserGenerator& gen, 
+                                        XnUserID userID, 
+                                        void *backend)
+{
+    // Lost users are handled by the UserDetector with the frames.
+}
+
+/**
+ *  Method that calls the equivalent start calibration callback function 
+ *  for the backend introduced.
+ *  @param skeleton reference to a skeleton capability type (OpenNI).
+ *  @param userID user ID of the current user.
+ *  @param backend current passed backend.
+ */
+static void XN_CALLBACK_TYPE c_StartCalibration(SkeletonCapability& skeleton, 
+                                                XnUserID userID, 
+                                                void *backend)
+{
+    cast(backend) -> startCalibration(userID);
+}
+
+/**
+ *  Method that calls the equivalent end calibration callback function 
+ *  for the backend introduced.
+ *  @param skeleton reference to a skeleton capability type (OpenNI).
+ *  @param userID user ID of the current user.
+ *  @param success boolean that indicates the calibration success.
+ *  @param backend current passed backend.
+ */
+static void XN_CALLBACK_TYPE c_EndCalibration(SkeletonCapability& skeleton, 
+                                              XnUserID userID, 
+                                              XnBool success,
+                                              void *backend)
+{
+    cast(backend) -> endCalibration(userID, success);
+}
+
+/**
+ *  Method that calls the equivalent pose detection callback function 
+ *  for the backend introduced.
+ *  @param pose reference to a pose capability type (OpenNI).
+ *  @param poseName array where the pose name will be stored.
+ *  @param userID user ID of the current user.
+ *  @param backend current passed backend.
+ */
+static void XN_CALLBACK_TYPE c_PoseDetected(PoseDetectionCapability &pose,
+                                            const XnChar *poseName, 
+                                            XnUserID userID,
+                                            void *backend)
+{
+    cast(backend) -> poseDetected(poseName, userID);
+}
+
+
+/**
+ *  Constructor of the class.
+ */
+OpenNIBackend :: OpenNIBackend()
+{
+    memset(strPose, '\0', sizeof(strPose));
+    userHandle = NULL;
+    userPoseHandle = NULL;
+    userSkelHandle = NULL;
+    needPose = false;
+    stopDetection = false;
+    hasImage = false;
+}
+
+
+/**
+ *  Creates the OpenNI context from a configuration file, finds
+ *  its nodes and registers the callbacks. The program exits if
+ *  the Kinect can not be used.
+ *  @param xmlFile path of the OpenNI configuration file.
+ */
+void OpenNIBackend :: init(const char *xmlFile)
+{
+    EnumerationErrors errors;
+    XnStatus status;
+
+    // Initializing context and checking for enumeration errors
+    status = context.InitFromXmlFile(xmlFile, &errors);
+    checkEnumError(status, errors);
+
+    // Finding nodes and checking for errors
+    STATUS_CHECK(context.FindExistingNode(XN_NODE_TYPE_DEPTH, depthGenerator), "Finding depth node");
+    STATUS_CHECK(context.FindExistingNode(XN_NODE_TYPE_SCENE, sceneAnalyzer), "Finding scene analizer");
+    STATUS_CHECK(context.FindExistingNode(XN_NODE_TYPE_USER, userGenerator), "Finding user node");
+
+    // The camera image is optional, the game is played without it
+    hasImage = 
+        context.FindExistingNode(XN_NODE_TYPE_IMAGE, imageGenerator) == XN_STATUS_OK &&
+        imageGenerator.GetPixelFormat() == XN_PIXEL_FORMAT_RGB24;
+
+    // The depth map, and so the label map, is seen from the camera
+    if (hasImage && 
+        depthGenerator.IsCapabilitySupported(XN_CAPABILITY_ALTERNATIVE_VIEW_POINT)) {
+        STATUS_CHECK(depthGenerator.GetAlternativeViewPointCap().SetViewPoint(imageGenerator), "Set view point");
+    }
+
+    // Checking user generator capabilities
+    if(!userGenerator.IsCapabilitySupported(XN_CAPABILITY_SKELETON)) {
+        reportError("Skeleton capability not supported\n");
+    }
+    
+    if(!userGenerator.IsCapabilitySupported(XN_CAPABILITY_POSE_DETECTION)) {
+        reportError("Pose detection capability not supported\n");
+    }
+
+    registerCallbacks();
+}
+
+
+/**
+ *  Starts the generation of all the nodes.
+ */
+void OpenNIBackend :: startGenerating()
+{
+    STATUS_CHECK(context.StartGeneratingAll(), "Context generation");
+}
+
+
+/**
+ *  Shuts down the OpenNI context.
+ */
+void OpenNIBackend :: shutdown()
+{
+    context.Shutdown();
+}
+
+
+/**
+ *  The Kinect is a live sensor.
+ *  @return true.
+ */
+bool OpenNIBackend :: isLive()
+{
+    return true;
+}
+
+
+/** 
+ *  Method that register the callbacks relative to user
+ *  interaction with the Kinect (new user, calibrate user, etc).
+ */
+void OpenNIBackend :: registerCallbacks() 
+{
+
+    // Register user handling functions
+    userGenerator.RegisterUserCallbacks(
+        c_NewUser, 
+        c_LostUser, 
+        this, 
+        userHandle
+    );
+    
+    // Skeleton handling callbacks
+    userGenerator.GetSkeletonCap().RegisterCalibrationCallbacks(
+        c_StartCalibration, 
+        c_EndCalibration, 
+        this, 
+        userSkelHandle
+    );
+
+    // If calibration pose needed
+    if (userGenerator.GetSkeletonCap().NeedPoseForCalibration()) {
+        needPose = true;
+
+        // Checking capability for pose
+        if (!userGenerator.IsCapabilitySupported(
+            XN_CAPABILITY_POSE_DETECTION)) 
+        {
+            printf("Pose required, but not supported\n");
+            exit(EXIT_FAILURE);
+        }
+        
+        // Getting pose 
+        userGenerator.GetSkeletonCap().GetCalibrationPose(strPose);
+
+        // Register pose callback
+        userGenerator.GetPoseDetectionCap().RegisterToPoseCallbacks(
+            c_PoseDetected, 
+            NULL, 
+            this,
+            userPoseHandle
+        );
+    }
+    else {
+        memset(strPose, '\0', sizeof(strPose));
+        userPoseHandle = NULL;
+    }
+
+    // Detect a skeleton with all joins
+    userGenerator.GetSkeletonCap().SetSkeletonProfile(XN_SKEL_PROFILE_ALL);
+    
+}
+
+
+/**
+ *  Indicates when to stop the calibration of new users.
+ *  @param value true to stop the detection.
+ */
+void OpenNIBackend :: changeStopDetection(bool value)
+{
+    stopDetection = value;
+}
+
+
+/**
+ *  Stops the generation of all the nodes.
+ */
+void OpenNIBackend :: stopGenerating()
+{
+    STATUS_CHECK(context.StopGeneratingAll(), "Context generation shutdown");
+}
+
+
+/**
+ *  Callback function called when new user appears, it starts
+ *  his calibration.
+ *  @param userID user ID of the new user.
+ */
+void OpenNIBackend :: newUser(XnUserID userID)
+{
+    // The game side of the new user is handled by the UserDetector,
+    // here we only start the calibration.
+    if (!stopDetection) {
+        initCalibration(userID);
+    }
+}
+
+
+/**
+ *  Starts the calibration of an user, with the calibration
+ *  pose if it is needed.
+ *  @param userID user ID of the user to be calibrated.
+ */
+void OpenNIBackend :: initCalibration(XnUserID userID) 
+{
+    // Check pose
+    if(needPose) {
+        printf("Start Pose Detection\n");
+        userGenerator.GetPoseDetectionCap().StartPoseDetection(
+            strPose,
+            userID
+        );
+    }
+    else {
+        userGenerator.GetSkeletonCap().RequestCalibration(userID, true);
+    }
+}
+
+
+/**
+ *  Callback function called when the calibration for a 
+ *  detected user begins.
+ *  @param userID user ID of the user to be calibrated.
+ */
+void OpenNIBackend :: startCalibration(XnUserID userID)
+{
+    printf("Calibration start user %d\n", userID);
+}
+
+
+/**
+ *  Callback function called when calibration of the 
+ *  user ends.
+ *  @param userID user ID of the user calibrated.
+ *  @param success indicates if the calibration succeded or not.
+ */
+void OpenNIBackend :: endCalibration(XnUserID userID, 
+                                     XnBool success)
+{
+    printf("Calibration for user %d %s\n", 
+        userID, success ? "Succeded" : "Failed");
+
+    // On calibration succeded, the user is added to the tracked
+    // users when the frame with his skeleton arrives.
+    if(success) {
+        userGenerator.GetSkeletonCap().StartTracking(userID);
+    }    
+    else {
+        initCalibration(userID);
+    }
+}
+
+
+/**
+ *  Callback function called when a new pose is detected.
+ *  @param poseName name of the pose detected.
+ *  @param userID user ID of the user that made the pose.
+ */
+void OpenNIBackend :: poseDetected(const XnChar *poseName, 
+                                   XnUserID userID)
+{
+    printf("Pose %s detected for user %d\n", poseName, userID);
+
+    // Stop pose detection
+    userGenerator.GetPoseDetectionCap().StopPoseDetection(userID);
+
+    // Request calibration
+    userGenerator.GetSkeletonCap().RequestCalibration(userID, true);
+}
+
+
+/**
+ *  Converts points from real world to projective coordinates
+ *  with the depth generator.
+ *  @param count number of points.
+ *  @param real points in real world coordinates.
+ *  @param projective where the projective points will be
+ *  stored, it can be the same array of real.
+ */
+void OpenNIBackend :: convertRealWorldToProjective(XnUInt32 count,
+                                                   const XnPoint3D *real,
+                                                   XnPoint3D *projective)
+{
+    depthGenerator.ConvertRealWorldToProjective(count, real, projective);
+}
+
+
+/**
+ *  Waits for the next update of the Kinect and copies it.
+ *
+ *  Every joint is read once from the skeleton capability and all the
+ *  points of the frame are converted to projective coordinates with
+ *  a single call.
+ *
+ *  @param frame where the frame will be stored.
+ *  @param labels true to copy the label map into the frame.
+ *  @param image true to copy the camera image into the frame.
+ *  @return always true.
+ */
+bool OpenNIBackend :: readFrame(SensorFrame& frame, bool labels, bool image)
+{
+    int i;
+    int j;
+    int n;
+
+    XnUserID usersIDs[MAX_USERS];
+    XnUInt16 numUsers;
+
+    XnPoint3D points[CONVERTED_POINTS];
+    XnSkeletonJointPosition jointPos;
+
+    SceneMetaData smd;
+    ImageMetaData imd;
+    SensorUser *user;
+    SnapshotJoint *skeleton;
+
+    // The OpenNI callbacks are called inside this update.
+    context.WaitOneUpdateAll(depthGenerator);
+
+    // The wait for the sensor is not part of the acquisition
+    ProfileZone zone(PROFILE_ACQUIRE);
+
+    numUsers = MAX_USERS;
+    userGenerator.GetUsers(usersIDs, numUsers);
+
+    frame.frameID   = depthGenerator.GetFrameID();
+    frame.timestamp = depthGenerator.GetTimestamp();
+    frame.numUsers  = numUsers;
+    frame.skeletons.clear();
+
+    n = 0;
+
+    for (i = 0; i < numUsers; i++) {
+        user = &frame.users[i];
+
+        user -> id = usersIDs[i];
+        user -> tracking = 
+            userGenerator.GetSkeletonCap().IsTracking(usersIDs[i]);
+        userGenerator.GetCoM(usersIDs[i], user -> com);
+
+        points[n++] = user -> com;
+
+        if (!user -> tracking) {
+            continue;
+        }
+
+        skeleton = frame.skeletons.retSkeleton(i);
+
+        for (j = 0; j < SNAPSHOT_JOINTS; j++) {
+            userGenerator.GetSkeletonCap().GetSkeletonJointPosition(
+                usersIDs[i],
+                SkeletonSnapshot::indexJoint(j),
+                jointPos
+            );
+
+            skeleton[j].real       = jointPos.position;
+            skeleton[j].confidence = jointPos.fConfidence;
+
+            points[n++] = jointPos.position;
+        }
+    }
+
+    sceneAnalyzer.GetFloor(frame.floor);
+    points[n++] = frame.floor.ptPoint;
+
+    // One conversion for the whole frame.
+    depthGenerator.ConvertRealWorldToProjective(n, points, points);
+
+    n = 0;
+
+    for (i = 0; i < numUsers; i++) {
+        user = &frame.users[i];
+        user -> comProjective = points[n++];
+
+        if (!user -> tracking) {
+            continue;
+        }
+
+        skeleton = frame.skeletons.retSkeleton(i);
+
+        for (j = 0; j < SNAPSHOT_JOINTS; j++) {
+            skeleton[j].projective = points[n++];
+        }
+    }
+
+    frame.floorProjective = points[n++];
+
+    // The label map is only copied when someone is drawing it.
+    if (labels) {
+        userGenerator.GetUserPixels(0, smd);
+
+        frame.labelXRes = smd.XRes();
+        frame.labelYRes = smd.YRes();
+        frame.labelFullXRes = smd.FullXRes();
+        frame.labelFullYRes = smd.FullYRes();
+        frame.labels.assign(smd.Data(), 
+                            smd.Data() + smd.XRes() * smd.YRes());
+    }
+    else {
+        frame.labelXRes = 0;
+        frame.labelYRes = 0;
+    }
+
+    // The same for the camera image, it is updated with the depth map
+    // so it matches the labels of the frame.
+    if (image && hasImage) {
+        imageGenerator.GetMetaData(imd);
+
+        frame.imageXRes = imd.XRes();
+        frame.imageYRes = imd.YRes();
+        frame.image.assign(imd.RGB24Data(), 
+                           imd.RGB24Data() + imd.XRes() * imd.YRes());
+    }
+    else {
+        frame.imageXRes = 0;
+        frame.imageYRes = 0;
+    }
+
+    return true;
+}
@@ -0,0 +1,221 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file OpenNIBackend.h
+ *
+ *  @brief Header file for the class OpenNIBackend.
+ *
+ *  This file contains the definition of the sensor backend of the
+ *  Kinect, through OpenNI and NITE.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef OPENNI_BACKEND_H
+# define OPENNI_BACKEND_H
+
+# include "common.h"
+# include "config.h"
+# include "SensorBackend.h"
+
+/**
+ *  @class OpenNIBackend
+ *
+ *  @brief Sensor backend of the Kinect.
+ *
+ *  It owns the OpenNI context and its generators. The new users are
+ *  calibrated here, with the OpenNI callbacks, until the game starts.
+ *  The frames are read from the user generator, the scene analyzer
+ *  and the depth generator, that converts all the points of a frame
+ *  to projective coordinates at once. The camera image is read from
+ *  the image generator, if the configuration has one.
+ *
+ *  The callbacks are called inside readFrame(), so when the backend
+ *  is used by the SensorThread they run in the sensor thread.
+ *
+ *  @see SensorThread
+ */
+class OpenNIBackend : public SensorBackend
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        OpenNIBackend();
+
+        /**
+         *  Class destructor.
+         */
+        ~OpenNIBackend() {}
+
+        /**
+         *  Creates the OpenNI context from a configuration file, finds
+         *  its nodes and registers the callbacks. The program exits if
+         *  the Kinect can not be used.
+         *  @param xmlFile path of the OpenNI configuration file.
+         */
+        void init(const char *xmlFile);
+
+        /**
+         *  Starts the generation of all the nodes.
+         */
+        void startGenerating();
+
+        /**
+         *  Shuts down the OpenNI context.
+         */
+        void shutdown();
+
+        /**
+         *  The Kinect is a live sensor.
+         *  @return true.
+         */
+        bool isLive();
+
+        /**
+         *  Waits for the next update of the Kinect and copies it.
+         *  @param frame where the frame will be stored.
+         *  @param labels true to copy the label map into the frame.
+         *  @param image true to copy the camera image into the frame.
+         *  @return always true.
+         */
+        bool readFrame(SensorFrame& frame, bool labels, bool image);
+
+        /**
+         *  Converts points from real world to projective coordinates
+         *  with the depth generator.
+         *  @param count number of points.
+         *  @param real points in real world coordinates.
+         *  @param projective where the projective points will be
+         *  stored, it can be the same array of real.
+         */
+        void convertRealWorldToProjective(XnUInt32 count,
+                                          const XnPoint3D *real,
+                                          XnPoint3D *projective);
+
+        /**
+         *  Indicates when to stop the calibration of new users.
+         *  @param value true to stop the detection.
+         */
+        void changeStopDetection(bool value);
+
+        /**
+         *  Stops the generation of all the nodes.
+         */
+        void stopGenerating();
+
+        /**
+         *  Callback function called when new user appears, it starts
+         *  his calibration.
+         *  @param userID user ID of the new user.
+         */
+        void newUser(XnUserID userID);
+
+        /**
+         *  Starts the calibration of an user, with the calibration
+         *  pose if it is needed.
+         *  @param userID user ID of the user to be calibrated.
+         */
+        void initCalibration(XnUserID userID);
+
+        /**
+         *  Callback function called when the calibration for a 
+         *  detected user begins.
+         *  @param userID user ID of the user to be calibrated.
+         */
+        void startCalibration(XnUserID userID);
+
+        /**
+         *  Callback function called when calibration of the 
+         *  user ends.
+         *  @param userID user ID of the user calibrated.
+         *  @param success indicates if the calibration succeded or not.
+         */
+        void endCalibration(XnUserID userID, XnBool success);
+
+        /**
+         *  Callback function called when a new pose is detected.
+         *  @param poseName name of the pose detected.
+         *  @param userID user ID of the user that made the pose.
+         */
+        void poseDetected(const XnChar *poseName, XnUserID userID);
+
+    private:
+
+        /**
+         *  OpenNI context and nodes.
+         */
+        Context context;
+        DepthGenerator depthGenerator;
+        UserGenerator userGenerator;
+        SceneAnalyzer sceneAnalyzer;
+        ImageGenerator imageGenerator;
+
+        /**
+         *  Indicates if there is an image generator with RGB pixels.
+         */
+        bool hasImage;
+
+        /** 
+         *  Name of the calibration pose.
+         */
+        XnChar strPose[20];
+
+        /** 
+         *  Indicates if the calibration pose is needed.
+         */
+        XnBool needPose;
+
+        /** 
+         *  Callback handles.
+         */
+        XnCallbackHandle userHandle;
+        XnCallbackHandle userPoseHandle;
+        XnCallbackHandle userSkelHandle;
+
+        /** 
+         *  Indicates when to stop the calibration of new users, it is
+         *  written by the game loop and read in the callbacks.
+         */
+        volatile bool stopDetection;
+
+        /** 
+         *  Method that register the callbacks relative to user
+         *  interaction with the Kinect (new user, calibrate user, etc).
+         */
+        void registerCallbacks();
+
+        /**
+         *  Copy constructor and assignment are not allowed, the
+         *  callbacks point to this object.
+         */
+        OpenNIBackend(const OpenNIBackend&);
+        OpenNIBackend& operator=(const OpenNIBackend&);
+};
+
+# endif
@@ -0,0 +1,282 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file OverlayTexture.cpp
+ *
+ *  @brief Implementation file for the class OverlayTexture.
+ *
+ *  This file contains the texture drawn under the scene with the users
+ *  pixels, and the camera image when there is one.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "OverlayTexture.h"
+
+/**
+ *  Constructor of the class.
+ */
+OverlayTexture :: OverlayTexture ()
+{
+    texture = 0;
+    texResX = 0;
+    texResY = 0;
+
+    checked    = false;
+    hasBuffers = false;
+    nextBuffer = 0;
+
+    imageXRes = 0;
+    imageYRes = 0;
+    mapped    = false;
+}
+
+/**
+ *  Makes room for the label maps of a resolution, the texture
+ *  is only created again when it grows.
+ *  @param fullXRes full width of the label map.
+ *  @param fullYRes full height of the label map.
+ */
+void OverlayTexture :: changeSize (unsigned int fullXRes, 
+                                   unsigned int fullYRes)
+{
+    int i;
+    unsigned int x;
+    unsigned int y;
+    GLint maxSize;
+    GLint size;
+    vector <XnRGB24Pixel> black;
+    vector <GLfloat> none;
+    vector <GLfloat> blue;
+
+    // OpenGL needs the size of the texture to be a power of two
+    x = (((unsigned short)(fullXRes - 1) / 512) + 1) * 512;
+    y = (((unsigned short)(fullYRes - 1) / 512) + 1) * 512;
+
+    if ((texture != 0) && (x <= texResX) && (y <= texResY)) {
+        return;
+    }
+
+    if (!checked) {
+        checked = true;
+        hasBuffers = glutExtensionSupported("GL_ARB_pixel_buffer_object");
+
+        if (hasBuffers) {
+            glGenBuffers(OVERLAY_PBOS, buffers);
+        }
+
+        // Palette of the labels, as big as the driver allows and a
+        // power of two: the users in blue
+        glGetIntegerv(GL_MAX_PIXEL_MAP_TABLE, &maxSize);
+
+        size = OVERLAY_PALETTE;
+
+        while (size > maxSize) {
+            size /= 2;
+        }
+
+        none.assign(size, 0.0f);
+        blue.assign(size, 0.0f);
+
+        for (i = 1; (i <= MAX_USERS) && (i < size); i++) {
+            blue[i] = 200.0f / 255.0f;
+        }
+
+        glPixelMapfv(GL_PIXEL_MAP_I_TO_R, size, &none[0]);
+        glPixelMapfv(GL_PIXEL_MAP_I_TO_G, size, &none[0]);
+        glPixelMapfv(GL_PIXEL_MAP_I_TO_B, size, &blue[0]);
+    }
+
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+    }
+
+    texResX = max(x, texResX);
+    texResY = max(y, texResY);
+
+    // The pixels out of the label maps stay black
+    black.assign(texResX * texResY, XnRGB24Pixel());
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glTexImage2D(GL_TEXTURE_2D, 
+                 0, 
+                 GL_RGB, 
+                 texResX, 
+                 texResY, 
+                 0, 
+                 GL_RGB, 
+                 GL_UNSIGNED_BYTE, 
+                 &black[0]);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ *  Sends a window of a label map to the texture, the users are
+ *  drawn in blue and everything else in black.
+ *  @param labels the label map, without padding.
+ *  @param xRes width of the label map.
+ *  @param window part of the label map that is sent.
+ */
+void OverlayTexture :: uploadLabels (const XnLabel *labels, 
+                                     unsigned int xRes, 
+                                     const CropWindow &window)
+{
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // The window is read from the rows of the label map, and the
+    // palette is applied while the labels are read. The first label
+    // is passed instead of the skips, some drivers ignore them with
+    // color indexes.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, xRes);
+    glPixelTransferi(GL_MAP_COLOR, GL_TRUE);
+
+    glTexSubImage2D(GL_TEXTURE_2D, 
+                    0, 
+                    0, 
+                    0, 
+                    window.width, 
+                    window.height, 
+                    GL_COLOR_INDEX, 
+                    GL_UNSIGNED_SHORT, 
+                    labels + window.top * xRes + window.left);
+
+    glPixelTransferi(GL_MAP_COLOR, GL_FALSE);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ *  Returns where the next image is written, it is sent to the
+ *  texture with uploadImage.
+ *  @param xRes width of the image.
+ *  @param yRes height of the image.
+ *  @return the pixels of the image, without padding.
+ */
+XnRGB24Pixel *OverlayTexture :: mapImage (unsigned int xRes, 
+                                          unsigned int yRes)
+{
+    XnRGB24Pixel *pixels;
+
+    imageXRes = xRes;
+    imageYRes = yRes;
+    mapped = false;
+
+    if (hasBuffers) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers[nextBuffer]);
+
+        // A new store, so the driver does not wait for the last image
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, 
+                     xRes * yRes * sizeof(XnRGB24Pixel), 
+                     NULL, 
+                     GL_STREAM_DRAW);
+
+        pixels = (XnRGB24Pixel*) glMapBuffer(GL_PIXEL_UNPACK_BUFFER, 
+                                             GL_WRITE_ONLY);
+
+        if (pixels != NULL) {
+            mapped = true;
+            return pixels;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    image.resize(xRes * yRes);
+
+    return &image[0];
+}
+
+/**
+ *  Sends the image written after mapImage to the texture.
+ */
+void OverlayTexture :: uploadImage ()
+{
+    const GLvoid *pixels;
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // From a pixel buffer the pixels are an offset in it
+    if (mapped) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        pixels = NULL;
+    }
+    else {
+        pixels = &image[0];
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, 
+                    0, 
+                    0, 
+                    0, 
+                    imageXRes, 
+                    imageYRes, 
+                    GL_RGB, 
+                    GL_UNSIGNED_BYTE, 
+                    pixels);
+
+    if (mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        nextBuffer = (nextBuffer + 1) % OVERLAY_PBOS;
+        mapped = false;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ *  Binds the texture to draw it.
+ */
+void OverlayTexture :: bind ()
+{
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+/**
+ *  Returns the width of the texture.
+ */
+unsigned int OverlayTexture :: retTexResX ()
+{
+    return texResX;
+}
+
+/**
+ *  Returns the height of the texture.
+ */
+unsigned int OverlayTexture :: retTexResY ()
+{
+    return texResY;
+}
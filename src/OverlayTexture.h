@@ -0,0 +1,154 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file OverlayTexture.h
+ *
+ *  @brief Header file for the class OverlayTexture.
+ *
+ *  This file contains the texture drawn under the scene with the users
+ *  pixels, and the camera image when there is one.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef OVERLAY_TEXTURE_H
+# define OVERLAY_TEXTURE_H
+
+# include "common.h"
+# include "config.h"
+# include "Compositor.h"
+
+/**
+ *  Number of pixel buffers the images are written in, one is filled
+ *  while the driver may still be reading the other one.
+ */
+# define OVERLAY_PBOS 2
+
+/**
+ *  Largest size of the palette of the labels, one color by label. The
+ *  driver may support less, then the labels are masked to its size.
+ */
+# define OVERLAY_PALETTE 65536
+
+/**
+ *  @class OverlayTexture
+ *
+ *  @brief Texture of the users pixels over the camera image.
+ *
+ *  The texture is created once and only the pixels of the frame are
+ *  sent every frame. The labels alone are sent as they come from the
+ *  sensor, as color indexes that OpenGL turns into colors with a
+ *  palette. The images are written directly in pixel buffers of the
+ *  driver, or in a buffer of the class if there are none.
+ */
+class OverlayTexture
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        OverlayTexture();
+
+        /**
+         *  Class destructor.
+         */
+        ~OverlayTexture() {}
+
+        /**
+         *  Makes room for the label maps of a resolution, the texture
+         *  is only created again when it grows.
+         *  @param fullXRes full width of the label map.
+         *  @param fullYRes full height of the label map.
+         */
+        void changeSize(unsigned int fullXRes, unsigned int fullYRes);
+
+        /**
+         *  Sends a window of a label map to the texture, the users are
+         *  drawn in blue and everything else in black.
+         *  @param labels the label map, without padding.
+         *  @param xRes width of the label map.
+         *  @param window part of the label map that is sent.
+         */
+        void uploadLabels(const XnLabel *labels, 
+                          unsigned int xRes, 
+                          const CropWindow &window);
+
+        /**
+         *  Returns where the next image is written, it is sent to the
+         *  texture with uploadImage.
+         *  @param xRes width of the image.
+         *  @param yRes height of the image.
+         *  @return the pixels of the image, without padding.
+         */
+        XnRGB24Pixel *mapImage(unsigned int xRes, unsigned int yRes);
+
+        /**
+         *  Sends the image written after mapImage to the texture.
+         */
+        void uploadImage();
+
+        /**
+         *  Binds the texture to draw it.
+         */
+        void bind();
+
+        /**
+         *  Returns the size of the texture.
+         */
+        unsigned int retTexResX();
+        unsigned int retTexResY();
+
+    private:
+
+        /**
+         *  Texture, 0 until it is created, and its size.
+         */
+        GLuint texture;
+        unsigned int texResX;
+        unsigned int texResY;
+
+        /**
+         *  Pixel buffers of the images, if the driver has them, and the
+         *  next one to be written.
+         */
+        bool checked;
+        bool hasBuffers;
+        GLuint buffers[OVERLAY_PBOS];
+        int nextBuffer;
+
+        /**
+         *  The image being written: its size and if it is in a pixel
+         *  buffer or in the buffer of the class.
+         */
+        unsigned int imageXRes;
+        unsigned int imageYRes;
+        bool mapped;
+        vector <XnRGB24Pixel> image;
+};
+
+# endif
@@ -0,0 +1,981 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file PoseLibrary.cpp
+ *
+ *  @brief Implementation file for the class PoseLibrary.
+ *
+ *  This file contains the reader of the poses file and the evaluation
+ *  of the poses over the skeleton snapshot.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <sys/stat.h>
+# include <xmmintrin.h>
+# include <cstdlib>
+# include <cstring>
+
+# include "PoseLibrary.h"
+# include "util.h"
+
+/**
+ *  Maximum length of a line of the poses file.
+ */
+# define POSE_LINE_SIZE 256
+
+/**
+ *  Maximum number of words of a line of the poses file.
+ */
+# define POSE_MAX_WORDS 8
+
+PoseLibrary g_PoseLibrary;
+
+/**
+ *  Names of the joints of the snapshot in the poses file.
+ */
+static const char *jointNames[SNAPSHOT_JOINTS] =
+{
+    "HEAD",
+    "NECK",
+    "TORSO",
+    "LEFT_SHOULDER",
+    "LEFT_ELBOW",
+    "LEFT_HAND",
+    "RIGHT_SHOULDER",
+    "RIGHT_ELBOW",
+    "RIGHT_HAND",
+    "LEFT_HIP",
+    "LEFT_KNEE",
+    "LEFT_FOOT",
+    "RIGHT_HIP",
+    "RIGHT_KNEE",
+    "RIGHT_FOOT"
+};
+
+/**
+ *  Returns the index of a joint in the snapshot.
+ *  @param name name of the joint in the poses file.
+ *  @return index of the joint, -1 if the name is not valid.
+ */
+static int parseJoint (const char *name)
+{
+    int i;
+
+    for (i = 0; i < SNAPSHOT_JOINTS; i++) {
+        if (strcmp(name, jointNames[i]) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ *  Reads a number of the poses file, "inf" and "-inf" are valid.
+ *  @param text word of the file.
+ *  @param value where the number is stored.
+ *  @return true if the word is a number.
+ */
+static bool parseNumber (const char *text, float& value)
+{
+    char *end;
+
+    value = strtod(text, &end);
+
+    return (end != text) && (*end == '\0');
+}
+
+/**
+ *  Reads an axis of the poses file, a sum of the axes x, y and z with
+ *  their signs, p.e. -z or -x+y. The axis is normalized.
+ *  @param text word of the file.
+ *  @param direction where the axis is stored.
+ *  @return true if the word is an axis.
+ */
+static bool parseAxis (const char *text, float *direction)
+{
+    float sign;
+    Vector3D axis;
+
+    axis = Vector3D(0.0, 0.0, 0.0);
+
+    while (*text != '\0') {
+        sign = 1.0;
+
+        if (*text == '+') {
+            text++;
+        }
+        else if (*text == '-') {
+            sign = -1.0;
+            text++;
+        }
+
+        switch (*text) {
+            case 'x':
+                axis.x += sign;
+                break;
+            case 'y':
+                axis.y += sign;
+                break;
+            case 'z':
+                axis.z += sign;
+                break;
+            default:
+                return false;
+        }
+
+        text++;
+    }
+
+    if (axis.magnitude() == 0.0) {
+        return false;
+    }
+
+    axis.normalize();
+
+    direction[0] = axis.x;
+    direction[1] = axis.y;
+    direction[2] = axis.z;
+
+    return true;
+}
+
+/**
+ *  Returns the angle of a dot product of two directions, like the
+ *  detectors did before the poses file.
+ *  @param dot dot product of the normalized directions.
+ *  @return angle in degrees.
+ */
+static float angleOf (float dot)
+{
+    return toAngle(acos(dot));
+}
+
+/**
+ *  The floats from -1 to 1 in order as integers, to search the
+ *  bounds of the dot products. Returns the float of an integer.
+ *  @param key integer of the float.
+ *  @return the float.
+ */
+static float keyToFloat (int key)
+{
+    unsigned int bits;
+    float value;
+
+    bits = (key >= 0) ? key : ((unsigned int) -key) | 0x80000000u;
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+/**
+ *  Returns the integer of a float from -1 to 1.
+ *  @param value the float.
+ *  @return integer of the float.
+ */
+static int floatToKey (float value)
+{
+    unsigned int bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & 0x80000000u) ? -((int) (bits & 0x7fffffffu)) : bits;
+}
+
+/**
+ *  Computes the range of the dot product of two directions with the
+ *  angle between two bounds.
+ *
+ *  The angle decreases with the dot product, so the floats where the
+ *  angle is inside the bounds are a range, and the ends are searched
+ *  with the same angle function that the detectors used. The decisions
+ *  are the same as with the angle, even next to the bounds, and a dot
+ *  product out of -1 to 1 or NaN is out of the range as before.
+ *  @param min minimum angle in degrees.
+ *  @param max maximum angle in degrees.
+ *  @param minDot where the minimum dot product is stored.
+ *  @param maxDot where the maximum dot product is stored.
+ */
+static void dotRange (float min, float max, float& minDot, float& maxDot)
+{
+    int low;
+    int high;
+    int middle;
+    int first;
+    int last;
+
+    // First float with the angle not above max
+    low  = floatToKey(-1.0);
+    high = floatToKey(1.0) + 1;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (angleOf(keyToFloat(middle)) <= max) {
+            high = middle;
+        }
+        else {
+            low = middle + 1;
+        }
+    }
+    first = low;
+
+    // First float with the angle below min
+    low  = floatToKey(-1.0);
+    high = floatToKey(1.0) + 1;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (!(angleOf(keyToFloat(middle)) >= min)) {
+            high = middle;
+        }
+        else {
+            low = middle + 1;
+        }
+    }
+    last = low - 1;
+
+    if (first > last) {
+        // No dot product is inside
+        minDot = 1.0;
+        maxDot = -1.0;
+    }
+    else {
+        minDot = keyToFloat(first);
+        maxDot = keyToFloat(last);
+    }
+}
+
+/**
+ *  Returns the index of a bone, the bone is added if it is not in
+ *  the list.
+ *  @param from joint where the bone starts.
+ *  @param to joint where the bone ends.
+ *  @param boneFrom joints where the bones of the list start.
+ *  @param boneTo joints where the bones of the list end.
+ *  @param numBones number of bones of the list.
+ *  @return index of the bone, -1 if the list is full.
+ */
+static int addBone (int from, 
+                    int to, 
+                    int *boneFrom, 
+                    int *boneTo, 
+                    int& numBones)
+{
+    int i;
+
+    for (i = 0; i < numBones; i++) {
+        if ((boneFrom[i] == from) && (boneTo[i] == to)) {
+            return i;
+        }
+    }
+
+    if (numBones == POSE_MAX_BONES) {
+        return -1;
+    }
+
+    boneFrom[numBones] = from;
+    boneTo[numBones]   = to;
+
+    return numBones++;
+}
+
+/**
+ *  Returns the index of an axis, the axis is added if it is not in
+ *  the list.
+ *  @param axis normalized axis.
+ *  @param axes axes of the list.
+ *  @param numAxes number of axes of the list.
+ *  @return index of the axis, -1 if the list is full.
+ */
+static int addAxis (const float *axis, float axes[][3], int& numAxes)
+{
+    int i;
+
+    for (i = 0; i < numAxes; i++) {
+        if ((axes[i][0] == axis[0]) && 
+            (axes[i][1] == axis[1]) && 
+            (axes[i][2] == axis[2])) {
+            return i;
+        }
+    }
+
+    if (numAxes == POSE_MAX_AXES) {
+        return -1;
+    }
+
+    axes[numAxes][0] = axis[0];
+    axes[numAxes][1] = axis[1];
+    axes[numAxes][2] = axis[2];
+
+    return numAxes++;
+}
+
+/**
+ *  Returns the index of the dot product of two directions, it is
+ *  added if it is not in the list. The dot product is the same in
+ *  both orders.
+ *  @param first first direction.
+ *  @param second second direction.
+ *  @param featureFirst first directions of the list.
+ *  @param featureSecond second directions of the list.
+ *  @param numFeatures number of dot products of the list.
+ *  @return index of the dot product, -1 if the list is full.
+ */
+static int addFeature (int first, 
+                       int second, 
+                       int *featureFirst, 
+                       int *featureSecond, 
+                       int& numFeatures)
+{
+    int i;
+
+    for (i = 0; i < numFeatures; i++) {
+        if (((featureFirst[i] == first) && (featureSecond[i] == second)) ||
+            ((featureFirst[i] == second) && (featureSecond[i] == first))) {
+            return i;
+        }
+    }
+
+    if (numFeatures == POSE_MAX_FEATURES) {
+        return -1;
+    }
+
+    featureFirst[numFeatures]  = first;
+    featureSecond[numFeatures] = second;
+
+    return numFeatures++;
+}
+
+/**
+ *  Repeats the last elements of a list up to a multiple of four,
+ *  so the list can be read four at a time.
+ *  @param first first list.
+ *  @param second second list.
+ *  @param count number of elements, it is updated.
+ */
+static void padToFour (int *first, int *second, int& count)
+{
+    while ((count % 4) != 0) {
+        first[count]  = first[count - 1];
+        second[count] = second[count - 1];
+        count++;
+    }
+}
+
+/**
+ *  Loads four floats of a list.
+ *  @param values list of floats.
+ *  @param indexes indexes of the four floats.
+ *  @return the four floats.
+ */
+static inline __m128 gather (const float *values, const int *indexes)
+{
+    return _mm_set_ps(values[indexes[3]], 
+                      values[indexes[2]], 
+                      values[indexes[1]], 
+                      values[indexes[0]]);
+}
+
+/**
+ *  Order of the definitions of the poses, by pose.
+ */
+static bool variantBefore (const PoseVariant& a, const PoseVariant& b)
+{
+    return a.pose < b.pose;
+}
+
+/**
+ *  Constructor of the class.
+ */
+PoseLibrary :: PoseLibrary ()
+{
+    int slot;
+
+    modified    = 0;
+    size        = 0;
+    frames      = 0;
+    numBones    = 0;
+    numFeatures = 0;
+
+    for (slot = 0; slot < MAX_USERS; slot++) {
+        computed[slot]  = false;
+        confident[slot] = 0;
+    }
+}
+
+/**
+ *  Reads the poses file, if it was not read yet. The program
+ *  exits if the file is not valid.
+ *  @param newPath path of the poses file.
+ */
+void PoseLibrary :: open (const char *newPath)
+{
+    if (path == newPath) {
+        return;
+    }
+
+    path = newPath;
+
+    if (!load()) {
+        reportError("Could not read the poses file " + path);
+    }
+}
+
+/**
+ *  Reads the poses file again if it has changed since it was
+ *  read. It is checked every POSE_RELOAD_FRAMES calls, once per
+ *  frame. On errors the old poses are kept.
+ */
+void PoseLibrary :: reloadIfChanged ()
+{
+    struct stat info;
+
+    if (path.empty() || (++frames < POSE_RELOAD_FRAMES)) {
+        return;
+    }
+
+    frames = 0;
+
+    if ((stat(path.c_str(), &info) != 0) ||
+        ((info.st_mtime == modified) && (info.st_size == size))) {
+        return;
+    }
+
+    if (load()) {
+        printf("Poses read again from %s\n", path.c_str());
+    }
+    else {
+        // The errors are printed once, until the file changes again
+        modified = info.st_mtime;
+        size     = info.st_size;
+    }
+}
+
+/**
+ *  Returns the index of a pose.
+ *  @param name name of the pose.
+ *  @return index of the pose, it is valid even if the file has
+ *  no pose with that name yet.
+ */
+int PoseLibrary :: findPose (const char *name)
+{
+    unsigned int i;
+
+    for (i = 0; i < names.size(); i++) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+
+    names.push_back(name);
+
+    return names.size() - 1;
+}
+
+/**
+ *  Returns the hold time of a pose.
+ *  @param pose index of the pose.
+ *  @return seconds that the pose must be held, 0 if the pose
+ *  is not in the file.
+ */
+double PoseLibrary :: retHoldTime (int pose) const
+{
+    if ((pose < 0) || (pose >= (int) holdTimes.size())) {
+        return 0.0;
+    }
+
+    return holdTimes[pose];
+}
+
+/**
+ *  Computes the features of the poses for all the tracked
+ *  users of a frame, it is called once per frame.
+ *
+ *  The bones and the dot products are computed four at a time with
+ *  the same operations of Vector3D, so the features are the same
+ *  that the detectors computed one by one.
+ *  @param frame sensor frame with the skeletons.
+ */
+void PoseLibrary :: computeFeatures (const SensorFrame *frame)
+{
+    int i;
+    int slot;
+    const SnapshotJoint *skeleton;
+
+    __m128 startX;
+    __m128 startY;
+    __m128 startZ;
+    __m128 dx;
+    __m128 dy;
+    __m128 dz;
+    __m128 magnitude;
+    __m128 dot;
+
+    for (slot = 0; slot < MAX_USERS; slot++) {
+        computed[slot] = (slot < frame -> numUsers) && 
+                         frame -> users[slot].tracking;
+
+        if (!computed[slot]) {
+            continue;
+        }
+
+        skeleton = frame -> skeletons.retSkeleton(slot);
+
+        // Joints by coordinate and their confidence
+        confident[slot] = 0;
+        for (i = 0; i < SNAPSHOT_JOINTS; i++) {
+            jointX[slot][i] = skeleton[i].real.X;
+            jointY[slot][i] = skeleton[i].real.Y;
+            jointZ[slot][i] = skeleton[i].real.Z;
+
+            if (skeleton[i].confidence >= CONFIDENCE) {
+                confident[slot] |= 1 << i;
+            }
+        }
+
+        // Normalized directions of the bones
+        for (i = 0; i < numBones; i += 4) {
+            startX = gather(jointX[slot], &boneFrom[i]);
+            startY = gather(jointY[slot], &boneFrom[i]);
+            startZ = gather(jointZ[slot], &boneFrom[i]);
+
+            dx = _mm_sub_ps(gather(jointX[slot], &boneTo[i]), startX);
+            dy = _mm_sub_ps(gather(jointY[slot], &boneTo[i]), startY);
+            dz = _mm_sub_ps(gather(jointZ[slot], &boneTo[i]), startZ);
+
+            magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx),
+                                                          _mm_mul_ps(dy, dy)),
+                                               _mm_mul_ps(dz, dz)));
+
+            _mm_storeu_ps(&directionX[slot][i], _mm_div_ps(dx, magnitude));
+            _mm_storeu_ps(&directionY[slot][i], _mm_div_ps(dy, magnitude));
+            _mm_storeu_ps(&directionZ[slot][i], _mm_div_ps(dz, magnitude));
+        }
+
+        // Dot products of the directions
+        for (i = 0; i < numFeatures; i += 4) {
+            dot = _mm_add_ps(
+                      _mm_add_ps(
+                          _mm_mul_ps(gather(directionX[slot], &featureFirst[i]),
+                                     gather(directionX[slot], &featureSecond[i])),
+                          _mm_mul_ps(gather(directionY[slot], &featureFirst[i]),
+                                     gather(directionY[slot], &featureSecond[i]))),
+                      _mm_mul_ps(gather(directionZ[slot], &featureFirst[i]),
+                                 gather(directionZ[slot], &featureSecond[i])));
+
+            _mm_storeu_ps(&features[slot][i], dot);
+        }
+    }
+}
+
+/**
+ *  Indicates if an user is in a pose.
+ *  @param pose index of the pose.
+ *  @param slot slot of the user in the frame, -1 if the user
+ *  is not in the frame.
+ *  @return true if any definition of the pose matches.
+ */
+bool PoseLibrary :: matches (int pose, int slot) const
+{
+    int i;
+
+    if ((slot == -1) || !computed[slot] || (pose < 0) || 
+        (pose >= (int) variantStart.size())) {
+        return false;
+    }
+
+    for (i = variantStart[pose]; i < variantEnd[pose]; i++) {
+        if (matchesVariant(variants[i], slot)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  Indicates if the joints of a pose can be seen.
+ *  @param pose index of the pose.
+ *  @param slot slot of the user in the frame, -1 if the user
+ *  is not in the frame.
+ *  @return true if the joints of any definition of the pose
+ *  have enough confidence.
+ */
+bool PoseLibrary :: isVisible (int pose, int slot) const
+{
+    int i;
+
+    if ((slot == -1) || !computed[slot] || (pose < 0) || 
+        (pose >= (int) variantStart.size())) {
+        return false;
+    }
+
+    for (i = variantStart[pose]; i < variantEnd[pose]; i++) {
+        if (isConfident(variants[i], slot)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  Indicates if an user matches one definition of a pose.
+ *  @param variant definition of the pose.
+ *  @param slot slot of the user in the frame.
+ *  @return true if all the predicates are true.
+ */
+bool PoseLibrary :: matchesVariant (const PoseVariant& variant, int slot) const
+{
+    int i;
+    float dot;
+    float height;
+    float base;
+    const PosePredicate *predicate;
+
+    if (!isConfident(variant, slot)) {
+        return false;
+    }
+
+    for (i = variant.first; i < variant.first + variant.count; i++) {
+        predicate = &predicates[i];
+
+        if (predicate -> type == POSE_HEIGHT) {
+            height = jointY[slot][predicate -> joints[0]];
+            base   = jointY[slot][predicate -> joints[1]];
+
+            if (!((height >= base + predicate -> min) && 
+                  (height <= base + predicate -> max))) {
+                return false;
+            }
+        }
+        else {
+            dot = features[slot][predicate -> feature];
+
+            if (!((dot >= predicate -> minDot) && 
+                  (dot <= predicate -> maxDot))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ *  Reads and compiles the poses file, the current poses are
+ *  replaced only if the whole file is valid.
+ *
+ *  Every line has a command and its words, # starts a comment:
+ *  - pose NAME starts a definition of the pose NAME.
+ *  - hold SECONDS time that the pose must be held.
+ *  - bones A B C D MIN MAX angle between the bones A to B and C to D.
+ *  - axis A B AXIS MIN MAX angle between the bone A to B and an axis.
+ *  - height A B MIN MAX height of the joint A over the joint B.
+ *  - end finishes the definition.
+ *
+ *  @return true if the file is valid.
+ */
+bool PoseLibrary :: load ()
+{
+    FILE *file;
+    int i;
+    int j;
+    int slot;
+    int numWords;
+    int lineNumber;
+    int first;
+    int second;
+    bool valid;
+    bool inPose;
+    char line[POSE_LINE_SIZE];
+    char *words[POSE_MAX_WORDS];
+    char *word;
+    char *comment;
+    const char *error;
+    float axis[3];
+    struct stat info;
+
+    int newNumBones;
+    int newBoneFrom[POSE_MAX_BONES];
+    int newBoneTo[POSE_MAX_BONES];
+    int newNumAxes;
+    float newAxes[POSE_MAX_AXES][3];
+    int newNumFeatures;
+    int newFeatureFirst[POSE_MAX_FEATURES];
+    int newFeatureSecond[POSE_MAX_FEATURES];
+
+    PoseVariant variant;
+    PosePredicate predicate;
+
+    vector <PoseVariant> newVariants;
+    vector <PosePredicate> newPredicates;
+    vector <double> newHoldTimes;
+    vector <bool> holdGiven;
+
+    if (stat(path.c_str(), &info) != 0) {
+        printf("Could not find the poses file %s\n", path.c_str());
+        return false;
+    }
+
+    file = fopen(path.c_str(), "r");
+    if (file == NULL) {
+        printf("Could not open the poses file %s\n", path.c_str());
+        return false;
+    }
+
+    newNumBones    = 0;
+    newNumAxes     = 0;
+    newNumFeatures = 0;
+
+    valid      = true;
+    inPose     = false;
+    lineNumber = 0;
+    error      = NULL;
+
+    while (valid && (fgets(line, POSE_LINE_SIZE, file) != NULL)) {
+        lineNumber++;
+
+        comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+
+        numWords = 0;
+        word     = strtok(line, " \t\r\n");
+        while ((word != NULL) && (numWords < POSE_MAX_WORDS)) {
+            words[numWords++] = word;
+            word = strtok(NULL, " \t\r\n");
+        }
+
+        if (numWords == 0) {
+            continue;
+        }
+
+        if (strcmp(words[0], "pose") == 0) {
+            if (inPose || (numWords != 2)) {
+                error = "expected pose NAME after the end of a pose";
+                valid = false;
+                break;
+            }
+
+            inPose = true;
+
+            variant.pose   = findPose(words[1]);
+            variant.first  = newPredicates.size();
+            variant.count  = 0;
+            variant.joints = 0;
+
+            newHoldTimes.resize(names.size(), 0.0);
+            holdGiven.resize(names.size(), false);
+            continue;
+        }
+
+        if (!inPose) {
+            error = "expected pose NAME";
+            valid = false;
+            break;
+        }
+
+        if (strcmp(words[0], "end") == 0) {
+            variant.count = newPredicates.size() - variant.first;
+            newVariants.push_back(variant);
+            inPose = false;
+            continue;
+        }
+
+        if (strcmp(words[0], "hold") == 0) {
+            if ((numWords != 2) || !parseNumber(words[1], predicate.min)) {
+                error = "expected hold SECONDS";
+                valid = false;
+                break;
+            }
+
+            // The first definition of a pose gives its hold time
+            if (!holdGiven[variant.pose]) {
+                newHoldTimes[variant.pose] = predicate.min;
+                holdGiven[variant.pose]    = true;
+            }
+            continue;
+        }
+
+        if (strcmp(words[0], "bones") == 0) {
+            predicate.type = POSE_BONES;
+            valid = (numWords == 7);
+            for (i = 0; valid && (i < 4); i++) {
+                predicate.joints[i] = parseJoint(words[i + 1]);
+                valid = (predicate.joints[i] != -1);
+            }
+            valid = valid && 
+                    parseNumber(words[5], predicate.min) &&
+                    parseNumber(words[6], predicate.max);
+            error = "expected bones JOINT JOINT JOINT JOINT MIN MAX";
+        }
+        else if (strcmp(words[0], "axis") == 0) {
+            predicate.type = POSE_AXIS;
+            valid = (numWords == 6);
+            for (i = 0; valid && (i < 2); i++) {
+                predicate.joints[i] = parseJoint(words[i + 1]);
+                valid = (predicate.joints[i] != -1);
+            }
+            predicate.joints[2] = predicate.joints[1];
+            predicate.joints[3] = predicate.joints[1];
+            valid = valid && 
+                    parseAxis(words[3], axis) &&
+                    parseNumber(words[4], predicate.min) &&
+                    parseNumber(words[5], predicate.max);
+            error = "expected axis JOINT JOINT AXIS MIN MAX";
+        }
+        else if (strcmp(words[0], "height") == 0) {
+            predicate.type = POSE_HEIGHT;
+            valid = (numWords == 5);
+            for (i = 0; valid && (i < 2); i++) {
+                predicate.joints[i] = parseJoint(words[i + 1]);
+                valid = (predicate.joints[i] != -1);
+            }
+            predicate.joints[2] = predicate.joints[1];
+            predicate.joints[3] = predicate.joints[1];
+            valid = valid && 
+                    parseNumber(words[3], predicate.min) &&
+                    parseNumber(words[4], predicate.max);
+            error = "expected height JOINT JOINT MIN MAX";
+        }
+        else {
+            valid = false;
+            error = "unknown command";
+        }
+
+        if (!valid) {
+            break;
+        }
+
+        predicate.feature = -1;
+        predicate.minDot  = 0.0;
+        predicate.maxDot  = 0.0;
+
+        if (predicate.type != POSE_HEIGHT) {
+            // The bones and the angles are shared by all the poses
+            first = addBone(predicate.joints[0], predicate.joints[1], 
+                            newBoneFrom, newBoneTo, newNumBones);
+
+            if (predicate.type == POSE_BONES) {
+                second = addBone(predicate.joints[2], predicate.joints[3], 
+                                 newBoneFrom, newBoneTo, newNumBones);
+            }
+            else {
+                second = addAxis(axis, newAxes, newNumAxes);
+                if (second != -1) {
+                    second += POSE_MAX_BONES;
+                }
+            }
+
+            if ((first == -1) || (second == -1)) {
+                error = "too many bones or axes in the poses";
+                valid = false;
+                break;
+            }
+
+            predicate.feature = addFeature(first, second, 
+                                           newFeatureFirst, 
+                                           newFeatureSecond, 
+                                           newNumFeatures);
+
+            if (predicate.feature == -1) {
+                error = "too many angles in the poses";
+                valid = false;
+                break;
+            }
+
+            dotRange(predicate.min, predicate.max, 
+                     predicate.minDot, predicate.maxDot);
+        }
+
+        for (i = 0; i < 4; i++) {
+            variant.joints |= 1 << predicate.joints[i];
+        }
+        newPredicates.push_back(predicate);
+    }
+
+    fclose(file);
+
+    if (valid && inPose) {
+        error = "the last pose has no end";
+        valid = false;
+    }
+
+    if (!valid) {
+        printf("%s:%d: %s\n", path.c_str(), lineNumber, error);
+        return false;
+    }
+
+    // The definitions of every pose are together
+    stable_sort(newVariants.begin(), newVariants.end(), variantBefore);
+
+    newHoldTimes.resize(names.size(), 0.0);
+    variantStart.assign(names.size(), 0);
+    variantEnd.assign(names.size(), 0);
+
+    for (i = 0; i < (int) newVariants.size(); i = j) {
+        j = i;
+        while ((j < (int) newVariants.size()) && 
+               (newVariants[j].pose == newVariants[i].pose)) {
+            j++;
+        }
+        variantStart[newVariants[i].pose] = i;
+        variantEnd[newVariants[i].pose]   = j;
+    }
+
+    variants   = newVariants;
+    predicates = newPredicates;
+    holdTimes  = newHoldTimes;
+
+    // The features are read four at a time
+    padToFour(newBoneFrom, newBoneTo, newNumBones);
+    padToFour(newFeatureFirst, newFeatureSecond, newNumFeatures);
+
+    numBones    = newNumBones;
+    numFeatures = newNumFeatures;
+    memcpy(boneFrom, newBoneFrom, numBones * sizeof(int));
+    memcpy(boneTo, newBoneTo, numBones * sizeof(int));
+    memcpy(featureFirst, newFeatureFirst, numFeatures * sizeof(int));
+    memcpy(featureSecond, newFeatureSecond, numFeatures * sizeof(int));
+
+    // The axes are directions after the bones, the same for all the
+    // users, and the features must be computed again
+    for (slot = 0; slot < MAX_USERS; slot++) {
+        for (i = 0; i < newNumAxes; i++) {
+            directionX[slot][POSE_MAX_BONES + i] = newAxes[i][0];
+            directionY[slot][POSE_MAX_BONES + i] = newAxes[i][1];
+            directionZ[slot][POSE_MAX_BONES + i] = newAxes[i][2];
+        }
+        computed[slot] = false;
+    }
+
+    modified   = info.st_mtime;
+    size       = info.st_size;
+
+    return true;
+}
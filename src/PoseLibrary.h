@@ -0,0 +1,366 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file PoseLibrary.h
+ *
+ *  @brief Header file for the class PoseLibrary.
+ *
+ *  This file contains the definition of the poses read from the poses
+ *  file, compiled into a table of predicates over the joints of the
+ *  skeleton snapshot.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef POSE_LIBRARY_H
+# define POSE_LIBRARY_H
+
+# include <sys/types.h>
+
+# include "common.h"
+# include "config.h"
+# include "SkeletonSnapshot.h"
+# include "SensorFrame.h"
+
+/**
+ *  Frames between two checks of the modification time of the poses
+ *  file.
+ */
+# define POSE_RELOAD_FRAMES 30
+
+/**
+ *  Maximum number of different bones, axes and angles of all the
+ *  poses, the features of the users are computed four at a time.
+ */
+# define POSE_MAX_BONES 64
+# define POSE_MAX_AXES 16
+# define POSE_MAX_FEATURES 128
+
+/**
+ *  Types of the predicates of a pose.
+ */
+enum PosePredicateType {
+    POSE_BONES = 0,
+    POSE_AXIS,
+    POSE_HEIGHT
+};
+
+/**
+ *  @class PosePredicate
+ *
+ *  @brief One condition of a pose.
+ *
+ *  - POSE_BONES the angle between the bones joints[0] to joints[1]
+ *    and joints[2] to joints[3] is between min and max degrees.
+ *  - POSE_AXIS the angle between the bone joints[0] to joints[1] and
+ *    the axis is between min and max degrees.
+ *  - POSE_HEIGHT the height of the joint joints[0] minus the height of
+ *    joints[1] is between min and max millimeters.
+ *
+ *  The joints are indexes inside the skeletons of the snapshot. The
+ *  angles are not computed while playing: the bounds are turned into
+ *  the range of the dot product of the directions when the file is
+ *  read, and the dot product is a feature of the user computed once
+ *  per frame, so the predicate is a comparison.
+ */
+class PosePredicate
+{
+    public:
+
+        /**
+         *  Type of the predicate.
+         */
+        int type;
+
+        /**
+         *  Joints of the predicate.
+         */
+        int joints[4];
+
+        /**
+         *  Feature of POSE_BONES and POSE_AXIS, the index of the dot
+         *  product in the features of the users.
+         */
+        int feature;
+
+        /**
+         *  Bounds of the angle or the height.
+         */
+        float min;
+        float max;
+
+        /**
+         *  Range of the dot product of the directions with the angle
+         *  between min and max.
+         */
+        float minDot;
+        float maxDot;
+};
+
+/**
+ *  @class PoseVariant
+ *
+ *  @brief One definition of a pose in the file, a range of the
+ *  predicates.
+ */
+class PoseVariant
+{
+    public:
+
+        /**
+         *  Pose of the definition.
+         */
+        int pose;
+
+        /**
+         *  First predicate and number of predicates.
+         */
+        int first;
+        int count;
+        /**
+         *  Bits of the joints used by the predicates, all of them must
+         *  have enough confidence.
+         */
+        XnUInt32 joints;
+};
+
+/**
+ *  @class PoseLibrary
+ *
+ *  @brief Poses of the game, read from a text file.
+ *
+ *  Every pose of the file is a list of predicates over the bones and
+ *  the joints of the user, and a hold time. A pose can be defined more
+ *  than once, it matches when any of its definitions does, so new ways
+ *  of doing a pose only need the file. The file is read again when it
+ *  changes, and the detectors use the new poses in the next frame.
+ *
+ *  The poses are found by name once, the index of a name never changes
+ *  when the file is read again.
+ *
+ *  The bones and angles of all the poses are compiled into one list.
+ *  Once per frame computeFeatures() computes, for every tracked user
+ *  and with SSE, the direction of every bone and the dot product of
+ *  every angle. All the detectors read these features of the users.
+ *
+ *  @see PoseVariant
+ *  @see PosePredicate
+ */
+class PoseLibrary
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        PoseLibrary();
+
+        /**
+         *  Class destructor.
+         */
+        ~PoseLibrary() {}
+
+        /**
+         *  Reads the poses file, if it was not read yet. The program
+         *  exits if the file is not valid.
+         *  @param path path of the poses file.
+         */
+        void open(const char *path);
+
+        /**
+         *  Reads the poses file again if it has changed since it was
+         *  read. It is checked every POSE_RELOAD_FRAMES calls, once per
+         *  frame. On errors the old poses are kept.
+         */
+        void reloadIfChanged();
+
+        /**
+         *  Returns the index of a pose.
+         *  @param name name of the pose.
+         *  @return index of the pose, it is valid even if the file has
+         *  no pose with that name yet.
+         */
+        int findPose(const char *name);
+
+        /**
+         *  Returns the hold time of a pose.
+         *  @param pose index of the pose.
+         *  @return seconds that the pose must be held, 0 if the pose
+         *  is not in the file.
+         */
+        double retHoldTime(int pose) const;
+
+        /**
+         *  Computes the features of the poses for all the tracked
+         *  users of a frame, it is called once per frame.
+         *  @param frame sensor frame with the skeletons.
+         */
+        void computeFeatures(const SensorFrame *frame);
+
+        /**
+         *  Indicates if an user is in a pose.
+         *  @param pose index of the pose.
+         *  @param slot slot of the user in the frame, -1 if the user
+         *  is not in the frame.
+         *  @return true if any definition of the pose matches.
+         */
+        bool matches(int pose, int slot) const;
+
+        /**
+         *  Indicates if the joints of a pose can be seen.
+         *  @param pose index of the pose.
+         *  @param slot slot of the user in the frame, -1 if the user
+         *  is not in the frame.
+         *  @return true if the joints of any definition of the pose
+         *  have enough confidence.
+         */
+        bool isVisible(int pose, int slot) const;
+
+    private:
+
+        /**
+         *  Path of the poses file, empty if it was not opened.
+         */
+        string path;
+
+        /**
+         *  Modification time and size of the file when it was read.
+         */
+        time_t modified;
+        off_t size;
+
+        /**
+         *  Calls to reloadIfChanged() since the last check.
+         */
+        int frames;
+
+        /**
+         *  Names of the poses, the index of a name is the index of
+         *  the pose.
+         */
+        vector <string> names;
+
+        /**
+         *  Hold time of every pose.
+         */
+        vector <double> holdTimes;
+
+        /**
+         *  Definitions of the poses, sorted by pose, and the first
+         *  and last definition of every pose.
+         */
+        vector <PoseVariant> variants;
+        vector <int> variantStart;
+        vector <int> variantEnd;
+
+        /**
+         *  Predicates of all the definitions.
+         */
+        vector <PosePredicate> predicates;
+
+        /**
+         *  Joints where the bones start and end, the bones are
+         *  repeated up to a multiple of four.
+         */
+        int numBones;
+        int boneFrom[POSE_MAX_BONES];
+        int boneTo[POSE_MAX_BONES];
+
+        /**
+         *  Directions of the dot products of every feature, indexes
+         *  of the bones or POSE_MAX_BONES plus the index of an axis.
+         *  The features are repeated up to a multiple of four.
+         */
+        int numFeatures;
+        int featureFirst[POSE_MAX_FEATURES];
+        int featureSecond[POSE_MAX_FEATURES];
+
+        /**
+         *  Directions of the bones and the axes of every user, by
+         *  coordinate. The axes are after the bones.
+         */
+        float directionX[MAX_USERS][POSE_MAX_BONES + POSE_MAX_AXES];
+        float directionY[MAX_USERS][POSE_MAX_BONES + POSE_MAX_AXES];
+        float directionZ[MAX_USERS][POSE_MAX_BONES + POSE_MAX_AXES];
+
+        /**
+         *  Positions of the joints of every user, by coordinate.
+         */
+        float jointX[MAX_USERS][SNAPSHOT_JOINTS];
+        float jointY[MAX_USERS][SNAPSHOT_JOINTS];
+        float jointZ[MAX_USERS][SNAPSHOT_JOINTS];
+
+        /**
+         *  Dot products of the features of every user.
+         */
+        float features[MAX_USERS][POSE_MAX_FEATURES];
+
+        /**
+         *  Bits of the joints of every user with enough confidence.
+         */
+        XnUInt32 confident[MAX_USERS];
+
+        /**
+         *  Indicates if the features of every user were computed in
+         *  the current frame.
+         */
+        bool computed[MAX_USERS];
+
+        /**
+         *  Reads and compiles the poses file, the current poses are
+         *  replaced only if the whole file is valid.
+         *  @return true if the file is valid.
+         */
+        bool load();
+
+        /**
+         *  Indicates if the joints of a definition of a pose have
+         *  enough confidence.
+         *  @param variant definition of the pose.
+         *  @param slot slot of the user in the frame.
+         *  @return true if all the joints have enough confidence.
+         */
+        bool isConfident(const PoseVariant& variant, int slot) const
+        {
+            return (variant.joints & ~confident[slot]) == 0;
+        }
+
+        /**
+         *  Indicates if an user matches one definition of a pose.
+         *  @param variant definition of the pose.
+         *  @param slot slot of the user in the frame.
+         *  @return true if all the predicates are true.
+         */
+        bool matchesVariant(const PoseVariant& variant, int slot) const;
+};
+
+/**
+ *  Poses of the game.
+ */
+extern PoseLibrary g_PoseLibrary;
+
+# endif
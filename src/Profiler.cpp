@@ -0,0 +1,268 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Profiler.cpp
+ *
+ *  @brief Implementation file for the class Profiler.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class Profiler.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <cmath>
+# include <cstdio>
+# include <cstring>
+# include <time.h>
+
+# include "config.h"
+# include "Profiler.h"
+
+/**
+ *  Names of the stages in the dumps.
+ */
+static const char *stageNames[PROFILE_STAGES] = {
+    "acquire",
+    "checkUsers",
+    "detectPose",
+    "nextFrame",
+    "drawScene",
+    "drawFireBalls",
+    "glutSwapBuffers",
+    "frame"
+};
+
+/**
+ *  Profiler of the game.
+ */
+Profiler g_Profiler;
+
+/**
+ *  Constructor of the class.
+ */
+Profiler :: Profiler ()
+{
+    enabled  = false;
+    lastDump = 0;
+
+    memset(counts, 0, sizeof(counts));
+    memset(dumped, 0, sizeof(dumped));
+    memset(sums, 0, sizeof(sums));
+    memset(dumpedSums, 0, sizeof(dumpedSums));
+}
+
+/**
+ *  Enables or disables the profiler.
+ *  @param value true to enable the profiler.
+ */
+void Profiler :: enable (bool value)
+{
+    lastDump = now();
+    enabled  = value;
+}
+
+/**
+ *  Adds a latency to the histogram of a stage.
+ *  @param stage stage of the frame.
+ *  @param nanoseconds latency of the stage.
+ */
+void Profiler :: record (int stage, XnUInt64 nanoseconds)
+{
+    counts[stage][bucket(nanoseconds)]++;
+    sums[stage] += nanoseconds;
+}
+
+/**
+ *  Prints the histograms if PROFILER_DUMP_SECONDS passed since
+ *  the last dump. It is called once per frame by the game loop.
+ */
+void Profiler :: dumpIfDue ()
+{
+    if (!enabled) {
+        return;
+    }
+
+    if (now() - lastDump >= PROFILER_DUMP_SECONDS * 1000000000ULL) {
+        dump();
+    }
+}
+
+/**
+ *  Prints the count, p50, p99, max and mean of every stage since
+ *  the last dump.
+ */
+void Profiler :: dump ()
+{
+    int i;
+    int j;
+    int top;
+    XnUInt32 total;
+    XnUInt32 snapshot[PROFILE_BUCKETS];
+    XnUInt32 delta[PROFILE_BUCKETS];
+    XnUInt64 sum;
+    XnUInt64 current;
+
+    current = now();
+
+    printf("Profile of the last %.1f s (usec)\n", 
+           (current - lastDump) / 1000000000.0);
+    printf("  %-16s %8s %10s %10s %10s %10s\n", 
+           "stage", "count", "p50", "p99", "max", "mean");
+
+    for (i = 0; i < PROFILE_STAGES; i++) {
+        // The acquire stage may be written while it is copied
+        memcpy(snapshot, counts[i], sizeof(snapshot));
+        sum = sums[i];
+
+        total = 0;
+        top   = 0;
+
+        for (j = 0; j < PROFILE_BUCKETS; j++) {
+            delta[j] = snapshot[j] - dumped[i][j];
+            total   += delta[j];
+            if (delta[j] > 0) {
+                top = j;
+            }
+        }
+
+        if (total > 0) {
+            printf("  %-16s %8u %10.1f %10.1f %10.1f %10.1f\n",
+                   stageNames[i],
+                   total,
+                   percentile(delta, total, 0.50) / 1000.0,
+                   percentile(delta, total, 0.99) / 1000.0,
+                   bucketLow(top + 1) / 1000.0,
+                   (sum - dumpedSums[i]) / (total * 1000.0));
+        }
+
+        memcpy(dumped[i], snapshot, sizeof(snapshot));
+        dumpedSums[i] = sum;
+    }
+
+    lastDump = current;
+}
+
+/**
+ *  Returns the time of the monotonic clock.
+ *  @return time in nanoseconds.
+ */
+XnUInt64 Profiler :: now ()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (XnUInt64) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ *  Returns the bucket of a latency. The first buckets are one
+ *  nanosecond wide, then every power of two is split in
+ *  PROFILE_SUB_BUCKETS buckets.
+ *  @param nanoseconds latency.
+ *  @return bucket index.
+ */
+int Profiler :: bucket (XnUInt64 nanoseconds)
+{
+    int exponent;
+    int index;
+
+    if (nanoseconds < PROFILE_SUB_BUCKETS) {
+        return (int) nanoseconds;
+    }
+
+    // 2^exponent <= nanoseconds < 2^(exponent + 1), exponent >= 3
+    exponent = 63 - __builtin_clzll(nanoseconds);
+    index    = (exponent - 2) * PROFILE_SUB_BUCKETS + 
+               (int) ((nanoseconds >> (exponent - 3)) & 
+                      (PROFILE_SUB_BUCKETS - 1));
+
+    if (index >= PROFILE_BUCKETS) {
+        index = PROFILE_BUCKETS - 1;
+    }
+
+    return index;
+}
+
+/**
+ *  Returns the lowest latency of a bucket.
+ *  @param index bucket index.
+ *  @return latency in nanoseconds.
+ */
+double Profiler :: bucketLow (int index)
+{
+    int exponent;
+
+    if (index < PROFILE_SUB_BUCKETS) {
+        return index;
+    }
+
+    exponent = index / PROFILE_SUB_BUCKETS + 2;
+
+    return ldexp((double) (PROFILE_SUB_BUCKETS + 
+                           index % PROFILE_SUB_BUCKETS), 
+                 exponent - 3);
+}
+
+/**
+ *  Returns the latency in the middle of a bucket.
+ *  @param index bucket index.
+ *  @return latency in nanoseconds.
+ */
+double Profiler :: bucketValue (int index)
+{
+    return (bucketLow(index) + bucketLow(index + 1)) / 2.0;
+}
+
+/**
+ *  Returns a percentile of a histogram.
+ *  @param histogram latencies of a stage since the last dump.
+ *  @param total number of latencies in the histogram.
+ *  @param fraction percentile between 0 and 1.
+ *  @return latency in nanoseconds.
+ */
+double Profiler :: percentile (const XnUInt32 *histogram, 
+                               XnUInt32 total, 
+                               double fraction)
+{
+    int i;
+    XnUInt32 seen;
+    XnUInt32 rank;
+
+    rank = (XnUInt32) ceil(fraction * total);
+    seen = 0;
+
+    for (i = 0; i < PROFILE_BUCKETS; i++) {
+        seen += histogram[i];
+        if (seen >= rank) {
+            return bucketValue(i);
+        }
+    }
+
+    return bucketValue(PROFILE_BUCKETS - 1);
+}
@@ -0,0 +1,265 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Profiler.h
+ *
+ *  @brief Header file for the classes Profiler and ProfileZone.
+ *
+ *  This file contains the definition of the stage profiler of the
+ *  game, wich keeps a latency histogram of every stage of a frame.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef PROFILER_H
+# define PROFILER_H
+
+# include "SensorTypes.h"
+
+/**
+ *  Stages of a frame measured by the profiler.
+ *  - PROFILE_ACQUIRE reading a frame from the sensor backend,
+ *    without the wait for the sensor.
+ *  - PROFILE_CHECK_USERS taking the frame and checking the players.
+ *  - PROFILE_DETECT_POSE detecting the poses of the players.
+ *  - PROFILE_NEXT_FRAME advancing the game.
+ *  - PROFILE_DRAW_SCENE drawing the players.
+ *  - PROFILE_DRAW_FIREBALLS drawing the flames.
+ *  - PROFILE_SWAP_BUFFERS swapping the OpenGL buffers.
+ *  - PROFILE_FRAME the whole frame of the game loop.
+ */
+enum ProfileStage
+{
+    PROFILE_ACQUIRE = 0,
+    PROFILE_CHECK_USERS,
+    PROFILE_DETECT_POSE,
+    PROFILE_NEXT_FRAME,
+    PROFILE_DRAW_SCENE,
+    PROFILE_DRAW_FIREBALLS,
+    PROFILE_SWAP_BUFFERS,
+    PROFILE_FRAME,
+    PROFILE_STAGES
+};
+
+/**
+ *  The histograms have PROFILE_SUB_BUCKETS buckets for every power
+ *  of two of nanoseconds, so the percentiles are within a 12%.
+ */
+# define PROFILE_SUB_BUCKETS 8
+# define PROFILE_BUCKETS (PROFILE_SUB_BUCKETS * 40)
+
+/**
+ *  @class Profiler
+ *
+ *  @brief Latency histograms of the stages of a frame.
+ *
+ *  The times are taken with the monotonic clock. Every stage has a
+ *  histogram of its latencies that is only written by one thread,
+ *  the acquire stage by the sensor thread and the others by the game
+ *  loop. The histograms are never reset, every PROFILER_DUMP_SECONDS
+ *  the game loop prints the count, p50, p99, max and mean of every
+ *  stage from the difference with the last dump. Then the dump only
+ *  reads what the sensor thread writes.
+ *
+ *  The profiler is disabled by default, then the zones only check a
+ *  flag.
+ *
+ *  @see ProfileZone
+ */
+class Profiler
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        Profiler();
+
+        /**
+         *  Class destructor.
+         */
+        ~Profiler() {}
+
+        /**
+         *  Enables or disables the profiler.
+         *  @param value true to enable the profiler.
+         */
+        void enable(bool value);
+
+        /**
+         *  Indicates if the profiler is enabled.
+         *  @return true if the profiler is enabled.
+         */
+        bool isEnabled()
+        {
+            return enabled;
+        }
+
+        /**
+         *  Adds a latency to the histogram of a stage.
+         *  @param stage stage of the frame.
+         *  @param nanoseconds latency of the stage.
+         */
+        void record(int stage, XnUInt64 nanoseconds);
+
+        /**
+         *  Prints the histograms if PROFILER_DUMP_SECONDS passed
+         *  since the last dump. It is called once per frame by the
+         *  game loop.
+         */
+        void dumpIfDue();
+
+        /**
+         *  Prints the count, p50, p99, max and mean of every stage
+         *  since the last dump.
+         */
+        void dump();
+
+        /**
+         *  Returns the time of the monotonic clock.
+         *  @return time in nanoseconds.
+         */
+        static XnUInt64 now();
+
+    private:
+
+        /**
+         *  Indicates if the profiler is enabled.
+         */
+        volatile bool enabled;
+
+        /**
+         *  Time of the last dump.
+         */
+        XnUInt64 lastDump;
+
+        /**
+         *  Histograms of the latencies since the start.
+         */
+        XnUInt32 counts[PROFILE_STAGES][PROFILE_BUCKETS];
+
+        /**
+         *  Histograms at the last dump.
+         */
+        XnUInt32 dumped[PROFILE_STAGES][PROFILE_BUCKETS];
+
+        /**
+         *  Sum of the latencies since the start and at the last dump.
+         */
+        XnUInt64 sums[PROFILE_STAGES];
+        XnUInt64 dumpedSums[PROFILE_STAGES];
+
+        /**
+         *  Returns the bucket of a latency.
+         *  @param nanoseconds latency.
+         *  @return bucket index.
+         */
+        static int bucket(XnUInt64 nanoseconds);
+
+        /**
+         *  Returns the lowest latency of a bucket.
+         *  @param index bucket index.
+         *  @return latency in nanoseconds.
+         */
+        static double bucketLow(int index);
+
+        /**
+         *  Returns the latency in the middle of a bucket.
+         *  @param index bucket index.
+         *  @return latency in nanoseconds.
+         */
+        static double bucketValue(int index);
+
+        /**
+         *  Returns a percentile of a histogram.
+         *  @param histogram latencies of a stage since the last dump.
+         *  @param total number of latencies in the histogram.
+         *  @param fraction percentile between 0 and 1.
+         *  @return latency in nanoseconds.
+         */
+        static double percentile(const XnUInt32 *histogram, 
+                                 XnUInt32 total, 
+                                 double fraction);
+};
+
+/**
+ *  Profiler of the game.
+ */
+extern Profiler g_Profiler;
+
+/**
+ *  @class ProfileZone
+ *
+ *  @brief Scoped marker of a stage.
+ *
+ *  It takes the time when it is created and adds the latency to the
+ *  stage when it is destroyed, p.e:
+ *
+ *      {
+ *          ProfileZone zone(PROFILE_NEXT_FRAME);
+ *          game -> nextFrame();
+ *      }
+ */
+class ProfileZone
+{
+    public:
+
+        /**
+         *  Constructor of the class, starts the zone.
+         *  @param profileStage stage of the frame.
+         */
+        ProfileZone(int profileStage)
+        {
+            stage = profileStage;
+            start = g_Profiler.isEnabled() ? Profiler::now() : 0;
+        }
+
+        /**
+         *  Class destructor, ends the zone.
+         */
+        ~ProfileZone()
+        {
+            if (start != 0) {
+                g_Profiler.record(stage, Profiler::now() - start);
+            }
+        }
+
+    private:
+
+        /**
+         *  Stage of the frame.
+         */
+        int stage;
+
+        /**
+         *  Time of the start of the zone, 0 if the profiler was
+         *  disabled.
+         */
+        XnUInt64 start;
+};
+
+# endif
@@ -0,0 +1,276 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ProjectileSystem.cpp
+ *
+ *  @brief Implementation file for the class ProjectileSystem.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class ProjectileSystem.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <xmmintrin.h>
+
+# include "ProjectileSystem.h"
+
+/**
+ *  Speed of every kind of projectile, in every step of the game.
+ */
+static const float g_ProjectileSpeed[PROJECTILE_KINDS] = {
+    Z_SHOOT_SPEED,
+    L_SHOOT_SPEED
+};
+
+/**
+ *  Distance where every kind of projectile is removed.
+ */
+static const float g_ProjectileRange[PROJECTILE_KINDS] = {
+    Z_SHOOT_MAX_DIST,
+    L_SHOOT_MAX_DIST
+};
+
+/**
+ *  Constructor of the class.
+ */
+ProjectileSystem :: ProjectileSystem ()
+{
+    count = 0;
+}
+
+/**
+ *  Adds a projectile.
+ *  @param kind kind of the projectile.
+ *  @param position initial position.
+ *  @param direction direction of the projectile, the speed of the kind
+ *  is applied to it.
+ *  @param owner player who made the projectile.
+ */
+void ProjectileSystem :: add (int kind, 
+                              XnPoint3D position, 
+                              Vector3D direction, 
+                              XnUserID owner)
+{
+    int padded;
+    Vector3D speed;
+
+    // The arrays grow four projectiles at a time, the new lanes are
+    // zero so they are never removed
+    if (count == x.size()) {
+        padded = count + 4;
+
+        x.resize(padded, 0.0f);
+        y.resize(padded, 0.0f);
+        z.resize(padded, 0.0f);
+        dx.resize(padded, 0.0f);
+        dy.resize(padded, 0.0f);
+        dz.resize(padded, 0.0f);
+        ox.resize(padded, 0.0f);
+        oy.resize(padded, 0.0f);
+        oz.resize(padded, 0.0f);
+        range2.resize(padded, 0.0f);
+        this -> owner.resize(padded, 0);
+        this -> kind.resize(padded, 0);
+    }
+
+    // The projectiles move in every tick
+    speed = direction * (g_ProjectileSpeed[kind] / SIM_TICKS_PER_STEP);
+
+    x[count]  = ox[count] = position.X;
+    y[count]  = oy[count] = position.Y;
+    z[count]  = oz[count] = position.Z;
+    dx[count] = speed.x;
+    dy[count] = speed.y;
+    dz[count] = speed.z;
+
+    range2[count] = g_ProjectileRange[kind] * g_ProjectileRange[kind];
+
+    this -> owner[count] = owner;
+    this -> kind[count]  = kind;
+
+    count++;
+}
+
+/**
+ *  Moves every projectile to its next position and removes the
+ *  projectiles that went too far from their initial position.
+ */
+void ProjectileSystem :: advance ()
+{
+    int i;
+    int k;
+    int kept;
+    int culled;
+    __m128 px;
+    __m128 py;
+    __m128 pz;
+    __m128 distX;
+    __m128 distY;
+    __m128 distZ;
+    __m128 dist2;
+
+    kept = 0;
+
+    for (i = 0; i < count; i += 4) {
+        px = _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&dx[i]));
+        py = _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_loadu_ps(&dy[i]));
+        pz = _mm_add_ps(_mm_loadu_ps(&z[i]), _mm_loadu_ps(&dz[i]));
+
+        _mm_storeu_ps(&x[i], px);
+        _mm_storeu_ps(&y[i], py);
+        _mm_storeu_ps(&z[i], pz);
+
+        // Squared distance to the initial position, without the sqrt
+        distX = _mm_sub_ps(px, _mm_loadu_ps(&ox[i]));
+        distY = _mm_sub_ps(py, _mm_loadu_ps(&oy[i]));
+        distZ = _mm_sub_ps(pz, _mm_loadu_ps(&oz[i]));
+
+        dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(distX, distX),
+                                      _mm_mul_ps(distY, distY)),
+                           _mm_mul_ps(distZ, distZ));
+
+        culled = _mm_movemask_ps(_mm_cmpgt_ps(dist2, 
+                                              _mm_loadu_ps(&range2[i])));
+
+        // The lanes after the last projectile are not counted
+        if (count - i < 4) {
+            culled &= (1 << (count - i)) - 1;
+        }
+
+        // While nothing is removed the projectiles stay in place
+        if ((culled == 0) && (kept == i)) {
+            kept = min(i + 4, count);
+            continue;
+        }
+
+        for (k = 0; (k < 4) && (i + k < count); k++) {
+            if (!(culled & (1 << k))) {
+                move(i + k, kept);
+                kept++;
+            }
+        }
+    }
+
+    count = kept;
+}
+
+/**
+ *  Removes the marked projectiles, keeping the order of the others.
+ *  @param marked indicates for every projectile if it has to be
+ *  removed.
+ */
+void ProjectileSystem :: remove (const vector <bool>& marked)
+{
+    int i;
+    int kept;
+
+    kept = 0;
+
+    for (i = 0; i < count; i++) {
+        if (!marked[i]) {
+            move(i, kept);
+            kept++;
+        }
+    }
+
+    count = kept;
+}
+
+/**
+ *  Removes all the projectiles.
+ */
+void ProjectileSystem :: clear ()
+{
+    count = 0;
+}
+
+/**
+ *  Copies a projectile over another one.
+ *  @param from index of the projectile to be copied.
+ *  @param to index where it is copied.
+ */
+void ProjectileSystem :: move (int from, int to)
+{
+    if (from == to) {
+        return;
+    }
+
+    x[to]      = x[from];
+    y[to]      = y[from];
+    z[to]      = z[from];
+    dx[to]     = dx[from];
+    dy[to]     = dy[from];
+    dz[to]     = dz[from];
+    ox[to]     = ox[from];
+    oy[to]     = oy[from];
+    oz[to]     = oz[from];
+    range2[to] = range2[from];
+    owner[to]  = owner[from];
+    kind[to]   = kind[from];
+}
+
+# ifndef SFB_HEADLESS
+
+/**
+ *  Draws the projectiles, spheres of water for Zamus and ice for Linq.
+ *  @param alpha part of a tick since the last advance, the projectiles
+ *  are drawn between their last two positions.
+ */
+void ProjectileSystem :: draw (float alpha) const
+{
+    int i;
+    float back;
+
+    //Material information
+    GLfloat materialColor[] = {0.2f, 0.2f, 1.0f, 1.0f};
+    GLfloat materialSpecular[] = {1.0f, 1.0f, 1.0f, 1.0f};
+                            
+    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, materialColor);
+    glMaterialfv(GL_FRONT, GL_SPECULAR, materialSpecular);
+
+    // They move in a straight line, the last position is one step
+    // back
+    back = 1.0f - alpha;
+
+    for (i = 0; i < count; i++) {
+        glPushMatrix();
+        glTranslatef(x[i] - dx[i] * back, 
+                     y[i] - dy[i] * back, 
+                     z[i] - dz[i] * back);
+        if (kind[i] == ZAMUS_SHOOT) {
+            glutSolidSphere(30.0, 8, 8);
+        }
+        else {
+            glTranslatef(0.0, -150.0, 0.0);
+            glutSolidSphere(50.0, 4, 2);
+        }
+        glPopMatrix();
+    }
+}
+
+# endif
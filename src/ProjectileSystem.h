@@ -0,0 +1,210 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ProjectileSystem.h
+ *
+ *  @brief Header file for the class ProjectileSystem.
+ *
+ *  This file contains the definition of the class ProjectileSystem,
+ *  where the water shoots of Zamus and the ices of Linq are stored.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef PROJECTILE_SYSTEM_H
+# define PROJECTILE_SYSTEM_H
+
+# include "common.h"
+# include "config.h"
+
+/**
+ *  Kinds of projectiles.
+ *
+ *  - ZAMUS_SHOOT water shoot of Zamus.
+ *  - LINQ_ICE ice spawned by Linq.
+ */
+enum ProjectileKind {
+    ZAMUS_SHOOT = 0,
+    LINQ_ICE,
+    PROJECTILE_KINDS
+};
+
+/**
+ *  @class ProjectileSystem
+ *
+ *  @brief Projectiles of all the players.
+ *
+ *  Every field of the projectiles is stored in its own array, so the
+ *  projectiles are advanced four at a time with SSE. The arrays are
+ *  padded to a multiple of four. The projectiles keep the order in
+ *  which they were added.
+ */
+class ProjectileSystem
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        ProjectileSystem();
+
+        /**
+         *  Class destructor.
+         */
+        ~ProjectileSystem() {}
+
+        /**
+         *  Adds a projectile.
+         *  @param kind kind of the projectile.
+         *  @param position initial position.
+         *  @param direction direction of the projectile, the speed of
+         *  the kind is applied to it.
+         *  @param owner player who made the projectile.
+         */
+        void add(int kind, 
+                 XnPoint3D position, 
+                 Vector3D direction, 
+                 XnUserID owner);
+
+        /**
+         *  Moves every projectile to its next position and removes the
+         *  projectiles that went too far from their initial position.
+         */
+        void advance();
+
+        /**
+         *  Removes the marked projectiles, keeping the order of the
+         *  others.
+         *  @param marked indicates for every projectile if it has to
+         *  be removed.
+         */
+        void remove(const vector <bool>& marked);
+
+        /**
+         *  Removes all the projectiles.
+         */
+        void clear();
+
+        /**
+         *  Returns the number of projectiles.
+         */
+        int size() const
+        {
+            return count;
+        }
+
+        /**
+         *  Returns the position of a projectile.
+         *  @param i index of the projectile.
+         */
+        Vector3D retPosition(int i) const
+        {
+            return Vector3D(x[i], y[i], z[i]);
+        }
+
+        /**
+         *  Returns the player who made a projectile.
+         *  @param i index of the projectile.
+         */
+        XnUserID retOwner(int i) const
+        {
+            return owner[i];
+        }
+
+        /**
+         *  Returns the kind of a projectile.
+         *  @param i index of the projectile.
+         */
+        int retKind(int i) const
+        {
+            return kind[i];
+        }
+
+# ifndef SFB_HEADLESS
+
+        /**
+         *  Draws the projectiles, spheres of water for Zamus and ice
+         *  for Linq.
+         *  @param alpha part of a tick since the last advance, the
+         *  projectiles are drawn between their last two positions.
+         */
+        void draw(float alpha) const;
+
+# endif
+
+    private:
+
+        /**
+         *  Number of projectiles.
+         */
+        int count;
+
+        /**
+         *  Current position.
+         */
+        vector <float> x;
+        vector <float> y;
+        vector <float> z;
+
+        /**
+         *  Movement in every frame.
+         */
+        vector <float> dx;
+        vector <float> dy;
+        vector <float> dz;
+
+        /**
+         *  Initial position.
+         */
+        vector <float> ox;
+        vector <float> oy;
+        vector <float> oz;
+
+        /**
+         *  Square of the distance where the projectile is removed.
+         */
+        vector <float> range2;
+
+        /**
+         *  Player who made the projectile.
+         */
+        vector <XnUserID> owner;
+
+        /**
+         *  Kind of the projectile.
+         */
+        vector <int> kind;
+
+        /**
+         *  Copies a projectile over another one.
+         *  @param from index of the projectile to be copied.
+         *  @param to index where it is copied.
+         */
+        void move(int from, int to);
+};
+
+# endif
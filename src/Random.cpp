@@ -0,0 +1,101 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file Random.cpp
+ *
+ *  @brief Implementation file for the class Random.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class Random.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "Random.h"
+
+/**
+ *  Multiplier and increment of the LCG of PCG32.
+ */
+# define PCG_MULTIPLIER 6364136223846793005ULL
+# define PCG_INCREMENT  1442695040888963407ULL
+
+/**
+ *  Constructor of the class.
+ *  @param seed seed of the numbers.
+ */
+Random :: Random (XnUInt64 seed)
+{
+    setSeed(seed);
+}
+
+/**
+ *  Starts the numbers again with a seed.
+ *  @param seed seed of the numbers.
+ */
+void Random :: setSeed (XnUInt64 seed)
+{
+    state = 0;
+    next();
+    state += seed;
+    next();
+}
+
+/**
+ *  Returns the next number, between 0 and 2^32 - 1.
+ */
+XnUInt32 Random :: next ()
+{
+    XnUInt64 old;
+    XnUInt32 xorShifted;
+    XnUInt32 rotation;
+
+    old   = state;
+    state = old * PCG_MULTIPLIER + PCG_INCREMENT;
+
+    xorShifted = (XnUInt32) (((old >> 18) ^ old) >> 27);
+    rotation   = (XnUInt32) (old >> 59);
+
+    return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+/**
+ *  Returns a number between 0 and n - 1.
+ *  @param n number of values, greater than 0.
+ */
+int Random :: nextInt (int n)
+{
+    return (int) (((XnUInt64) next() * n) >> 32);
+}
+
+/**
+ *  Returns a number between 0 and 1, 1 not included.
+ */
+float Random :: nextFloat ()
+{
+    // The 24 high bits fit in the mantissa of a float
+    return (next() >> 8) * (1.0f / 16777216.0f);
+}
@@ -22,83 +22,77 @@
  *
  */
 
+
 /**
- *  @file LinqSpawnIce.h
+ *  @file Random.h
+ *
+ *  @brief Header file for the class Random.
  *
- *  @brief This file contains the definition of the class LinqSpawnIce.
+ *  This file contains the definition of the class Random, the random
+ *  numbers of a game.
  *
  *  @authors Alfonso Ros e Ismael Mendonça
  *
  */
 
-# include "common.h"
-# include "util.h"
-# include "config.h"
+# ifndef RANDOM_H
+# define RANDOM_H
 
-# ifndef LINQ_SPAWN_ICE_H
-# define LINQ_SPAWN_ICE_H
+# include "common.h"
 
 /**
- *  @class LinqSpawnIce
- *
- *  @brief This class handles the Ice spawned by Linq.
+ *  @class Random
  *
- *  This class is the equivalent to the class ZamusShoot. It has the
- *  information about the position and direction of the Ice.
+ *  @brief Generator of random numbers with its own state.
  *
+ *  It is a PCG32 generator, a 64 bits LCG with a permuted output of
+ *  32 bits. Unlike rand(), every game has its own generator, so the
+ *  same seed gives the same numbers in every platform whatever the
+ *  other parts of the program do.
  */
-class LinqSpawnIce {
-
+class Random
+{
     public:
 
         /**
-         * Initial position of the spawnIce
+         *  Constructor of the class.
+         *  @param seed seed of the numbers.
          */
-
-        XnPoint3D initialPosition;
+        Random(XnUInt64 seed = 1);
 
         /**
-         * Actual position 
+         *  Class destructor.
          */
-        XnPoint3D position;
+        ~Random() {}
 
         /**
-         * Direction 
+         *  Starts the numbers again with a seed.
+         *  @param seed seed of the numbers.
          */
-        Vector3D direction;
+        void setSeed(XnUInt64 seed);
 
         /**
-         * Constructor
-         */
-        LinqSpawnIce();
-        
-        /**
-         * Constructor
+         *  Returns the next number, between 0 and 2^32 - 1.
          */
-        LinqSpawnIce(XnPoint3D pos, Vector3D dir, XnUserID p);
+        XnUInt32 next();
 
         /**
-         * Player who spawn this ice 
+         *  Returns a number between 0 and n - 1.
+         *  @param n number of values, greater than 0.
          */
-        XnUserID player;
+        int nextInt(int n);
 
         /**
-         *  True if the spawnIce is not too far.
-         *
-         *  @return True if the ice dosen't whent too far. False in
-         *  other case.
+         *  Returns a number between 0 and 1, 1 not included.
          */
-        bool isAlive();
+        float nextFloat();
 
-        /**
-         * Calculate next spawnIce position 
-         */
-        void nextPosition();
+    private:
 
-        /** 
-         * Opengl function to display 
+        /**
+         *  State of the generator.
          */
-        void drawSpawnIce();
+        XnUInt64 state;
 };
 
 # endif
@@ -0,0 +1,274 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ReplayBackend.cpp
+ *
+ *  @brief Implementation of the class ReplayBackend.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+
+# include "ReplayBackend.h"
+
+/**
+ *  Constructor of the class.
+ */
+ReplayBackend :: ReplayBackend ()
+{
+    data      = NULL;
+    size      = 0;
+    header    = NULL;
+    frames    = NULL;
+    numFrames = 0;
+    current   = 0;
+}
+
+
+/**
+ *  Class destructor, closes the recording.
+ */
+ReplayBackend :: ~ReplayBackend ()
+{
+    close();
+}
+
+
+/**
+ *  Opens a recording.
+ *  @param path path of the recording file.
+ *  @return true if the recording is valid.
+ */
+bool ReplayBackend :: open (const char *path)
+{
+    int fd;
+    struct stat info;
+
+    close();
+
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Could not open the recording %s\n", path);
+        return false;
+    }
+
+    if (fstat(fd, &info) != 0 || 
+        info.st_size < (off_t) sizeof(RecordingHeader)) {
+        printf("The recording %s is too short\n", path);
+        ::close(fd);
+        return false;
+    }
+
+    size = info.st_size;
+    data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps the file open
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        printf("Could not map the recording %s\n", path);
+        data = NULL;
+        return false;
+    }
+
+    // The frames are read in order
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    header = (const RecordingHeader *) data;
+
+    if (header -> magic != RECORDING_MAGIC ||
+        header -> version != RECORDING_VERSION ||
+        header -> maxUsers != MAX_USERS ||
+        header -> joints != SNAPSHOT_JOINTS ||
+        header -> frameSize != sizeof(RecordedFrame)) {
+        printf("The recording %s has a different format\n", path);
+        close();
+        return false;
+    }
+
+    frames    = (const RecordedFrame *) (header + 1);
+    numFrames = (size - sizeof(RecordingHeader)) / sizeof(RecordedFrame);
+    current   = 0;
+
+    return true;
+}
+
+
+/**
+ *  Closes the recording.
+ */
+void ReplayBackend :: close ()
+{
+    if (data != NULL) {
+        munmap(data, size);
+    }
+
+    data      = NULL;
+    size      = 0;
+    header    = NULL;
+    frames    = NULL;
+    numFrames = 0;
+    current   = 0;
+}
+
+
+/**
+ *  Fills the next frame of the recording.
+ *  @param frame where the frame will be stored.
+ *  @param labels ignored, the label map is not recorded.
+ *  @param image ignored, the camera image is not recorded.
+ *  @return false if there are no more frames. A corrupt frame
+ *  ends the recording.
+ */
+bool ReplayBackend :: readFrame (SensorFrame& frame, 
+                                 bool labels, 
+                                 bool image)
+{
+    int i;
+    int j;
+    const RecordedFrame *recorded;
+    const RecordedUser *in;
+    SensorUser *user;
+    SnapshotJoint *skeleton;
+
+    ProfileZone zone(PROFILE_ACQUIRE);
+
+    if (current >= numFrames) {
+        return false;
+    }
+
+    recorded = &frames[current];
+
+    // The header was checked in open(), but not the frames. A corrupt
+    // frame ends the recording, the frames before it are still played.
+    if (recorded -> numUsers > MAX_USERS) {
+        printf("The frame %u of the recording has %u users\n", 
+               current, 
+               recorded -> numUsers);
+        numFrames = current;
+        return false;
+    }
+
+    current++;
+
+    frame.frameID   = recorded -> frameID;
+    frame.timestamp = recorded -> timestamp;
+    frame.numUsers  = recorded -> numUsers;
+
+    frame.skeletons.clear();
+    frame.labels.clear();
+    frame.labelXRes = 0;
+    frame.labelYRes = 0;
+    frame.image.clear();
+    frame.imageXRes = 0;
+    frame.imageYRes = 0;
+
+    frame.floor.ptPoint.X = recorded -> floor[0];
+    frame.floor.ptPoint.Y = recorded -> floor[1];
+    frame.floor.ptPoint.Z = recorded -> floor[2];
+    frame.floor.vNormal.X = recorded -> floor[3];
+    frame.floor.vNormal.Y = recorded -> floor[4];
+    frame.floor.vNormal.Z = recorded -> floor[5];
+    frame.floorProjective.X = recorded -> floorProjective[0];
+    frame.floorProjective.Y = recorded -> floorProjective[1];
+    frame.floorProjective.Z = recorded -> floorProjective[2];
+
+    for (i = 0; i < frame.numUsers; i++) {
+        in   = &recorded -> users[i];
+        user = &frame.users[i];
+
+        user -> id       = in -> id;
+        user -> tracking = in -> tracking != 0;
+
+        user -> com.X = in -> com[0];
+        user -> com.Y = in -> com[1];
+        user -> com.Z = in -> com[2];
+        user -> comProjective.X = in -> comProjective[0];
+        user -> comProjective.Y = in -> comProjective[1];
+        user -> comProjective.Z = in -> comProjective[2];
+
+        if (!user -> tracking) {
+            continue;
+        }
+
+        skeleton = frame.skeletons.retSkeleton(i);
+        for (j = 0; j < SNAPSHOT_JOINTS; j++) {
+            skeleton[j].real.X       = in -> joints[j][0];
+            skeleton[j].real.Y       = in -> joints[j][1];
+            skeleton[j].real.Z       = in -> joints[j][2];
+            skeleton[j].projective.X = in -> joints[j][3];
+            skeleton[j].projective.Y = in -> joints[j][4];
+            skeleton[j].projective.Z = in -> joints[j][5];
+            skeleton[j].confidence   = in -> joints[j][6];
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ *  Starts the recording again from its first frame.
+ */
+void ReplayBackend :: rewind ()
+{
+    current = 0;
+}
+
+
+/**
+ *  Returns the number of frames of the recording.
+ *  @return number of frames.
+ */
+XnUInt32 ReplayBackend :: retNumFrames ()
+{
+    return numFrames;
+}
+
+
+/**
+ *  Returns the number of players of the recorded game.
+ *  @return number of players.
+ */
+int ReplayBackend :: retPlayers ()
+{
+    return (header != NULL) ? header -> players : 0;
+}
+
+
+/**
+ *  Returns the seed of the random numbers of the recorded game.
+ *  @return seed.
+ */
+unsigned int ReplayBackend :: retSeed ()
+{
+    return (header != NULL) ? header -> seed : 0;
+}
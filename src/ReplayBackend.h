@@ -0,0 +1,152 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file ReplayBackend.h
+ *
+ *  @brief Header file for the class ReplayBackend.
+ *
+ *  This file contains the definition of the sensor backend that plays
+ *  a recording made by the SkeletonRecorder.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef REPLAY_BACKEND_H
+# define REPLAY_BACKEND_H
+
+# include "common.h"
+# include "config.h"
+# include "SensorBackend.h"
+# include "SkeletonRecording.h"
+
+/**
+ *  @class ReplayBackend
+ *
+ *  @brief Sensor backend that plays a recording.
+ *
+ *  The recording is mapped in memory, so the frames are read directly
+ *  from the page cache without copies nor system calls, and they can
+ *  be played as fast as the game logic allows.
+ *
+ *  @see SkeletonRecorder
+ */
+class ReplayBackend : public SensorBackend
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        ReplayBackend();
+
+        /**
+         *  Class destructor, closes the recording.
+         */
+        ~ReplayBackend();
+
+        /**
+         *  Opens a recording.
+         *  @param path path of the recording file.
+         *  @return true if the recording is valid.
+         */
+        bool open(const char *path);
+
+        /**
+         *  Closes the recording.
+         */
+        void close();
+
+        /**
+         *  Fills the next frame of the recording.
+         *  @param frame where the frame will be stored.
+         *  @param labels ignored, the label map is not recorded.
+         *  @param image ignored, the camera image is not recorded.
+         *  @return false if there are no more frames. A corrupt frame
+         *  ends the recording.
+         */
+        bool readFrame(SensorFrame& frame, bool labels, bool image);
+
+        /**
+         *  Starts the recording again from its first frame.
+         */
+        void rewind();
+
+        /**
+         *  Returns the number of frames of the recording.
+         *  @return number of frames.
+         */
+        XnUInt32 retNumFrames();
+
+        /**
+         *  Returns the number of players of the recorded game.
+         *  @return number of players.
+         */
+        int retPlayers();
+
+        /**
+         *  Returns the seed of the random numbers of the recorded game.
+         *  @return seed.
+         */
+        unsigned int retSeed();
+
+    private:
+
+        /**
+         *  Mapped file, NULL if there is no recording.
+         */
+        void *data;
+
+        /**
+         *  Size of the mapped file.
+         */
+        size_t size;
+
+        /**
+         *  Header and frames of the recording.
+         */
+        const RecordingHeader *header;
+        const RecordedFrame *frames;
+
+        /**
+         *  Number of frames of the recording.
+         */
+        XnUInt32 numFrames;
+
+        /**
+         *  Next frame to be played.
+         */
+        XnUInt32 current;
+
+        /**
+         *  Copy constructor and assignment are not allowed, the
+         *  backend owns the mapping.
+         */
+        ReplayBackend(const ReplayBackend&);
+        ReplayBackend& operator=(const ReplayBackend&);
+};
+
+# endif
@@ -0,0 +1,289 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file RigMath.cpp
+ *
+ *  @brief Implementation file of the matrices of the characters.
+ *
+ *  This file contains the functions that build the matrices of the
+ *  parts of the characters on the CPU, in the order of OpenGL.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <xmmintrin.h>
+
+# include "RigMath.h"
+
+/**
+ *  Sets a matrix to the identity.
+ *  @param m the matrix.
+ */
+void identityMatrix(float *m)
+{
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+/**
+ *  Multiplies two matrices, like glMultMatrix: out = a * b.
+ *  @param a matrix on the left.
+ *  @param b matrix on the right.
+ *  @param out the product, it can not be a or b.
+ */
+void multiplyMatrix(const float *a, const float *b, float *out)
+{
+    int j;
+    __m128 column[4];
+    __m128 sum;
+
+    for (j = 0; j < 4; j++) {
+        column[j] = _mm_loadu_ps(&a[4 * j]);
+    }
+
+    // Every column of the product combines the columns of a
+    for (j = 0; j < 4; j++) {
+        sum = _mm_add_ps(
+                  _mm_add_ps(_mm_mul_ps(column[0], _mm_set1_ps(b[4 * j])),
+                             _mm_mul_ps(column[1], _mm_set1_ps(b[4 * j + 1]))),
+                  _mm_add_ps(_mm_mul_ps(column[2], _mm_set1_ps(b[4 * j + 2])),
+                             _mm_mul_ps(column[3], _mm_set1_ps(b[4 * j + 3]))));
+
+        _mm_storeu_ps(&out[4 * j], sum);
+    }
+}
+
+/**
+ *  Multiplies a matrix by a translation, like glTranslate.
+ *  @param m the matrix.
+ *  @param x,y,z vector of the translation.
+ */
+void translateMatrix(float *m, float x, float y, float z)
+{
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        m[12 + i] += x * m[i] + y * m[4 + i] + z * m[8 + i];
+    }
+}
+
+/**
+ *  Multiplies a matrix by a scale, like glScale.
+ *  @param m the matrix.
+ *  @param x,y,z factors of the scale.
+ */
+void scaleMatrix(float *m, float x, float y, float z)
+{
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        m[i]     *= x;
+        m[4 + i] *= y;
+        m[8 + i] *= z;
+    }
+}
+
+/**
+ *  Multiplies a matrix by a rotation, like glRotate.
+ *  @param m the matrix.
+ *  @param angle angle in degrees.
+ *  @param x,y,z axis of the rotation, it does not need to be unit.
+ */
+void rotateMatrix(float *m, float angle, float x, float y, float z)
+{
+    int i;
+    float r[3][3];
+    float column[3][3];
+    float length;
+    float c;
+    float s;
+    float t;
+
+    length = sqrt(x * x + y * y + z * z);
+
+    // OpenGL does not rotate around a null axis either
+    if (length < 1.0e-4) {
+        return;
+    }
+
+    x /= length;
+    y /= length;
+    z /= length;
+
+    c = cos(angle * M_PI / 180.0);
+    s = sin(angle * M_PI / 180.0);
+    t = 1.0 - c;
+
+    // Rows of the rotation
+    r[0][0] = x * x * t + c;
+    r[0][1] = x * y * t - z * s;
+    r[0][2] = x * z * t + y * s;
+    r[1][0] = y * x * t + z * s;
+    r[1][1] = y * y * t + c;
+    r[1][2] = y * z * t - x * s;
+    r[2][0] = z * x * t - y * s;
+    r[2][1] = z * y * t + x * s;
+    r[2][2] = z * z * t + c;
+
+    for (i = 0; i < 3; i++) {
+        column[0][i] = m[i];
+        column[1][i] = m[4 + i];
+        column[2][i] = m[8 + i];
+    }
+
+    for (i = 0; i < 3; i++) {
+        m[i]     = column[0][i] * r[0][0] + column[1][i] * r[1][0] +
+                   column[2][i] * r[2][0];
+        m[4 + i] = column[0][i] * r[0][1] + column[1][i] * r[1][1] +
+                   column[2][i] * r[2][1];
+        m[8 + i] = column[0][i] * r[0][2] + column[1][i] * r[1][2] +
+                   column[2][i] * r[2][2];
+    }
+}
+
+/**
+ *  Chooses between two vectors with a mask.
+ */
+static inline __m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ *  Computes the matrices of some bones, four at a time. The matrix of a
+ *  bone moves the origin to its first point and turns the Z axis to
+ *  its second point, with the shortest rotation, built from a
+ *  quaternion. A bone with both points equal is only moved.
+ *  @param from coordinates of the first points, one array by axis.
+ *  @param to coordinates of the second points, one array by axis.
+ *  @param count number of bones. The arrays must have room for count
+ *  rounded up to a multiple of 4.
+ *  @param matrices the matrices of the bones, in the order of OpenGL.
+ *  @param lengths the lengths of the bones.
+ */
+void boneMatrices(const float * const from[3], 
+                  const float * const to[3], 
+                  int count, 
+                  float (*matrices)[16], 
+                  float *lengths)
+{
+    int i;
+    int c;
+    int k;
+    __m128 zero;
+    __m128 one;
+    __m128 two;
+    __m128 epsilon;
+    __m128 dx;
+    __m128 dy;
+    __m128 dz;
+    __m128 length;
+    __m128 mask;
+    __m128 w;
+    __m128 x;
+    __m128 y;
+    __m128 norm;
+    __m128 column[4][4];
+
+    zero    = _mm_setzero_ps();
+    one     = _mm_set1_ps(1.0f);
+    two     = _mm_set1_ps(2.0f);
+    epsilon = _mm_set1_ps(1.0e-6f);
+
+    for (i = 0; i < count; i += 4) {
+        column[3][0] = _mm_loadu_ps(&from[0][i]);
+        column[3][1] = _mm_loadu_ps(&from[1][i]);
+        column[3][2] = _mm_loadu_ps(&from[2][i]);
+        column[3][3] = one;
+
+        dx = _mm_sub_ps(_mm_loadu_ps(&to[0][i]), column[3][0]);
+        dy = _mm_sub_ps(_mm_loadu_ps(&to[1][i]), column[3][1]);
+        dz = _mm_sub_ps(_mm_loadu_ps(&to[2][i]), column[3][2]);
+
+        length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx),
+                                                   _mm_mul_ps(dy, dy)),
+                                        _mm_mul_ps(dz, dz)));
+        _mm_storeu_ps(&lengths[i], length);
+
+        // Unit direction of the bone, Z for the bones of no length
+        mask = _mm_cmplt_ps(length, epsilon);
+        length = select(mask, one, length);
+
+        dx = _mm_andnot_ps(mask, _mm_div_ps(dx, length));
+        dy = _mm_andnot_ps(mask, _mm_div_ps(dy, length));
+        dz = select(mask, one, _mm_div_ps(dz, length));
+
+        // Quaternion of the shortest rotation from Z to the bone:
+        // (1 + Z . d, Z x d), its Z component is always 0. If the bone
+        // points to -Z every axis is the shortest, X is used.
+        w = _mm_add_ps(one, dz);
+        x = _mm_sub_ps(zero, dy);
+        y = dx;
+
+        mask = _mm_cmplt_ps(w, epsilon);
+        w = _mm_andnot_ps(mask, w);
+        x = select(mask, one, x);
+        y = _mm_andnot_ps(mask, y);
+
+        norm = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w),
+                                                 _mm_mul_ps(x, x)),
+                                      _mm_mul_ps(y, y)));
+        w = _mm_div_ps(w, norm);
+        x = _mm_div_ps(x, norm);
+        y = _mm_div_ps(y, norm);
+
+        // Columns of the rotation of the quaternion
+        column[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_mul_ps(y, y)));
+        column[0][1] = _mm_mul_ps(two, _mm_mul_ps(x, y));
+        column[0][2] = _mm_sub_ps(zero, _mm_mul_ps(two, _mm_mul_ps(w, y)));
+        column[0][3] = zero;
+
+        column[1][0] = column[0][1];
+        column[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_mul_ps(x, x)));
+        column[1][2] = _mm_mul_ps(two, _mm_mul_ps(w, x));
+        column[1][3] = zero;
+
+        column[2][0] = _mm_sub_ps(zero, column[0][2]);
+        column[2][1] = _mm_sub_ps(zero, column[1][2]);
+        column[2][2] = _mm_sub_ps(_mm_add_ps(column[0][0], column[1][1]), 
+                                  one);
+        column[2][3] = zero;
+
+        // From one vector by component to one matrix by bone
+        for (c = 0; c < 4; c++) {
+            _MM_TRANSPOSE4_PS(column[c][0], column[c][1], 
+                              column[c][2], column[c][3]);
+
+            for (k = 0; k < 4; k++) {
+                _mm_storeu_ps(&matrices[i + k][4 * c], column[c][k]);
+            }
+        }
+    }
+}
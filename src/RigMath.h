@@ -0,0 +1,99 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file RigMath.h
+ *
+ *  @brief Header file of the matrices of the characters.
+ *
+ *  This file contains the functions that build the matrices of the
+ *  parts of the characters on the CPU, in the order of OpenGL, so they
+ *  are loaded with one call instead of a chain of translations and
+ *  rotations in the matrix stack.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef RIG_MATH_H
+# define RIG_MATH_H
+
+# include "common.h"
+
+/**
+ *  Sets a matrix to the identity.
+ *  @param m the matrix.
+ */
+void identityMatrix(float *m);
+
+/**
+ *  Multiplies two matrices, like glMultMatrix: out = a * b.
+ *  @param a matrix on the left.
+ *  @param b matrix on the right.
+ *  @param out the product, it can not be a or b.
+ */
+void multiplyMatrix(const float *a, const float *b, float *out);
+
+/**
+ *  Multiplies a matrix by a translation, like glTranslate.
+ *  @param m the matrix.
+ *  @param x,y,z vector of the translation.
+ */
+void translateMatrix(float *m, float x, float y, float z);
+
+/**
+ *  Multiplies a matrix by a scale, like glScale.
+ *  @param m the matrix.
+ *  @param x,y,z factors of the scale.
+ */
+void scaleMatrix(float *m, float x, float y, float z);
+
+/**
+ *  Multiplies a matrix by a rotation, like glRotate.
+ *  @param m the matrix.
+ *  @param angle angle in degrees.
+ *  @param x,y,z axis of the rotation, it does not need to be unit.
+ */
+void rotateMatrix(float *m, float angle, float x, float y, float z);
+
+/**
+ *  Computes the matrices of some bones, four at a time. The matrix of a
+ *  bone moves the origin to its first point and turns the Z axis to
+ *  its second point, with the shortest rotation, built from a
+ *  quaternion. A bone with both points equal is only moved.
+ *  @param from coordinates of the first points, one array by axis.
+ *  @param to coordinates of the second points, one array by axis.
+ *  @param count number of bones. The arrays must have room for count
+ *  rounded up to a multiple of 4.
+ *  @param matrices the matrices of the bones, in the order of OpenGL.
+ *  @param lengths the lengths of the bones.
+ */
+void boneMatrices(const float * const from[3], 
+                  const float * const to[3], 
+                  int count, 
+                  float (*matrices)[16], 
+                  float *lengths);
+
+# endif
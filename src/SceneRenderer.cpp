@@ -41,9 +41,6 @@
  */
 SceneRenderer :: SceneRenderer ()
 {
-    sr_ImageGenerator = NULL;
-    sr_DepthGenerator = NULL;
-    sr_SceneAnalyzer  = NULL;
     sr_UserDetector   = NULL;
     sr_ZamusDetector  = NULL;
     sr_LinqDetector   = NULL;
@@ -53,30 +50,24 @@ SceneRenderer :: SceneRenderer ()
     zamusParts = ZamusModel();
     linqParts  = LinqModel();
     neutralModel = NeutralModel();
+    rigRenderer.changeModels(zamusParts, linqParts);
 }
 
 /**
  *  Constructor of the class.
  *
- *  This constructor get the image and the user generator.
+ *  This constructor get the user detector, the sensor data and
+ *  the camera image come in its frames.
  *
- *  @param igen an image generator pointer.
- *  @param dgen a depth generator pointer.
  *  @param ugen a user detector pointer.
  *  @param zamus a zamus detector pointer.
  *  @param linq a linq detector pointer.
  *
  */
-SceneRenderer :: SceneRenderer (ImageGenerator *igen,
-                                DepthGenerator *dgen,
-                                SceneAnalyzer  *sa,
-                                UserDetector *ugen,
+SceneRenderer :: SceneRenderer (UserDetector *ugen,
                                 Zamus *zamus,
                                 Linq  *linq)
 {
-    sr_ImageGenerator = igen;
-    sr_DepthGenerator = dgen;
-    sr_SceneAnalyzer  = sa;
     sr_UserDetector   = ugen;
     sr_ZamusDetector  = zamus;
     sr_LinqDetector   = linq;
@@ -85,7 +76,8 @@ SceneRenderer :: SceneRenderer (ImageGenerator *igen,
     drawUserPixels  = false;
     zamusParts = ZamusModel();
     linqParts  = LinqModel();
-    neutralModel = NeutralModel(ugen, zamusParts, linqParts);
+    neutralModel = NeutralModel(ugen);
+    rigRenderer.changeModels(zamusParts, linqParts);
 }
 
 /**
@@ -110,6 +102,25 @@ void SceneRenderer :: switchDrawUser ()
     drawUserPixels = !drawUserPixels;
 }
 
+/**
+ *  Indicates if the user pixels image is being drawn.
+ *  @return true if the user pixels are drawn.
+ */
+bool SceneRenderer :: retDrawUser ()
+{
+    return drawUserPixels;
+}
+
+/**
+ *  Indicates if the RGB image is being drawn, the camera image is only
+ *  captured by the sensor thread when this is true.
+ *  @return true if the RGB image is drawn.
+ */
+bool SceneRenderer :: retDrawImage ()
+{
+    return drawImagePixels;
+}
+
 /**
  *  Gets the type of model that will be apply to the player. 
  *
@@ -144,16 +155,15 @@ int SceneRenderer :: getUserListenerType (XnUserID player)
 /**
  *  The principal function of the class.
  *  This function execute all the openGL part of the program.
+ *  @param alpha part of a tick of the game since the last one, used to
+ *  draw the projectiles between two positions.
  */
-void SceneRenderer :: drawScene ()
+void SceneRenderer :: drawScene (float alpha)
 {
     // This variables are used to iterate.
     unsigned int i;
     unsigned int type;
 
-    XnUInt x;
-    XnUInt y;
-    
     // This fist two variables contain the image resolution.
     unsigned int xRes;
     unsigned int yRes;
@@ -162,24 +172,11 @@ void SceneRenderer :: drawScene ()
     unsigned int texResX;
     unsigned int texResY;
 
-    // This are the image and scene meta data.
-    ImageMetaData imd;
-    SceneMetaData smd;
-
-    // This pointer will point the resulting OpenGL texture.
-    XnRGB24Pixel* texMap;
-
-    // This two are used to iterate for the texture.
-    XnRGB24Pixel* texRow;
-    XnRGB24Pixel* texPixel;
+    // This is the current sensor frame.
+    const SensorFrame *frame;
 
-    // This are used to iterate through the image pixels.
-    const XnRGB24Pixel* imagePixel;
-    const XnRGB24Pixel* imageRow;
-
-    // This are used to iterate through the user labels.
-    const XnLabel* labelRow;
-    const XnLabel* label;
+    // This is the part of the image that is shown.
+    CropWindow window;
 
     // This is for the floor.
     XnPlane3D floor;
@@ -191,91 +188,54 @@ void SceneRenderer :: drawScene ()
     XnUserID usersIDs[MAX_USERS];
     XnUInt16 numUsers = MAX_USERS;
 
-    UserGenerator userGen;
-
-    userGen = sr_UserDetector -> retUserGenerator();
+    frame = sr_UserDetector -> retFrame();
 
-    if (drawUserPixels) {
-
-        // Start getting the image and scene metadata.
-        sr_UserDetector -> retUserGenerator().GetUserPixels(0, smd);
+    // Nothing to draw until the first frame arrives.
+    if (frame == NULL) {
+        return;
+    }
 
-        if (drawImagePixels) {
-            sr_ImageGenerator -> GetMetaData(imd);
-            imageRow = imd.RGB24Data();
-        }
+    // The label map is only in the frame when it was requested.
+    if (drawUserPixels && (frame -> labelXRes > 0)) {
 
         // Get the image resolution.
-        xRes = smd.XRes();
-        yRes = smd.YRes();
-
-        // Init the texture map
-        // OpenGL need the texture map to be a power of two.
-        texResX = (((unsigned short)(smd.FullXRes() - 1) / 512) + 1) * 512;
-        texResY = (((unsigned short)(smd.FullYRes() - 1) / 512) + 1) * 512;
-        texMap  = (XnRGB24Pixel*) malloc (texResX * 
-                                          texResY * 
-                                          sizeof(XnRGB24Pixel));
-        xnOSMemSet(texMap, 0, texResX * texResY * sizeof(XnRGB24Pixel));
-
-        // Get the data from labels and the image.
-        labelRow = smd.Data();
-
-        // Init the pointer to the texture map to start feeling it.
-        texRow   = texMap;
-
-        // Starts itarating through the rows of the image.
-        for (y = 0; y < yRes; y++) {
-            
-            if (drawImagePixels) {
-                imagePixel = imageRow;
-                imageRow += xRes;
-            }
-            texPixel   = texRow;
-            label      = labelRow;
-
-            for (x = 0; x < xRes; x++) {
-
-                if (drawImagePixels) {
-                    *texPixel = *imagePixel;
-                    imagePixel++;
-                }
-
-                if (*label != 0) {
-                    if (*label <= MAX_USERS) {
-                          texPixel -> nBlue = 200;
-                    }
-                }
-
-                // go to next pixel
-                texPixel++;
-                label++;
-
-            }
-            
-            // go to next row
-            labelRow += xRes;
-            texRow   += texResX;
+        xRes = frame -> labelXRes;
+        yRes = frame -> labelYRes;
+
+        // The texture is kept between frames, only the pixels of the
+        // frame are sent.
+        overlay.changeSize(frame -> labelFullXRes, frame -> labelFullYRes);
+
+        texResX = overlay.retTexResX();
+        texResY = overlay.retTexResY();
+
+        // The borders are cut while the pixels are copied.
+        window = cropWindow(xRes, yRes, texResX, texResY);
+
+        // The camera image comes in the same frame than the labels,
+        // when the sensor has one.
+        if (drawImagePixels && 
+            (frame -> imageXRes == xRes) && 
+            (frame -> imageYRes == yRes)) {
+
+            // The image with the users pixels in blue.
+            compositeUsers(&frame -> image[0], 
+                           &frame -> labels[0], 
+                           xRes, 
+                           window.left, 
+                           window.top, 
+                           window.width, 
+                           window.height,
+                           overlay.mapImage(window.width, window.height));
+
+            overlay.uploadImage();
+        }
+        else {
+            // The labels are colored by OpenGL.
+            overlay.uploadLabels(&frame -> labels[0], xRes, window);
         }
 
-
-        glTexParameteri( GL_TEXTURE_2D, GL_GENERATE_MIPMAP_SGIS, GL_TRUE );
-        glTexParameteri( GL_TEXTURE_2D, 
-                         GL_TEXTURE_MIN_FILTER, 
-                         GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri( GL_TEXTURE_2D, 
-                         GL_TEXTURE_MAG_FILTER, 
-                         GL_LINEAR);
-
-        glTexImage2D( GL_TEXTURE_2D, 
-                      0, 
-                      GL_RGB, 
-                      texResX, 
-                      texResY, 
-                      0, 
-                      GL_RGB, 
-                      GL_UNSIGNED_BYTE, 
-                      texMap);
+        overlay.bind();
 
         glColor4f(1,1,1,1);
 
@@ -285,31 +245,31 @@ void SceneRenderer :: drawScene ()
         glNormal3f(0.0, 0.0,-1.0);
 
         // upper left
-        glTexCoord2f(CROPLEFT, CROPUP);
+        glTexCoord2f(0, 0);
         glVertex2f(0, 0);
        
         // upper right
-        glTexCoord2f((float)xRes/(float)texResX + CROPRIGHT, CROPUP);
+        glTexCoord2f((float)window.width/(float)texResX, 0);
         glVertex2f(640, 0);
 
         // bottom right
-        glTexCoord2f((float)xRes/(float)texResX + CROPRIGHT,
-                     (float)yRes/(float)texResY + CROPDOWN);
+        glTexCoord2f((float)window.width/(float)texResX,
+                     (float)window.height/(float)texResY);
         glVertex2f(640, 480);
 
         // bottom left
-        glTexCoord2f(CROPLEFT, (float)yRes/(float)texResY + CROPDOWN);
+        glTexCoord2f(0, (float)window.height/(float)texResY);
         glVertex2f(0, 480);
 
         glEnd();
 
-    }
+        // The models have no texture.
+        glBindTexture(GL_TEXTURE_2D, 0);
 
-    sr_SceneAnalyzer -> GetFloor(floor);
+    }
 
-    sr_DepthGenerator -> ConvertRealWorldToProjective(1, 
-                                                      &floor.ptPoint, 
-                                                      &floor.ptPoint); 
+    floor = frame -> floor;
+    floor.ptPoint = frame -> floorProjective;
     yPos = floor.ptPoint.Y + 100;
 
     // Draw floor.
@@ -323,7 +283,7 @@ void SceneRenderer :: drawScene ()
         glVertex3f( 4000, yPos, 4000);
     glEnd();
 
-    userGen.GetUsers(usersIDs, numUsers);
+    sr_UserDetector -> getUsers(usersIDs, numUsers);
 
     for (i = 0; i < numUsers; i++) {
         
@@ -337,8 +297,11 @@ void SceneRenderer :: drawScene ()
             displayUserType(usersIDs[i], type);
         }
     }
-    drawZamusShoots();
-    drawIceSpawns();
+
+    // The characters of all the players at once
+    rigRenderer.draw();
+
+    drawProjectiles(alpha);
 }
 
 
@@ -358,873 +321,52 @@ void SceneRenderer :: displayUserType (XnUserID player, unsigned int type)
 
         case NEUTRAL_TYPE:
             stage = sr_UserDetector -> retStage(player);
-            neutralModel.drawNeutral(player);
+            neutralModel.drawNeutral(player, rigRenderer);
             break;
 
         case ZAMUS_TYPE:
-            drawZamus(player);
+            drawCharacter(player, g_ZamusRig);
             break;
 
         case LINQ_TYPE:
-            drawLinq (player);
+            drawCharacter(player, g_LinqRig);
             break;
 
         default:
-            neutralModel.drawNeutral(player);
+            neutralModel.drawNeutral(player, rigRenderer);
             break;
     }
 }
 
 
 /**
- *  Draw the Zamus model over the player.
- *  This function display the zamus model for the player if he
- *  is been tracked.
+ *  Draw a character over the player.
+ *  This function adds the model of a character for the
+ *  player to the renderer, they are all drawn after the players.
  *  @param player the ID of the player.
+ *  @param rig parts of the character.
  */
-void SceneRenderer :: drawZamus (XnUserID player)
-{
-    float ax;
-    Vector3D a;
-    Vector3D b;
-    Vector3D c;
-    Vector3D d;
-    Vector3D u;
-    Vector3D v;
-    Vector3D w;
-
-    GLuint mode;
-    UserGenerator      userGen;
-
-    XnPoint3D points[15];
-
-    // Skeleton Joints
-    XnSkeletonJointPosition headJoint;
-    XnSkeletonJointPosition neckJoint;
-    XnSkeletonJointPosition leftShoulderJoint;
-    XnSkeletonJointPosition rightShoulderJoint;
-    XnSkeletonJointPosition leftHipJoint;
-    XnSkeletonJointPosition rightHipJoint;
-    XnSkeletonJointPosition torsoJoint;
-    XnSkeletonJointPosition leftArmJoint;
-    XnSkeletonJointPosition rightArmJoint;
-    XnSkeletonJointPosition leftHandJoint;
-    XnSkeletonJointPosition rightHandJoint;
-    XnSkeletonJointPosition leftKneeJoint;
-    XnSkeletonJointPosition rightKneeJoint;
-    XnSkeletonJointPosition leftFootJoint;
-    XnSkeletonJointPosition rightFootJoint;
-
-    userGen = sr_UserDetector -> retUserGenerator();
-    SkeletonCapability skelCap = userGen.GetSkeletonCap();
-
-    mode =  GLM_SMOOTH | GLM_MATERIAL;
-
-    if (skelCap.IsTracking(player)) {
-
-    // GET SKELETON JOINT POSITIONS
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_HEAD,
-                                     headJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_NECK,
-                                     neckJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_LEFT_SHOULDER,
-                                     leftShoulderJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_RIGHT_SHOULDER,
-                                     rightShoulderJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_TORSO,
-                                     torsoJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_LEFT_ELBOW,
-                                     leftArmJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_RIGHT_ELBOW,
-                                     rightArmJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_LEFT_HAND,
-                                     leftHandJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_RIGHT_HAND,
-                                     rightHandJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_LEFT_HIP,
-                                     leftHipJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_RIGHT_HIP,
-                                     rightHipJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_LEFT_KNEE,
-                                     leftKneeJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_RIGHT_KNEE,
-                                     rightKneeJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_LEFT_FOOT,
-                                     leftFootJoint);
-    skelCap.GetSkeletonJointPosition(player, 
-                                     XN_SKEL_RIGHT_FOOT,
-                                     rightFootJoint);
-
-    points[0]  = headJoint.position;
-    points[1]  = neckJoint.position;
-    points[2]  = leftShoulderJoint.position;
-    points[3]  = rightShoulderJoint.position;
-    points[4]  = leftHipJoint.position;
-    points[5]  = rightHipJoint.position;
-    points[6]  = torsoJoint.position;
-    points[7]  = leftArmJoint.position;
-    points[8]  = rightArmJoint.position;
-    points[9]  = leftHandJoint.position;
-    points[10]  = rightHandJoint.position;
-    points[11]  = leftKneeJoint.position;
-    points[12] = rightKneeJoint.position;
-    points[13] = leftFootJoint.position;
-    points[14] = rightFootJoint.position;
-
-    sr_DepthGenerator -> ConvertRealWorldToProjective(15, 
-                                                      points, 
-                                                      points); 
-
-        a = Vector3D(points[5].X,points[5].Y,points[5].Z);
-        b = Vector3D(points[2].X,points[2].Y,points[2].Z);
-        c = Vector3D(points[4].X,points[4].Y,points[4].Z);
-        d = Vector3D(points[3].X,points[3].Y,points[3].Z);
-
-        u = a - b;
-        v = c - d;
-
-        w   = u.cross(v);
-        w.y = 0.0;
-        w.normalize();
-
-        ax = 57.2957795 * acos(w.z);
-
-        if (w.x <= 0.0) {
-            ax = -ax;
-        }
-
-
-    // DRAW ZAMUS HEAD
-
-    if ((headJoint.fConfidence >= 0.5) && (neckJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-
-            orientAxis(points[0],points[1]);
-            glScalef(400.0, 400.0, 400.0);
-            glTranslatef(0.0, -0.1, 0.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.head, mode); 
-
-        glPopMatrix();
-    }
-
-    // DRAW ZAMUS CHEST
-
-    if ((torsoJoint.fConfidence >= 0.5) && (neckJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-
-            orientAxis(points[1],points[6]);
-            glScalef(400.0, 400.0, 400.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glTranslatef(0.0, -0.1, 0.0);
-            glmDraw(zamusParts.chest, mode); 
-
-        glPopMatrix();
-    }
-
-    // DRAW ZAMUS SHOULDERS
-    
-    if ((leftShoulderJoint.fConfidence >= 0.5) && 
-        (rightShoulderJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-            glTranslatef(points[2].X, points[2].Y, points[2].Z);
-            glRotatef(-ax, 0.0,-2.0, 0.0);
-            glTranslatef(-30.0,-40.0, 0.0);
-            glScalef(500.0,-500.0, 500.0);
-            glmDraw(zamusParts.shoulder, mode); 
-
-        glPopMatrix();
-        glPushMatrix();
-            glTranslatef(points[3].X, points[3].Y, points[3].Z);
-            glRotatef(-ax, 0.0,-1.0, 0.0);
-            glTranslatef( 30.0,-40.0, 0.0);
-            glScalef(500.0,-500.0, 500.0);
-            glmDraw(zamusParts.shoulder, mode); 
-
-        glPopMatrix();
-
-    }
-
-    // DRAW ZAMUS LEFT ARM
-    
-    if ((rightArmJoint.fConfidence >= 0.5) && 
-        (rightHandJoint.fConfidence >= 0.5) &&
-        (rightShoulderJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-            orientAxis(points[3],points[8]);
-            glTranslatef( 0.0, 0.0, 50.0);
-            glScalef(500.0, 500.0, 500.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.arm, mode); 
-
-        glPopMatrix();
-        
-        glPushMatrix();
-            orientAxis(points[8],points[10]);
-            glTranslatef( 0.0, 0.0, 60.0);
-            glScalef(250.0, 250.0, 250.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(-ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.forearm, mode); 
-
-        glPopMatrix();
-        
-
-    }
-
-    // DRAW ZAMUS RIGHT ARM
-    
-    if ((leftArmJoint.fConfidence >= 0.5) && 
-        (leftHandJoint.fConfidence >= 0.5) &&
-        (leftShoulderJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-            orientAxis(points[2],points[7]);
-            glTranslatef( 0.0, 0.0, 50.0);
-            glScalef(500.0, 500.0, 500.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.arm, mode); 
-
-        glPopMatrix();
-        
-        glPushMatrix();
-            orientAxis(points[7],points[9]);
-            glTranslatef( 0.0, 0.0, 80.0);
-            glScalef(300.0, 300.0, 300.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(-ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.cannon, mode); 
-
-        glPopMatrix();
-        
-
-    }
-
-    // DRAW ZAMUS LEFT LEG
-    
-    if ((rightHipJoint.fConfidence >= 0.5) && 
-        (rightKneeJoint.fConfidence >= 0.5) &&
-        (rightFootJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-            orientAxis(points[5],points[12]);
-            glTranslatef( 0.0, 0.0, 50.0);
-            glScalef(250.0, 250.0, 250.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.thigh, mode); 
-
-        glPopMatrix();
-        
-        glPushMatrix();
-            orientAxis(points[12],points[14]);
-            glTranslatef( 0.0, 0.0, 50.0);
-            glScalef(100.0, 100.0, 100.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.leg, mode); 
-
-        glPopMatrix();
-        
-
-    }
-
-    // DRAW ZAMUS RIGHT LEG
-    
-    if ((leftHipJoint.fConfidence >= 0.5) && 
-        (leftKneeJoint.fConfidence >= 0.5) &&
-        (leftFootJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-            orientAxis(points[4],points[11]);
-            glTranslatef( 0.0, 0.0, 50.0);
-            glScalef(-250.0, 250.0, 250.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(-ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.thigh, mode); 
-
-        glPopMatrix();
-        
-        glPushMatrix();
-            orientAxis(points[11],points[13]);
-            glTranslatef( 0.0, 0.0, 50.0);
-            glScalef(-100.0, 100.0, 100.0);
-            glRotatef(90, -1.0, 0.0, 0.0);
-            glRotatef(-ax, 0.0,-1.0, 0.0);
-            glmDraw(zamusParts.leg, mode); 
-
-        glPopMatrix();
-        
-
-    }
-
-    // DRAW ZAMUS RIGHT FOOT
-    
-    if ((leftFootJoint.fConfidence >= 0.5) && 
-        (rightFootJoint.fConfidence >= 0.5)) {
-
-        glPushMatrix();
-            glTranslatef( points[13].X, points[13].Y, points[13].Z);
-            glScalef(40.0,-40.0,-40.0);
-            glRotatef(ax, 0.0,-1.0, 0.0);
-            glTranslatef(0.0,-0.25, 0.5);
-            glmDraw(zamusParts.foot, mode); 
-
-        glPopMatrix();
-        
-        glPushMatrix();
-            glTranslatef( points[14].X, points[14].Y, points[14].Z);
-            glScalef(-40.0,-40.0,-40.0);
-            glRotatef(-ax, 0.0,-1.0, 0.0);
-            glTranslatef(0.0,-0.25, 0.5);
-            glmDraw(zamusParts.foot, mode); 
-
-        glPopMatrix();
-        
-
-    }
-
-    }
-    
-}
-
-/**
- *  Draw the Zamus shoots.
- *  This function draws all the zamus shoots maded by the player
- *  that are in the Zamus detector.
- */
-void SceneRenderer :: drawZamusShoots ()
-{
-    int i;
-    int nShoots;
-    vector <ZamusShoot > shoots;
-
-    shoots = sr_ZamusDetector -> shoots;
-
-    for (i = 0; i < shoots.size(); i++) {
-        shoots[i].nextPosition();
-        if (shoots[i].isAlive()) {
-            shoots[i].drawShoot();
-        }
-        else {
-            shoots.erase(shoots.begin() + i);
-            i--;
-        }
-    }
-
-    sr_ZamusDetector -> shoots = shoots;
-}
-
-/**
- *  Draw the Zamus shoots.
- *  This function draws all the zamus shoots maded by the player
- *  that are in the Zamus detector.
- */
-void SceneRenderer :: drawIceSpawns ()
-{
-    int i;
-    int nShoots;
-    vector <LinqSpawnIce> ices;
-
-    ices = sr_LinqDetector -> iceSpawn;
-
-    for (i = 0; i < ices.size(); i++) {
-        ices[i].nextPosition();
-        if (ices[i].isAlive()) {
-            ices[i].drawSpawnIce();
-        }
-        else {
-            ices.erase(ices.begin() + i);
-            i--;
-        }
-    }
-
-    sr_LinqDetector -> iceSpawn = ices;
-}
-
-/**
- *  Modify the modeling matrix of OpenGL positioning the center
- *  in the point one and orienting the Y axis to the point two.
- *  @param point1 the point where the matrix will be center.
- *  @param point2 the point where the Y axis will go.
- */
-void SceneRenderer :: orientAxis (XnPoint3D& p1,XnPoint3D& p2)
+void SceneRenderer :: drawCharacter (XnUserID player, const CharacterRig &rig)
 {
-    Vector3D v1;
-    Vector3D v2;
-    Vector3D v3;
-
-    float zero;
-    float ax;
-    float rx;
-    float ry;
-
-    float limpLength;
-
-    v1 = Vector3D (p1.X, p1.Y, p1.Z);
-    v2 = Vector3D (p2.X, p2.Y, p2.Z);
-
-    v3 = v2 - v1;
-
-    limpLength = v3.magnitude();
-
-    zero = 1.0e-3;
-
-    if (fabs(v3.z) < zero) {
-        ax = 57.2957795 * acos(v3.x / limpLength);
-    
-        if (v3.x <= 0.0) {
-            ax = -ax;
-        }
-    }
-    else {
-    
-        ax = 57.2957795 * acos(v3.z / limpLength);
-
-        if (v3.z <= 0.0) {
-            ax = -ax;
-        }
-
-        rx = -v3.y * v3.z;
-        ry = v3.x * v3.z;
-
-        glTranslatef(p1.X, p1.Y, p1.Z);
-
-
-        if (fabs(v3.z) < zero) {
-
-            glRotated(90.0, 0, 1, 0.0);
-            glRotated(ax, -1.0, 0.0, 0.0); 
-
-        }
-        else {
-
-            glRotated(ax, rx, ry, 0.0);
+    const SnapshotJoint *skeleton;
 
-        }
+    skeleton = sr_UserDetector -> retSkeleton(player);
 
+    if (skeleton != NULL) {
+        rigRenderer.add(rig, skeleton, 0);
     }
 }
 
 /**
- *  Draw the Linq model over the player.
- *  This function display the linq model for the player if he
- *  is been tracked.
- *  @param player the ID of the player.
+ *  Draw the projectiles.
+ *  This function draws all the water shoots and ices maded by the
+ *  players, Zamus and Linq share the projectiles. They are moved by
+ *  the simulation, here they are only read.
+ *  @param alpha part of a tick since the last one.
  */
-void SceneRenderer :: drawLinq (XnUserID player)
+void SceneRenderer :: drawProjectiles (float alpha)
 {
-    float ax;
-    Vector3D a;
-    Vector3D b;
-    Vector3D c;
-    Vector3D d;
-    Vector3D u;
-    Vector3D v;
-    Vector3D w;
-    Vector3D n;
-
-    GLuint mode;
-    UserGenerator      userGen;
-
-    XnPoint3D points[15];
-    XnPoint3D staffDirection;
-    XnPoint3D shieldDirection;
-    XnPoint3D shieldPosition;
-
-    // Skeleton Joints
-    XnSkeletonJointPosition headJoint;
-    XnSkeletonJointPosition neckJoint;
-    XnSkeletonJointPosition leftShoulderJoint;
-    XnSkeletonJointPosition rightShoulderJoint;
-    XnSkeletonJointPosition leftHipJoint;
-    XnSkeletonJointPosition rightHipJoint;
-    XnSkeletonJointPosition torsoJoint;
-    XnSkeletonJointPosition leftArmJoint;
-    XnSkeletonJointPosition rightArmJoint;
-    XnSkeletonJointPosition leftHandJoint;
-    XnSkeletonJointPosition rightHandJoint;
-    XnSkeletonJointPosition leftKneeJoint;
-    XnSkeletonJointPosition rightKneeJoint;
-    XnSkeletonJointPosition leftFootJoint;
-    XnSkeletonJointPosition rightFootJoint;
-
-    userGen = sr_UserDetector -> retUserGenerator();
-    SkeletonCapability skelCap = userGen.GetSkeletonCap();
-
-    mode =  GLM_SMOOTH | GLM_MATERIAL;
-
-    if (skelCap.IsTracking(player)) {
-
-        // GET SKELETON JOINT POSITIONS
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_HEAD,
-                                         headJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_NECK,
-                                         neckJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_LEFT_SHOULDER,
-                                         leftShoulderJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_RIGHT_SHOULDER,
-                                         rightShoulderJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_TORSO,
-                                         torsoJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_LEFT_ELBOW,
-                                         leftArmJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_RIGHT_ELBOW,
-                                         rightArmJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_LEFT_HAND,
-                                         leftHandJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_RIGHT_HAND,
-                                         rightHandJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_LEFT_HIP,
-                                         leftHipJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_RIGHT_HIP,
-                                         rightHipJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_LEFT_KNEE,
-                                         leftKneeJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_RIGHT_KNEE,
-                                         rightKneeJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_LEFT_FOOT,
-                                         leftFootJoint);
-        skelCap.GetSkeletonJointPosition(player, 
-                                         XN_SKEL_RIGHT_FOOT,
-                                         rightFootJoint);
-
-        points[0]  = headJoint.position;
-        points[1]  = neckJoint.position;
-        points[2]  = leftShoulderJoint.position;
-        points[3]  = rightShoulderJoint.position;
-        points[4]  = leftHipJoint.position;
-        points[5]  = rightHipJoint.position;
-        points[6]  = torsoJoint.position;
-        points[7]  = leftArmJoint.position;
-        points[8]  = rightArmJoint.position;
-        points[9]  = leftHandJoint.position;
-        points[10]  = rightHandJoint.position;
-        points[11]  = leftKneeJoint.position;
-        points[12] = rightKneeJoint.position;
-        points[13] = leftFootJoint.position;
-        points[14] = rightFootJoint.position;
-
-        sr_DepthGenerator -> ConvertRealWorldToProjective(15, 
-                                                          points, 
-                                                          points); 
-
-            a = Vector3D(points[5].X,points[5].Y,points[5].Z);
-            b = Vector3D(points[2].X,points[2].Y,points[2].Z);
-            c = Vector3D(points[4].X,points[4].Y,points[4].Z);
-            d = Vector3D(points[3].X,points[3].Y,points[3].Z);
-
-            u = a - b;
-            v = c - d;
-
-            w   = u.cross(v);
-            w.y = 0.0;
-            w.normalize();
-
-            ax = 57.2957795 * acos(w.z);
-
-            if (w.x <= 0.0) {
-                ax = -ax;
-            }
-
-        //Calculate staff direction
-        v = Vector3D(points[7], points[9]);
-        u = Vector3D(points[2], points[7]);
-
-        w = v.cross(u);
-        n = v.cross(w);
-
-        staffDirection.X = points[9].X;
-        staffDirection.Y = n.y + points[9].Y;
-        staffDirection.Z = n.z + points[9].Z;
-
-        //Calculate shield direction
-        v = Vector3D(points[8], points[10]);
-        u = Vector3D(points[3], points[8]);
-
-        w = v.cross(u);
-
-        shieldDirection.X = w.x + points[8].X;
-        shieldDirection.Y = w.y + points[8].Y;
-        shieldDirection.Z = w.z + points[8].Z;
-
-        w.normalize();
-        shieldPosition.X = points[8].X + (w.x * 30);
-        shieldPosition.Y = points[8].Y + (w.y * 30);
-        shieldPosition.Z = points[8].Z + (w.z * 30);
-
-        // DRAW LINQ HEAD
-
-        if ((headJoint.fConfidence >= 0.5) && (neckJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-
-                orientAxis(points[0],points[1]);
-                glScalef(450.0, 450.0, 450.0);
-                glTranslatef(0.0, -0.1, 0.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.head, mode); 
-
-            glPopMatrix();
-        }
-
-        // DRAW LINQ CHEST
+    const ProjectileSystem *projectiles = sr_ZamusDetector -> projectiles;
 
-        if ((torsoJoint.fConfidence >= 0.5) && (neckJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-
-                orientAxis(points[1],points[6]);
-                glScalef(300.0, 300.0, 300.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glTranslatef(0.0, -0.2, 0.0);
-                glmDraw(linqParts.chest, mode); 
-
-            glPopMatrix();
-        }
-
-        // DRAW LINQ SHOULDERS
-        
-        if ((leftShoulderJoint.fConfidence >= 0.5) && 
-            (rightShoulderJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-                glTranslatef(points[2].X, points[2].Y, points[2].Z);
-                glRotatef(-ax, 0.0,-2.0, 0.0);
-                glScalef(500.0,-500.0, 500.0);
-                glmDraw(linqParts.shoulder, mode); 
-
-            glPopMatrix();
-            glPushMatrix();
-                glTranslatef(points[3].X, points[3].Y, points[3].Z);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glScalef(500.0,-500.0, 500.0);
-                glmDraw(linqParts.shoulder, mode); 
-
-            glPopMatrix();
-
-        }
-
-        // DRAW LINQ LEFT ARM
-        
-        if ((rightShoulderJoint.fConfidence >= 0.5) && 
-            (rightArmJoint.fConfidence >= 0.5) && 
-            (rightHandJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-                orientAxis(points[3],points[8]);
-                glTranslatef( 0.0, 0.0, 50.0);
-                glScalef(350.0, 350.0, 350.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.arm, mode); 
-
-            glPopMatrix();
-            
-            glPushMatrix();
-                orientAxis(points[8],points[10]);
-                glTranslatef( 0.0, 0.0, 60.0);
-                glScalef(250.0, 250.0, 250.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.forearm, mode); 
-
-            glPopMatrix();
-            
-
-        }
-
-        // DRAW LINQ RIGHT ARM
-        
-        if ((leftShoulderJoint.fConfidence >= 0.5) && 
-            (leftArmJoint.fConfidence >= 0.5) &&
-            (leftHandJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-                orientAxis(points[2],points[7]);
-                glTranslatef( 0.0, 0.0, 50.0);
-                glScalef(350.0, 350.0, 350.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.arm, mode); 
-
-            glPopMatrix();
-            
-            glPushMatrix();
-                orientAxis(points[7],points[9]);
-                glTranslatef( 0.0, 0.0, 60.0);
-                glScalef(-250.0, 250.0, 250.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.forearm, mode); 
-
-            glPopMatrix();
-            
-
-        }
-
-        // DRAW LINQ SHIELD
-        if (leftHandJoint.fConfidence >= 0.5) {
-             
-            glPushMatrix();
-                orientAxis(shieldPosition,shieldDirection);
-                //glTranslatef( 0.0, 0.0,-50.0);
-                glScalef(300.0, 300.0, 300.0);
-                glRotatef(90, 0.0, 1.0, 0.0);
-                glRotatef(180, 1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.shield, mode); 
-            glPopMatrix();
-        
-        }
-
-        // DRAW LINQ ICE STAFF
-        if (leftHandJoint.fConfidence >= 0.5) {
-             
-            glPushMatrix();
-                orientAxis(points[9],staffDirection);
-                glTranslatef( 0.0, 0.0,-50.0);
-                glScalef(250.0, 250.0, 250.0);
-                glRotatef(-90, -1.0, 0.0, 0.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.staff, mode); 
-            glPopMatrix();
-        
-        }
-    /*
-        // DRAW LINQ ICE STAFF
-        if (leftHandJoint.fConfidence >= 0.5) {
-             
-            glPushMatrix();
-                orientAxis(points[9],staffDirection);
-                glTranslatef( 0.0, 0.0, 150.0);
-                glScalef(350.0, 350.0, 350.0);
-                glRotatef(-90, -1.0, 0.0, 0.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.sword, mode); 
-            glPopMatrix();
-        
-        }
-    */
-        // DRAW LINQ LEFT LEG
-        
-        if ((rightHipJoint.fConfidence >= 0.5) && 
-            (rightKneeJoint.fConfidence >= 0.5) &&
-            (rightFootJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-                orientAxis(points[5],points[12]);
-                glTranslatef( 0.0, 0.0, 50.0);
-                glScalef(180.0, 180.0, 180.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.thigh, mode); 
-
-            glPopMatrix();
-            
-            glPushMatrix();
-                orientAxis(points[12],points[14]);
-                glTranslatef( 0.0, 0.0, 50.0);
-                glScalef(80.0,80.0, 80.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.leg, mode); 
-
-            glPopMatrix();
-            
-
-        }
-
-        // DRAW LINQ RIGHT LEG
-        
-        if ((leftHipJoint.fConfidence >= 0.5) && 
-            (leftKneeJoint.fConfidence >= 0.5) &&
-            (leftFootJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-                orientAxis(points[4],points[11]);
-                glTranslatef( 0.0, 0.0, 50.0);
-                glScalef(-180.0, 180.0, 180.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.thigh, mode); 
-
-            glPopMatrix();
-            
-            glPushMatrix();
-                orientAxis(points[11],points[13]);
-                glTranslatef( 0.0, 0.0, 50.0);
-                glScalef(-80.0, 80.0, 80.0);
-                glRotatef(90, -1.0, 0.0, 0.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glmDraw(linqParts.leg, mode); 
-
-            glPopMatrix();
-            
-
-        }
-
-        // DRAW LINQ RIGHT FOOT
-        
-        if ((rightFootJoint.fConfidence >= 0.5) && 
-            (leftFootJoint.fConfidence >= 0.5)) {
-
-            glPushMatrix();
-                glTranslatef( points[13].X, points[13].Y, points[13].Z);
-                glScalef(40.0,-40.0,-40.0);
-                glRotatef(ax, 0.0,-1.0, 0.0);
-                glTranslatef(0.0,-0.25, 0.5);
-                glmDraw(linqParts.foot, mode); 
-
-            glPopMatrix();
-            
-            glPushMatrix();
-                glTranslatef( points[14].X, points[14].Y, points[14].Z);
-                glScalef(-40.0,-40.0,-40.0);
-                glRotatef(-ax, 0.0,-1.0, 0.0);
-                glTranslatef(0.0,-0.25, 0.5);
-                glmDraw(linqParts.foot, mode); 
-
-            glPopMatrix();
-
-        }
-    }
+    projectiles -> draw(alpha);
 }
@@ -42,11 +42,15 @@
 
 # include "../glm/include/glm.h"
 # include "NeutralModel.h"
+# include "CharacterRig.h"
+# include "Compositor.h"
+# include "OverlayTexture.h"
 # include "ZamusModel.h"
 # include "LinqModel.h"
-# include "ZamusShoot.h"
+# include "ProjectileSystem.h"
 # include "UserDetector.h"
 # include "UserListener.h"
+# include "SensorFrame.h"
 # include "Zamus.h"
 # include "Linq.h"
 
@@ -77,19 +81,15 @@ class SceneRenderer
         /**
          *  Constructor of the class.
          *
-         *  This constructor get the image and the user generator.
+         *  This constructor get the user detector, the sensor data
+         *  and the camera image come in its frames.
          *
-         *  @param igen an image generator pointer.
-         *  @param dgen a depth generator pointer.
          *  @param ugen a user detector pointer.
          *  @param zamus a zamus detector pointer.
          *  @param linq a linq detector pointer.
          *
          */
-        SceneRenderer(ImageGenerator *igen, 
-                      DepthGenerator *dgen, 
-                      SceneAnalyzer *sa,
-                      UserDetector *ugen,
+        SceneRenderer(UserDetector *ugen,
                       Zamus *zamus,
                       Linq  *linq);
 
@@ -101,8 +101,10 @@ class SceneRenderer
         /**
          *  The principal function of the class.
          *  This function execute all the openGL part of the program.
+         *  @param alpha part of a tick of the game since the last one,
+         *  used to draw the projectiles between two positions.
          */
-        void drawScene();
+        void drawScene(float alpha);
 
         /**
          *  This function activate or deactivate the RGB image drawing.
@@ -120,6 +122,21 @@ class SceneRenderer
          */
         void switchDrawUser ();
 
+        /**
+         *  Indicates if the user pixels image is being drawn, the
+         *  label map is only captured by the sensor thread when this
+         *  is true.
+         *  @return true if the user pixels are drawn.
+         */
+        bool retDrawUser ();
+
+        /**
+         *  Indicates if the RGB image is being drawn, the camera image
+         *  is only captured by the sensor thread when this is true.
+         *  @return true if the RGB image is drawn.
+         */
+        bool retDrawImage ();
+
     private:
 
         /**
@@ -143,26 +160,6 @@ class SceneRenderer
          */
         XnRGB24Pixel *texMap;
 
-        /**
-         *  Image generator pointer.
-         *  This points to the image generator created in the context.
-         */
-        ImageGenerator *sr_ImageGenerator;
-
-        /**
-         *  Depth generator pointer.
-         *  This points to the depth generator created in the context.
-         *  This class needs this generator because of the convertion to
-         *  real world coordinate with OpenNI to draw the objects.
-         */
-        DepthGenerator *sr_DepthGenerator;
-
-        /**
-         *  Scene Analyzer pointer.
-         *  This object is needed to get que floor of the scene.
-         */
-        SceneAnalyzer *sr_SceneAnalyzer;
-
         /**
          *  User detector pointer.
          *  This user detector contain all the information abount the
@@ -215,6 +212,19 @@ class SceneRenderer
          */
         LinqModel linqParts;
 
+        /**
+         *  Renderer of the characters.
+         *  It draws Zamus, Linq and the stick figures from their tables
+         *  of parts, all the players of a frame together.
+         */
+        RigRenderer rigRenderer;
+
+        /**
+         *  Texture of the users pixels.
+         *  It is kept between frames and drawn under the scene.
+         */
+        OverlayTexture overlay;
+
         /**
          *  Gets the type of model that will be apply to the player. 
          *
@@ -239,42 +249,22 @@ class SceneRenderer
         void displayUserType (XnUserID player, unsigned int type);
 
         /**
-         *  Draw the Zamus model over the player.
-         *  This function display the zamus model for the player if he
-         *  is been tracked.
+         *  Draw a character over the player.
+         *  This function adds the model of a character for the
+         *  player to the renderer, they are all drawn after the players.
          *  @param player the ID of the player.
+         *  @param rig parts of the character.
          */
-        void drawZamus (XnUserID player);
-
-        /**
-         *  Draw the Zamus shoots.
-         *  This function draws all the zamus shoots maded by the player
-         *  that are in the Zamus detector.
-         */
-        void drawZamusShoots();
-
-        /**
-         *  Draw the Linq model over the player.
-         *  This function display the linq model for the player if he
-         *  is been tracked.
-         *  @param player the ID of the player.
-         */
-        void drawLinq (XnUserID player);
-
-        /**
-         *  Draw the Zamus shoots.
-         *  This function draws all the zamus shoots maded by the player
-         *  that are in the Zamus detector.
-         */
-        void drawIceSpawns();
+        void drawCharacter (XnUserID player, const CharacterRig &rig);
 
         /**
-         *  Modify the modeling matrix of OpenGL positioning the center
-         *  in the point one and orienting the Y axis to the point two.
-         *  @param point1 the point where the matrix will be center.
-         *  @param point2 the point where the Y axis will go.
+         *  Draw the projectiles.
+         *  This function draws all the water shoots and ices maded by
+         *  the players, Zamus and Linq share the projectiles. They are
+         *  moved by the simulation, here they are only read.
+         *  @param alpha part of a tick since the last one.
          */
-        void orientAxis (XnPoint3D& point1, XnPoint3D& point2);
+        void drawProjectiles(float alpha);
 
 };
 
@@ -0,0 +1,78 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SensorBackend.cpp
+ *
+ *  @brief Implementation of the default methods of SensorBackend.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "SensorBackend.h"
+
+/**
+ *  Indicates if the frames come from a live sensor. The frames
+ *  of a live sensor are paced by the sensor itself, the others
+ *  are produced as fast as they are read.
+ *  @return true if the backend is a live sensor.
+ */
+bool SensorBackend :: isLive ()
+{
+    return false;
+}
+
+
+/**
+ *  Converts points from real world to projective coordinates.
+ *  By default it uses a pinhole camera like the depth camera
+ *  of the Kinect.
+ *  @param count number of points.
+ *  @param real points in real world coordinates.
+ *  @param projective where the projective points will be
+ *  stored, it can be the same array of real.
+ */
+void SensorBackend :: convertRealWorldToProjective (XnUInt32 count,
+                                                    const XnPoint3D *real,
+                                                    XnPoint3D *projective)
+{
+    XnUInt32 i;
+    XnPoint3D point;
+
+    for (i = 0; i < count; i++) {
+        point = real[i];
+
+        // Points without depth stay where they are
+        if (point.Z == 0) {
+            projective[i] = point;
+            continue;
+        }
+
+        projective[i].X = 320.0 + point.X * DEPTH_FOCAL_LENGTH / point.Z;
+        projective[i].Y = 240.0 - point.Y * DEPTH_FOCAL_LENGTH / point.Z;
+        projective[i].Z = point.Z;
+    }
+}
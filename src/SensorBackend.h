@@ -0,0 +1,130 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SensorBackend.h
+ *
+ *  @brief Header file for the interface SensorBackend.
+ *
+ *  This file contains the definition of the sources of sensor frames:
+ *  the Kinect through OpenNI, scripted players and recordings.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SENSOR_BACKEND_H
+# define SENSOR_BACKEND_H
+
+# include "common.h"
+# include "SensorFrame.h"
+
+/**
+ *  Focal length in pixels of the 640x480 depth map of the Kinect.
+ */
+# define DEPTH_FOCAL_LENGTH 525.0
+
+/**
+ *  @class SensorBackend
+ *
+ *  @brief Interface of the sources of sensor frames.
+ *
+ *  A backend fills a SensorFrame with the users, their joints, the
+ *  floor plane and, when it is asked, the label map and the camera
+ *  image. The game only sees the frames, so the backends can be
+ *  swapped to play with the Kinect, to replay a session or to run the
+ *  game without sensor.
+ *
+ *  @see SensorThread
+ *  @see GameSimulation
+ */
+class SensorBackend
+{
+    public:
+
+        /**
+         *  Class destructor.
+         */
+        virtual ~SensorBackend() {}
+
+        /**
+         *  Indicates if the frames come from a live sensor. The frames
+         *  of a live sensor are paced by the sensor itself, the others
+         *  are produced as fast as they are read.
+         *  @return true if the backend is a live sensor.
+         */
+        virtual bool isLive();
+
+        /**
+         *  Fills the next frame of the backend. A live sensor waits
+         *  for its next update.
+         *  @param frame where the frame will be stored.
+         *  @param labels true to copy the label map into the frame.
+         *  @param image true to copy the camera image into the frame,
+         *  if the backend has one.
+         *  @return false if the backend has no more frames.
+         */
+        virtual bool readFrame(SensorFrame& frame, 
+                               bool labels, 
+                               bool image) = 0;
+
+        /**
+         *  Converts points from real world to projective coordinates.
+         *  By default it uses a pinhole camera like the depth camera
+         *  of the Kinect.
+         *  @param count number of points.
+         *  @param real points in real world coordinates.
+         *  @param projective where the projective points will be
+         *  stored, it can be the same array of real.
+         */
+        virtual void convertRealWorldToProjective(XnUInt32 count,
+                                                  const XnPoint3D *real,
+                                                  XnPoint3D *projective);
+
+        /**
+         *  Indicates when to stop the detection of new users, it must
+         *  stop once the game is started.
+         *  @param value true to stop the detection.
+         */
+        virtual void changeStopDetection(bool value) {}
+
+        /**
+         *  Stops the generation of frames.
+         */
+        virtual void stopGenerating() {}
+
+        /**
+         *  Starts the backend again from its first frame.
+         */
+        virtual void rewind() {}
+
+        /**
+         *  Tells the backend that the game is over and a new game is
+         *  going to start. By default the backend just goes on.
+         */
+        virtual void gameOver() {}
+};
+
+# endif
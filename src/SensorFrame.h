@@ -0,0 +1,171 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file SensorFrame.h
+ *
+ *  @brief Header file for the sensor frame structures.
+ *
+ *  This file contains the structures that hold a complete copy of the
+ *  sensor state for one frame. They are filled by the capture thread
+ *  and read by the game loop.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SENSOR_FRAME_H
+# define SENSOR_FRAME_H
+
+# include "common.h"
+# include "config.h"
+# include "SkeletonSnapshot.h"
+
+/**
+ *  @class SensorUser
+ *
+ *  @brief Copy of the sensor state of one user.
+ */
+class SensorUser
+{
+    public:
+
+        /**
+         *  ID of the user.
+         */
+        XnUserID id;
+
+        /**
+         *  Indicates if the skeleton of the user is being tracked.
+         */
+        bool tracking;
+
+        /**
+         *  Center of mass of the user (real world).
+         */
+        XnPoint3D com;
+
+        /**
+         *  Center of mass of the user (projective).
+         */
+        XnPoint3D comProjective;
+};
+
+/**
+ *  @class SensorFrame
+ *
+ *  @brief Copy of all the sensor data the game needs for one frame.
+ *
+ *  @see SensorThread
+ */
+class SensorFrame
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        SensorFrame()
+        {
+            frameID   = 0;
+            timestamp = 0;
+            numUsers  = 0;
+            labelXRes = 0;
+            labelYRes = 0;
+            labelFullXRes = 0;
+            labelFullYRes = 0;
+            imageXRes = 0;
+            imageYRes = 0;
+            memset(&floor, 0, sizeof(floor));
+            memset(&floorProjective, 0, sizeof(floorProjective));
+        }
+
+        /**
+         *  Frame ID given by the depth generator.
+         */
+        XnUInt32 frameID;
+
+        /**
+         *  Time of the frame in microseconds.
+         */
+        XnUInt64 timestamp;
+
+        /**
+         *  Number of users in the frame.
+         */
+        int numUsers;
+
+        /**
+         *  Users in the frame.
+         */
+        SensorUser users[MAX_USERS];
+
+        /**
+         *  Skeletons of the users, the slots are the same of users.
+         *  Only valid for the users that are being tracked.
+         */
+        SkeletonSnapshot skeletons;
+
+        /**
+         *  Floor plane (real world).
+         */
+        XnPlane3D floor;
+
+        /**
+         *  Point of the floor plane (projective).
+         */
+        XnPoint3D floorProjective;
+
+        /**
+         *  Resolution of the label map, zero if it was not captured.
+         */
+        XnUInt32 labelXRes;
+        XnUInt32 labelYRes;
+
+        /**
+         *  Full resolution of the label map.
+         */
+        XnUInt32 labelFullXRes;
+        XnUInt32 labelFullYRes;
+
+        /**
+         *  User label map, only captured when requested.
+         */
+        vector <XnLabel> labels;
+
+        /**
+         *  Resolution of the camera image, zero if it was not
+         *  captured.
+         */
+        XnUInt32 imageXRes;
+        XnUInt32 imageYRes;
+
+        /**
+         *  Camera image, seen from the point of view of the depth map
+         *  so it matches the label map. Only captured when requested.
+         */
+        vector <XnRGB24Pixel> image;
+};
+
+# endif
@@ -0,0 +1,202 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file SensorThread.cpp
+ *
+ *  @brief Implementation file for the class SensorThread.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class SensorThread.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include <unistd.h>
+
+# include "SensorThread.h"
+
+/**
+ *  Constructor of the class.
+ */
+SensorThread :: SensorThread()
+{
+    backend        = NULL;
+    started        = false;
+    quit           = false;
+    stopRequested  = false;
+    captureLabels  = false;
+    captureImage   = false;
+}
+
+/**
+ *  Constructor of the class.
+ *  @param sensor pointer to the sensor backend.
+ */
+SensorThread :: SensorThread(SensorBackend *sensor)
+{
+    backend        = sensor;
+    started        = false;
+    quit           = false;
+    stopRequested  = false;
+    captureLabels  = false;
+    captureImage   = false;
+}
+
+/**
+ *  Starts the acquisition thread.
+ */
+void SensorThread :: start()
+{
+    if (started) {
+        return;
+    }
+
+    quit = false;
+
+    if (pthread_create(&thread, NULL, run, this) != 0) {
+        reportError("Could not create the sensor thread\n");
+    }
+
+    started = true;
+}
+
+/**
+ *  Stops the acquisition thread and waits for it to finish.
+ */
+void SensorThread :: stop()
+{
+    if (!started) {
+        return;
+    }
+
+    quit = true;
+    pthread_join(thread, NULL);
+    started = false;
+}
+
+/**
+ *  Asks the acquisition thread to stop the generation of the
+ *  sensor backend.
+ */
+void SensorThread :: stopGenerating()
+{
+    stopRequested = true;
+}
+
+/**
+ *  Indicates if the label map must be copied into the frames.
+ *  @param value true to capture the label map.
+ */
+void SensorThread :: changeCaptureLabels(bool value)
+{
+    captureLabels = value;
+}
+
+/**
+ *  Indicates if the camera image must be copied into the frames.
+ *  @param value true to capture the camera image.
+ */
+void SensorThread :: changeCaptureImage(bool value)
+{
+    captureImage = value;
+}
+
+/**
+ *  Takes the newest complete frame if there is a new one. This
+ *  function never blocks.
+ *  @return true if a new frame was taken.
+ */
+bool SensorThread :: update()
+{
+    return frames.update();
+}
+
+/**
+ *  Returns the last frame taken by update().
+ *  @return current frame.
+ */
+const SensorFrame& SensorThread :: retFrame()
+{
+    return frames.readBuffer();
+}
+
+/**
+ *  Entry point of the thread.
+ *  @param sensorThread pointer to the SensorThread object.
+ */
+void* SensorThread :: run(void *sensorThread)
+{
+    static_cast<SensorThread *>(sensorThread) -> loop();
+    return NULL;
+}
+
+/**
+ *  Acquisition loop.
+ */
+void SensorThread :: loop()
+{
+    bool generating;
+    XnUInt64 lastTimestamp;
+    XnUInt64 delta;
+
+    generating = true;
+    lastTimestamp = 0;
+
+    while (!quit) {
+
+        if (stopRequested && generating) {
+            backend -> stopGenerating();
+            generating = false;
+        }
+
+        // Nothing else to read once the generation is stopped.
+        if (!generating) {
+            usleep(10000);
+            continue;
+        }
+
+        // The callbacks of a live backend are called inside this read.
+        if (!backend -> readFrame(frames.writeBuffer(), 
+                                  captureLabels, 
+                                  captureImage)) {
+            backend -> stopGenerating();
+            generating = false;
+            continue;
+        }
+
+        // The other backends are paced with the timestamps (usec).
+        if (!backend -> isLive()) {
+            delta = frames.writeBuffer().timestamp - lastTimestamp;
+            lastTimestamp = frames.writeBuffer().timestamp;
+
+            if (delta > 0 && delta < 1000000) {
+                usleep(delta);
+            }
+        }
+
+        frames.publish();
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file SensorThread.h
+ *
+ *  @brief Header file for the class SensorThread.
+ *
+ *  This file contains the definition of the class SensorThread, wich
+ *  runs the sensor acquisition in its own thread and publishes every
+ *  frame of a sensor backend.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SENSOR_THREAD_H
+# define SENSOR_THREAD_H
+
+# include <pthread.h>
+
+# include "common.h"
+# include "config.h"
+# include "SensorFrame.h"
+# include "SensorBackend.h"
+# include "TripleBuffer.h"
+
+/**
+ *  @class SensorThread
+ *
+ *  @brief This class handles the sensor acquisition thread.
+ *
+ *  The thread reads the frames of a sensor backend into a SensorFrame
+ *  that is published through a lock-free triple buffer. The game loop
+ *  takes the newest complete frame without blocking, so the render
+ *  rate and the sensor rate are independent.
+ *
+ *  A live backend paces the thread by itself. The frames of the other
+ *  backends are published at the pace of their timestamps.
+ *
+ *  @see SensorBackend
+ *  @see TripleBuffer
+ *  @see SensorFrame
+ */
+class SensorThread
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        SensorThread();
+
+        /**
+         *  Constructor of the class.
+         *  @param sensor pointer to the sensor backend.
+         */
+        SensorThread(SensorBackend *sensor);
+
+        /**
+         *  Class destructor.
+         */
+        ~SensorThread() {}
+
+        /**
+         *  Starts the acquisition thread.
+         */
+        void start();
+
+        /**
+         *  Stops the acquisition thread and waits for it to finish.
+         */
+        void stop();
+
+        /**
+         *  Asks the acquisition thread to stop the generation of the
+         *  sensor backend.
+         */
+        void stopGenerating();
+
+        /**
+         *  Indicates if the label map must be copied into the frames.
+         *  @param value true to capture the label map.
+         */
+        void changeCaptureLabels(bool value);
+
+        /**
+         *  Indicates if the camera image must be copied into the
+         *  frames.
+         *  @param value true to capture the camera image.
+         */
+        void changeCaptureImage(bool value);
+
+        /**
+         *  Takes the newest complete frame if there is a new one. This
+         *  function never blocks.
+         *  @return true if a new frame was taken.
+         */
+        bool update();
+
+        /**
+         *  Returns the last frame taken by update().
+         *  @return current frame.
+         */
+        const SensorFrame& retFrame();
+
+    private:
+
+        /**
+         *  Pointer to the sensor backend.
+         */
+        SensorBackend *backend;
+
+        /**
+         *  Frames shared with the game loop.
+         */
+        TripleBuffer <SensorFrame> frames;
+
+        /**
+         *  Thread handle.
+         */
+        pthread_t thread;
+
+        /**
+         *  Indicates if the thread is running.
+         */
+        bool started;
+
+        /**
+         *  Indicates that the thread must finish.
+         */
+        volatile bool quit;
+
+        /**
+         *  Indicates that the generation of the nodes must stop.
+         */
+        volatile bool stopRequested;
+
+        /**
+         *  Indicates if the label map must be captured.
+         */
+        volatile bool captureLabels;
+
+        /**
+         *  Indicates if the camera image must be captured.
+         */
+        volatile bool captureImage;
+
+        /**
+         *  Entry point of the thread.
+         *  @param sensorThread pointer to the SensorThread object.
+         */
+        static void* run(void *sensorThread);
+
+        /**
+         *  Acquisition loop.
+         */
+        void loop();
+};
+
+# endif
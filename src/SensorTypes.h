@@ -0,0 +1,149 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file SensorTypes.h
+ *
+ *  @brief Header file for the sensor data types.
+ *
+ *  This file includes the OpenNI headers. When the game is compiled
+ *  headless (SFB_HEADLESS) there is no OpenNI, so only the plain data
+ *  types used by the game logic are defined here with the same names
+ *  and layout.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SENSOR_TYPES_H
+# define SENSOR_TYPES_H
+
+# ifndef SFB_HEADLESS
+
+# include <XnOpenNI.h>
+# include <XnOS.h>
+# include <XnCppWrapper.h>
+
+# else
+
+# include <cstdlib>
+# include <cstring>
+
+typedef char               XnChar;
+typedef float              XnFloat;
+typedef unsigned char      XnUInt8;
+typedef unsigned short     XnUInt16;
+typedef unsigned int       XnUInt32;
+typedef int                XnInt32;
+typedef unsigned long long XnUInt64;
+typedef unsigned int       XnBool;
+typedef XnUInt32           XnStatus;
+typedef XnUInt32           XnUserID;
+typedef XnUInt16           XnLabel;
+typedef XnFloat            XnConfidence;
+
+/**
+ *  Vector in the 3D space.
+ */
+typedef struct XnVector3D
+{
+    XnFloat X;
+    XnFloat Y;
+    XnFloat Z;
+} XnVector3D;
+
+typedef XnVector3D XnPoint3D;
+
+/**
+ *  Pixel of the camera image.
+ */
+typedef struct XnRGB24Pixel
+{
+    XnUInt8 nRed;
+    XnUInt8 nGreen;
+    XnUInt8 nBlue;
+} XnRGB24Pixel;
+
+/**
+ *  Plane in the 3D space.
+ */
+typedef struct XnPlane3D
+{
+    XnVector3D vNormal;
+    XnPoint3D  ptPoint;
+} XnPlane3D;
+
+/**
+ *  Joints of the skeleton, with the values used by OpenNI.
+ */
+typedef enum XnSkeletonJoint
+{
+    XN_SKEL_HEAD            = 1,
+    XN_SKEL_NECK            = 2,
+    XN_SKEL_TORSO           = 3,
+    XN_SKEL_WAIST           = 4,
+
+    XN_SKEL_LEFT_COLLAR     = 5,
+    XN_SKEL_LEFT_SHOULDER   = 6,
+    XN_SKEL_LEFT_ELBOW      = 7,
+    XN_SKEL_LEFT_WRIST      = 8,
+    XN_SKEL_LEFT_HAND       = 9,
+    XN_SKEL_LEFT_FINGERTIP  = 10,
+
+    XN_SKEL_RIGHT_COLLAR    = 11,
+    XN_SKEL_RIGHT_SHOULDER  = 12,
+    XN_SKEL_RIGHT_ELBOW     = 13,
+    XN_SKEL_RIGHT_WRIST     = 14,
+    XN_SKEL_RIGHT_HAND      = 15,
+    XN_SKEL_RIGHT_FINGERTIP = 16,
+
+    XN_SKEL_LEFT_HIP        = 17,
+    XN_SKEL_LEFT_KNEE       = 18,
+    XN_SKEL_LEFT_ANKLE      = 19,
+    XN_SKEL_LEFT_FOOT       = 20,
+
+    XN_SKEL_RIGHT_HIP       = 21,
+    XN_SKEL_RIGHT_KNEE      = 22,
+    XN_SKEL_RIGHT_ANKLE     = 23,
+    XN_SKEL_RIGHT_FOOT      = 24
+} XnSkeletonJoint;
+
+/**
+ *  Position of a joint and the confidence of the tracker.
+ */
+typedef struct XnSkeletonJointPosition
+{
+    XnVector3D   position;
+    XnConfidence fConfidence;
+} XnSkeletonJointPosition;
+
+/**
+ *  There are no OpenNI classes, the namespace is declared so the
+ *  using directives still compile.
+ */
+namespace xn {}
+
+# endif
+
+# endif
@@ -0,0 +1,107 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SimulationClock.cpp
+ *
+ *  @brief Implementation file for the class SimulationClock.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class SimulationClock.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "SimulationClock.h"
+
+/**
+ *  Constructor of the class.
+ *  @param rate ticks per second.
+ */
+SimulationClock :: SimulationClock (int rate)
+{
+    tickLength = 1000000 / rate;
+    reset();
+}
+
+/**
+ *  Accumulates the time since the last update. The first update, and
+ *  an update with a time before the last one, only sets the time.
+ *  @param time current time in microseconds.
+ */
+void SimulationClock :: advanceTo (XnUInt64 time)
+{
+    if (started && (time > lastTime)) {
+        accumulator += time - lastTime;
+
+        // After a stall the lost time is dropped, instead of running
+        // the game fast to catch up
+        if (accumulator > SIM_MAX_TICKS * tickLength) {
+            accumulator = SIM_MAX_TICKS * tickLength;
+        }
+    }
+
+    lastTime = time;
+    started  = true;
+}
+
+/**
+ *  Spends a tick of the accumulated time.
+ *  @return true if there was time for a tick.
+ */
+bool SimulationClock :: tick ()
+{
+    if (accumulator < tickLength) {
+        return false;
+    }
+
+    accumulator -= tickLength;
+
+    return true;
+}
+
+/**
+ *  Returns the part of a tick accumulated after the last tick, between
+ *  0 and 1.
+ */
+float SimulationClock :: retAlpha (XnUInt64 elapsed)
+{
+    if (accumulator + elapsed >= tickLength) {
+        return 1.0f;
+    }
+
+    return (float) (accumulator + elapsed) / (float) tickLength;
+}
+
+/**
+ *  Forgets the time and the accumulated time.
+ */
+void SimulationClock :: reset ()
+{
+    accumulator = 0;
+    lastTime    = 0;
+    started     = false;
+}
@@ -0,0 +1,119 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SimulationClock.h
+ *
+ *  @brief Header file for the class SimulationClock.
+ *
+ *  This file contains the definition of the class SimulationClock,
+ *  the fixed timestep of the game.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SIMULATION_CLOCK_H
+# define SIMULATION_CLOCK_H
+
+# include "common.h"
+# include "config.h"
+
+/**
+ *  @class SimulationClock
+ *
+ *  @brief Fixed timestep clock.
+ *
+ *  The time given to the clock is accumulated and it is spent in
+ *  ticks of the same length, the rest waits for the next update. The
+ *  time may come from the wall clock or from the timestamps of the
+ *  frames, then the ticks only depend on the frames.
+ */
+class SimulationClock
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         *  @param rate ticks per second.
+         */
+        SimulationClock(int rate = SIM_TICK_RATE);
+
+        /**
+         *  Class destructor.
+         */
+        ~SimulationClock() {}
+
+        /**
+         *  Accumulates the time since the last update. The first
+         *  update, and an update with a time before the last one,
+         *  only sets the time.
+         *  @param time current time in microseconds.
+         */
+        void advanceTo(XnUInt64 time);
+
+        /**
+         *  Spends a tick of the accumulated time.
+         *  @return true if there was time for a tick.
+         */
+        bool tick();
+
+        /**
+         *  Returns the part of a tick accumulated after the last tick,
+         *  between 0 and 1.
+         *  @param elapsed time in microseconds after the last update
+         *  that is not spent in ticks, only drawn.
+         */
+        float retAlpha(XnUInt64 elapsed = 0);
+
+        /**
+         *  Forgets the time and the accumulated time.
+         */
+        void reset();
+
+    private:
+
+        /**
+         *  Length of a tick in microseconds.
+         */
+        XnUInt64 tickLength;
+
+        /**
+         *  Time not spent yet in microseconds.
+         */
+        XnUInt64 accumulator;
+
+        /**
+         *  Time of the last update in microseconds.
+         */
+        XnUInt64 lastTime;
+
+        /**
+         *  Indicates if the clock had an update.
+         */
+        bool started;
+};
+
+# endif
@@ -0,0 +1,200 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SkeletonRecorder.cpp
+ *
+ *  @brief Implementation of the class SkeletonRecorder.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "SkeletonRecorder.h"
+
+/**
+ *  Constructor of the class.
+ */
+SkeletonRecorder :: SkeletonRecorder ()
+{
+    file = NULL;
+    numFrames = 0;
+}
+
+
+/**
+ *  Class destructor, closes the recording.
+ */
+SkeletonRecorder :: ~SkeletonRecorder ()
+{
+    close();
+}
+
+
+/**
+ *  Creates a new recording.
+ *  @param path path of the recording file.
+ *  @param players number of players of the game.
+ *  @param seed seed of the random numbers of the game.
+ *  @return true if the file was created.
+ */
+bool SkeletonRecorder :: open (const char *path, int players, unsigned int seed)
+{
+    RecordingHeader header;
+
+    close();
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("Could not create the recording %s\n", path);
+        return false;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic     = RECORDING_MAGIC;
+    header.version   = RECORDING_VERSION;
+    header.maxUsers  = MAX_USERS;
+    header.joints    = SNAPSHOT_JOINTS;
+    header.frameSize = sizeof(RecordedFrame);
+    header.players   = players;
+    header.seed      = seed;
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        printf("Could not write the recording %s\n", path);
+        close();
+        return false;
+    }
+
+    numFrames = 0;
+
+    return true;
+}
+
+
+/**
+ *  Closes the recording.
+ */
+void SkeletonRecorder :: close ()
+{
+    if (file != NULL) {
+        fclose(file);
+        file = NULL;
+    }
+}
+
+
+/**
+ *  Indicates if there is an open recording.
+ *  @return true if the frames are being recorded.
+ */
+bool SkeletonRecorder :: isRecording ()
+{
+    return file != NULL;
+}
+
+
+/**
+ *  Writes a frame to the recording.
+ *  @param frame sensor frame.
+ *  @param stages stage of every user of the frame.
+ */
+void SkeletonRecorder :: record (const SensorFrame *frame, const int *stages)
+{
+    int i;
+    int j;
+    const SensorUser *user;
+    const SnapshotJoint *skeleton;
+    RecordedUser *out;
+
+    if (file == NULL) {
+        return;
+    }
+
+    memset(&recorded, 0, sizeof(recorded));
+
+    recorded.timestamp = frame -> timestamp;
+    recorded.frameID   = frame -> frameID;
+    recorded.numUsers  = frame -> numUsers;
+
+    recorded.floor[0] = frame -> floor.ptPoint.X;
+    recorded.floor[1] = frame -> floor.ptPoint.Y;
+    recorded.floor[2] = frame -> floor.ptPoint.Z;
+    recorded.floor[3] = frame -> floor.vNormal.X;
+    recorded.floor[4] = frame -> floor.vNormal.Y;
+    recorded.floor[5] = frame -> floor.vNormal.Z;
+    recorded.floorProjective[0] = frame -> floorProjective.X;
+    recorded.floorProjective[1] = frame -> floorProjective.Y;
+    recorded.floorProjective[2] = frame -> floorProjective.Z;
+
+    for (i = 0; i < frame -> numUsers; i++) {
+        user = &frame -> users[i];
+        out  = &recorded.users[i];
+
+        out -> id       = user -> id;
+        out -> tracking = user -> tracking ? 1 : 0;
+        out -> stage    = stages[i];
+
+        out -> com[0] = user -> com.X;
+        out -> com[1] = user -> com.Y;
+        out -> com[2] = user -> com.Z;
+        out -> comProjective[0] = user -> comProjective.X;
+        out -> comProjective[1] = user -> comProjective.Y;
+        out -> comProjective[2] = user -> comProjective.Z;
+
+        // Untracked users have no skeleton, their joints stay at zero
+        if (!user -> tracking) {
+            continue;
+        }
+
+        skeleton = frame -> skeletons.retSkeleton(i);
+        for (j = 0; j < SNAPSHOT_JOINTS; j++) {
+            out -> joints[j][0] = skeleton[j].real.X;
+            out -> joints[j][1] = skeleton[j].real.Y;
+            out -> joints[j][2] = skeleton[j].real.Z;
+            out -> joints[j][3] = skeleton[j].projective.X;
+            out -> joints[j][4] = skeleton[j].projective.Y;
+            out -> joints[j][5] = skeleton[j].projective.Z;
+            out -> joints[j][6] = skeleton[j].confidence;
+        }
+    }
+
+    if (fwrite(&recorded, sizeof(recorded), 1, file) != 1) {
+        printf("Could not write the recording, it is stopped\n");
+        close();
+        return;
+    }
+
+    numFrames++;
+}
+
+
+/**
+ *  Returns the number of frames recorded.
+ *  @return number of frames.
+ */
+XnUInt32 SkeletonRecorder :: retNumFrames ()
+{
+    return numFrames;
+}
@@ -0,0 +1,130 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SkeletonRecorder.h
+ *
+ *  @brief Header file for the class SkeletonRecorder.
+ *
+ *  This file contains the definition of the recorder that writes the
+ *  sensor frames of a game session to a binary file.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SKELETON_RECORDER_H
+# define SKELETON_RECORDER_H
+
+# include "common.h"
+# include "config.h"
+# include "SensorFrame.h"
+# include "SkeletonRecording.h"
+
+/**
+ *  @class SkeletonRecorder
+ *
+ *  @brief This class writes the sensor frames to a recording.
+ *
+ *  The recorder is hooked into the UserDetector, that gives it every
+ *  new frame with the stage of each user. The recording can be played
+ *  later with a ReplayBackend.
+ *
+ *  @see SkeletonRecording.h
+ *  @see ReplayBackend
+ */
+class SkeletonRecorder
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        SkeletonRecorder();
+
+        /**
+         *  Class destructor, closes the recording.
+         */
+        ~SkeletonRecorder();
+
+        /**
+         *  Creates a new recording.
+         *  @param path path of the recording file.
+         *  @param players number of players of the game.
+         *  @param seed seed of the random numbers of the game.
+         *  @return true if the file was created.
+         */
+        bool open(const char *path, int players, unsigned int seed);
+
+        /**
+         *  Closes the recording.
+         */
+        void close();
+
+        /**
+         *  Indicates if there is an open recording.
+         *  @return true if the frames are being recorded.
+         */
+        bool isRecording();
+
+        /**
+         *  Writes a frame to the recording.
+         *  @param frame sensor frame.
+         *  @param stages stage of every user of the frame.
+         */
+        void record(const SensorFrame *frame, const int *stages);
+
+        /**
+         *  Returns the number of frames recorded.
+         *  @return number of frames.
+         */
+        XnUInt32 retNumFrames();
+
+    private:
+
+        /**
+         *  Recording file, NULL if there is no recording.
+         */
+        FILE *file;
+
+        /**
+         *  Number of frames recorded.
+         */
+        XnUInt32 numFrames;
+
+        /**
+         *  Frame being written, kept to avoid a big stack frame.
+         */
+        RecordedFrame recorded;
+
+        /**
+         *  Copy constructor and assignment are not allowed, the
+         *  recorder owns the file.
+         */
+        SkeletonRecorder(const SkeletonRecorder&);
+        SkeletonRecorder& operator=(const SkeletonRecorder&);
+};
+
+# endif
@@ -0,0 +1,192 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SkeletonRecording.h
+ *
+ *  @brief Binary format of the skeleton recordings.
+ *
+ *  This file contains the structures written by the SkeletonRecorder
+ *  and read by the ReplayBackend.
+ *
+ *  A recording is a RecordingHeader followed by one RecordedFrame for
+ *  every sensor frame. All the frames have the same size, so the
+ *  frame i is at sizeof(RecordingHeader) + i * sizeof(RecordedFrame)
+ *  and the file can be read directly from memory. The values are
+ *  stored in the byte order of the machine that recorded them.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SKELETON_RECORDING_H
+# define SKELETON_RECORDING_H
+
+# include "common.h"
+# include "config.h"
+# include "SkeletonSnapshot.h"
+
+/**
+ *  Magic number of the recordings, "SFBR" in little endian.
+ */
+# define RECORDING_MAGIC 0x52424653
+
+/**
+ *  Version of the format.
+ */
+# define RECORDING_VERSION 1
+
+/**
+ *  Floats stored for every joint: real world position, projective
+ *  position and confidence.
+ */
+# define RECORDED_JOINT_SIZE 7
+
+/**
+ *  @class RecordingHeader
+ *
+ *  @brief Header of a skeleton recording.
+ */
+class RecordingHeader
+{
+    public:
+
+        /**
+         *  Must be RECORDING_MAGIC.
+         */
+        XnUInt32 magic;
+
+        /**
+         *  Must be RECORDING_VERSION.
+         */
+        XnUInt32 version;
+
+        /**
+         *  MAX_USERS and SNAPSHOT_JOINTS of the recorder, used to
+         *  check that the frames have the expected layout.
+         */
+        XnUInt32 maxUsers;
+        XnUInt32 joints;
+
+        /**
+         *  Size in bytes of every frame.
+         */
+        XnUInt32 frameSize;
+
+        /**
+         *  Number of players of the recorded game.
+         */
+        XnUInt32 players;
+
+        /**
+         *  Seed of the random numbers of the recorded game.
+         */
+        XnUInt32 seed;
+
+        /**
+         *  Unused, keeps the frames aligned.
+         */
+        XnUInt32 reserved;
+};
+
+/**
+ *  @class RecordedUser
+ *
+ *  @brief One user of a recorded frame.
+ */
+class RecordedUser
+{
+    public:
+
+        /**
+         *  ID of the user.
+         */
+        XnUserID id;
+
+        /**
+         *  1 if the skeleton of the user was being tracked.
+         */
+        XnUInt32 tracking;
+
+        /**
+         *  Stage of the user when the frame was taken, NO_LISTENED if
+         *  he was not transforming nor transformed.
+         */
+        XnInt32 stage;
+
+        /**
+         *  Center of mass, real world and projective.
+         */
+        XnFloat com[3];
+        XnFloat comProjective[3];
+
+        /**
+         *  Joints in the order of the SkeletonSnapshot.
+         */
+        XnFloat joints[SNAPSHOT_JOINTS][RECORDED_JOINT_SIZE];
+};
+
+/**
+ *  @class RecordedFrame
+ *
+ *  @brief One recorded sensor frame.
+ */
+class RecordedFrame
+{
+    public:
+
+        /**
+         *  Time of the frame in microseconds.
+         */
+        XnUInt64 timestamp;
+
+        /**
+         *  Frame ID given by the depth generator.
+         */
+        XnUInt32 frameID;
+
+        /**
+         *  Number of users in the frame.
+         */
+        XnUInt32 numUsers;
+
+        /**
+         *  Floor plane (point and normal) and its projective point.
+         */
+        XnFloat floor[6];
+        XnFloat floorProjective[3];
+
+        /**
+         *  Unused, keeps the users aligned.
+         */
+        XnUInt32 reserved;
+
+        /**
+         *  Users of the frame, only the first numUsers are valid.
+         */
+        RecordedUser users[MAX_USERS];
+};
+
+# endif
@@ -0,0 +1,145 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file SkeletonSnapshot.cpp
+ *
+ *  @brief Implementation file for the class SkeletonSnapshot.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class SkeletonSnapshot.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "SkeletonSnapshot.h"
+
+/**
+ *  Joints stored in the snapshot, in skeleton order.
+ */
+static const XnSkeletonJoint snapshotJoints[SNAPSHOT_JOINTS] =
+{
+    XN_SKEL_HEAD,
+    XN_SKEL_NECK,
+    XN_SKEL_TORSO,
+    XN_SKEL_LEFT_SHOULDER,
+    XN_SKEL_LEFT_ELBOW,
+    XN_SKEL_LEFT_HAND,
+    XN_SKEL_RIGHT_SHOULDER,
+    XN_SKEL_RIGHT_ELBOW,
+    XN_SKEL_RIGHT_HAND,
+    XN_SKEL_LEFT_HIP,
+    XN_SKEL_LEFT_KNEE,
+    XN_SKEL_LEFT_FOOT,
+    XN_SKEL_RIGHT_HIP,
+    XN_SKEL_RIGHT_KNEE,
+    XN_SKEL_RIGHT_FOOT
+};
+
+/**
+ *  Index of every OpenNI joint inside the skeleton, -1 for the joints
+ *  that are not stored.
+ */
+static const int jointIndexes[XN_SKEL_RIGHT_FOOT + 1] =
+{
+    -1,
+     0,  1,  2, -1,         // Head, neck, torso, waist
+    -1,  3,  4, -1,  5, -1, // Left collar to left fingertip
+    -1,  6,  7, -1,  8, -1, // Right collar to right fingertip
+     9, 10, -1, 11,         // Left hip to left foot
+    12, 13, -1, 14          // Right hip to right foot
+};
+
+/**
+ *  Constructor of the class.
+ */
+SkeletonSnapshot :: SkeletonSnapshot()
+{
+    clear();
+}
+
+/**
+ *  Sets all the joints to zero.
+ */
+void SkeletonSnapshot :: clear()
+{
+    memset(joints, 0, sizeof(joints));
+}
+
+/**
+ *  Returns the index of an OpenNI joint inside an user skeleton.
+ *  @param joint OpenNI joint.
+ *  @return index of the joint, -1 if it is not in the snapshot.
+ */
+int SkeletonSnapshot :: jointIndex(XnSkeletonJoint joint)
+{
+    if ((joint < 0) || (joint > XN_SKEL_RIGHT_FOOT)) {
+        return -1;
+    }
+
+    return jointIndexes[joint];
+}
+
+/**
+ *  Returns the OpenNI joint stored at an index of the skeleton.
+ *  @param index index of the joint inside an user skeleton.
+ *  @return OpenNI joint.
+ */
+XnSkeletonJoint SkeletonSnapshot :: indexJoint(int index)
+{
+    return snapshotJoints[index];
+}
+
+/**
+ *  Returns the skeleton of the user in a slot of the frame.
+ *  @param slot slot of the user in the frame.
+ *  @return pointer to the SNAPSHOT_JOINTS joints of the user.
+ */
+SnapshotJoint* SkeletonSnapshot :: retSkeleton(int slot)
+{
+    return &joints[slot * SNAPSHOT_JOINTS];
+}
+
+/**
+ *  Returns the skeleton of the user in a slot of the frame.
+ *  @param slot slot of the user in the frame.
+ *  @return pointer to the SNAPSHOT_JOINTS joints of the user.
+ */
+const SnapshotJoint* SkeletonSnapshot :: retSkeleton(int slot) const
+{
+    return &joints[slot * SNAPSHOT_JOINTS];
+}
+
+/**
+ *  Returns one joint of the user in a slot of the frame.
+ *  @param slot slot of the user in the frame.
+ *  @param joint OpenNI joint, it must be in the snapshot.
+ *  @return joint of the user.
+ */
+const SnapshotJoint& SkeletonSnapshot :: retJoint(int slot, 
+                                                 XnSkeletonJoint joint) const
+{
+    return joints[slot * SNAPSHOT_JOINTS + jointIndexes[joint]];
+}
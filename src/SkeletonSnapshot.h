@@ -0,0 +1,145 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file SkeletonSnapshot.h
+ *
+ *  @brief Header file for the class SkeletonSnapshot.
+ *
+ *  This file contains the definition of the skeleton cache that is
+ *  built once per sensor frame and shared by all the detectors and
+ *  renderers.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SKELETON_SNAPSHOT_H
+# define SKELETON_SNAPSHOT_H
+
+# include "common.h"
+# include "config.h"
+
+/**
+ *  Number of joints of every skeleton in the snapshot.
+ */
+# define SNAPSHOT_JOINTS 15
+
+/**
+ *  @class SnapshotJoint
+ *
+ *  @brief One joint of the snapshot in both coordinate systems.
+ */
+class SnapshotJoint
+{
+    public:
+
+        /**
+         *  Position in real world coordinates.
+         */
+        XnPoint3D real;
+
+        /**
+         *  Position in projective coordinates.
+         */
+        XnPoint3D projective;
+
+        /**
+         *  Confidence given by the skeleton tracker.
+         */
+        XnConfidence confidence;
+};
+
+/**
+ *  @class SkeletonSnapshot
+ *
+ *  @brief Skeletons of all the users of one sensor frame.
+ *
+ *  The joints of every user are stored in one contiguous array, the
+ *  SNAPSHOT_JOINTS joints of the user in the slot i of the frame start
+ *  at i * SNAPSHOT_JOINTS. The real world positions are read once from
+ *  OpenNI and converted to projective coordinates in a single call, so
+ *  the consumers never talk to the sensor.
+ *
+ *  @see SensorFrame
+ */
+class SkeletonSnapshot
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        SkeletonSnapshot();
+
+        /**
+         *  Sets all the joints to zero.
+         */
+        void clear();
+
+        /**
+         *  Returns the index of an OpenNI joint inside an user skeleton.
+         *  @param joint OpenNI joint.
+         *  @return index of the joint, -1 if it is not in the snapshot.
+         */
+        static int jointIndex(XnSkeletonJoint joint);
+
+        /**
+         *  Returns the OpenNI joint stored at an index of the skeleton.
+         *  @param index index of the joint inside an user skeleton.
+         *  @return OpenNI joint.
+         */
+        static XnSkeletonJoint indexJoint(int index);
+
+        /**
+         *  Returns the skeleton of the user in a slot of the frame.
+         *  @param slot slot of the user in the frame.
+         *  @return pointer to the SNAPSHOT_JOINTS joints of the user.
+         */
+        SnapshotJoint* retSkeleton(int slot);
+
+        /**
+         *  Returns the skeleton of the user in a slot of the frame.
+         *  @param slot slot of the user in the frame.
+         *  @return pointer to the SNAPSHOT_JOINTS joints of the user.
+         */
+        const SnapshotJoint* retSkeleton(int slot) const;
+
+        /**
+         *  Returns one joint of the user in a slot of the frame.
+         *  @param slot slot of the user in the frame.
+         *  @param joint OpenNI joint, it must be in the snapshot.
+         *  @return joint of the user.
+         */
+        const SnapshotJoint& retJoint(int slot, XnSkeletonJoint joint) const;
+
+    private:
+
+        /**
+         *  Joints of all the users.
+         */
+        SnapshotJoint joints[MAX_USERS * SNAPSHOT_JOINTS];
+};
+
+# endif
@@ -0,0 +1,228 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SpatialGrid.cpp
+ *
+ *  @brief Implementation file for the class SpatialGrid.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class SpatialGrid.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "SpatialGrid.h"
+
+/**
+ *  Maximum number of cells per point, when the points are more
+ *  spread the cells grow.
+ */
+# define CELLS_PER_POINT 8
+
+/**
+ *  Constructor of the class.
+ */
+SpatialGrid :: SpatialGrid ()
+{
+    int i;
+
+    cellSize    = COLLISION_CELL_SIZE;
+    currentSize = cellSize;
+    remaining   = 0;
+
+    for (i = 0; i < 3; i++) {
+        origin[i] = 0.0;
+        dims[i]   = 0;
+    }
+}
+
+/**
+ *  Constructor of the class.
+ *  @param size size of the side of the cells.
+ */
+SpatialGrid :: SpatialGrid (float size)
+{
+    int i;
+
+    cellSize    = size;
+    currentSize = cellSize;
+    remaining   = 0;
+
+    for (i = 0; i < 3; i++) {
+        origin[i] = 0.0;
+        dims[i]   = 0;
+    }
+}
+
+/**
+ *  Builds the grid with a set of points, the items are the indexes
+ *  of the points.
+ *  @param points points to be stored.
+ */
+void SpatialGrid :: build (const vector <Vector3D>& points)
+{
+    int i;
+    int numCells;
+    float low[3];
+    float high[3];
+    int coords[3];
+
+    items.resize(points.size());
+    pointCell.resize(points.size());
+    pointSlot.resize(points.size());
+    remaining = points.size();
+
+    if (points.empty()) {
+        dims[0] = dims[1] = dims[2] = 0;
+        return;
+    }
+
+    // Bounding box of the points
+    low[0] = high[0] = points[0].x;
+    low[1] = high[1] = points[0].y;
+    low[2] = high[2] = points[0].z;
+
+    for (i = 1; i < points.size(); i++) {
+        low[0]  = min(low[0], points[i].x);
+        low[1]  = min(low[1], points[i].y);
+        low[2]  = min(low[2], points[i].z);
+        high[0] = max(high[0], points[i].x);
+        high[1] = max(high[1], points[i].y);
+        high[2] = max(high[2], points[i].z);
+    }
+
+    // The cells grow until there are not too many
+    currentSize = cellSize;
+
+    do {
+        numCells = 1;
+        for (i = 0; i < 3; i++) {
+            origin[i] = low[i];
+            dims[i]   = (int) ((high[i] - low[i]) / currentSize) + 1;
+            numCells *= dims[i];
+        }
+
+        if (numCells > CELLS_PER_POINT * (int) points.size() + 64) {
+            currentSize *= 2;
+        }
+    } while (numCells > CELLS_PER_POINT * (int) points.size() + 64);
+
+    cellStart.assign(numCells + 1, 0);
+    cellEnd.resize(numCells);
+
+    // Counting sort of the points by cell
+    for (i = 0; i < points.size(); i++) {
+        coords[0] = cellCoord(points[i].x, 0);
+        coords[1] = cellCoord(points[i].y, 1);
+        coords[2] = cellCoord(points[i].z, 2);
+
+        pointCell[i] = (coords[0] * dims[1] + coords[1]) * dims[2] + coords[2];
+        cellStart[pointCell[i] + 1]++;
+    }
+
+    for (i = 0; i < numCells; i++) {
+        cellStart[i + 1] += cellStart[i];
+    }
+
+    for (i = 0; i < numCells; i++) {
+        cellEnd[i] = cellStart[i];
+    }
+
+    for (i = 0; i < points.size(); i++) {
+        pointSlot[i] = cellEnd[pointCell[i]]++;
+        items[pointSlot[i]] = i;
+    }
+}
+
+/**
+ *  Adds to a list the items of the cells that touch a box, every
+ *  item is added once.
+ *  @param center center of the box.
+ *  @param halfSize half of the side of the box.
+ *  @param found list where the items are added.
+ */
+void SpatialGrid :: query (const Vector3D& center, 
+                           float halfSize, 
+                           vector <int>& found)
+{
+    int x;
+    int y;
+    int z;
+    int i;
+    int cell;
+    int low[3];
+    int high[3];
+
+    if (remaining == 0) {
+        return;
+    }
+
+    low[0]  = max(cellCoord(center.x - halfSize, 0), 0);
+    low[1]  = max(cellCoord(center.y - halfSize, 1), 0);
+    low[2]  = max(cellCoord(center.z - halfSize, 2), 0);
+    high[0] = min(cellCoord(center.x + halfSize, 0), dims[0] - 1);
+    high[1] = min(cellCoord(center.y + halfSize, 1), dims[1] - 1);
+    high[2] = min(cellCoord(center.z + halfSize, 2), dims[2] - 1);
+
+    // The box is outside of the grid
+    if ((low[0] > high[0]) || (low[1] > high[1]) || (low[2] > high[2])) {
+        return;
+    }
+
+    for (x = low[0]; x <= high[0]; x++) {
+        for (y = low[1]; y <= high[1]; y++) {
+            for (z = low[2]; z <= high[2]; z++) {
+                cell = (x * dims[1] + y) * dims[2] + z;
+
+                for (i = cellStart[cell]; i < cellEnd[cell]; i++) {
+                    found.push_back(items[i]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  Removes an item of the grid, the next queries do not return it.
+ *  @param item index of the point to be removed.
+ */
+void SpatialGrid :: remove (int item)
+{
+    int cell;
+    int last;
+    int slot;
+
+    // The last item of the cell takes the place of the removed one
+    cell = pointCell[item];
+    slot = pointSlot[item];
+    last = items[cellEnd[cell] - 1];
+
+    items[slot]     = last;
+    pointSlot[last] = slot;
+    cellEnd[cell]--;
+    remaining--;
+}
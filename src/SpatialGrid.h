@@ -0,0 +1,165 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SpatialGrid.h
+ *
+ *  @brief Header file for the class SpatialGrid.
+ *
+ *  This file contains the definition of the class SpatialGrid, the
+ *  broadphase of the collisions between the flames and the shoots.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SPATIAL_GRID_H
+# define SPATIAL_GRID_H
+
+# include "common.h"
+# include "config.h"
+
+/**
+ *  @class SpatialGrid
+ *
+ *  @brief Uniform grid of points.
+ *
+ *  The grid covers the bounding box of the points and it is split in
+ *  cubic cells. It is built again with all the points every frame, so
+ *  the points are sorted by cell in a single array without any list.
+ *  A query returns the points of the cells that touch a box, they
+ *  still have to be tested against the box.
+ */
+class SpatialGrid
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        SpatialGrid();
+
+        /**
+         *  Constructor of the class.
+         *  @param size size of the side of the cells.
+         */
+        SpatialGrid(float size);
+
+        /**
+         *  Class destructor.
+         */
+        ~SpatialGrid() {}
+
+        /**
+         *  Builds the grid with a set of points, the items are the
+         *  indexes of the points.
+         *  @param points points to be stored.
+         */
+        void build(const vector <Vector3D>& points);
+
+        /**
+         *  Adds to a list the items of the cells that touch a box,
+         *  every item is added once.
+         *  @param center center of the box.
+         *  @param halfSize half of the side of the box.
+         *  @param found list where the items are added.
+         */
+        void query(const Vector3D& center, float halfSize, vector <int>& found);
+
+        /**
+         *  Removes an item of the grid, the next queries do not return
+         *  it.
+         *  @param item index of the point to be removed.
+         */
+        void remove(int item);
+
+    private:
+
+        /**
+         *  Size of the side of the cells.
+         */
+        float cellSize;
+
+        /**
+         *  Size of the side of the cells of the current grid, it is
+         *  bigger than cellSize when the points are too spread.
+         */
+        float currentSize;
+
+        /**
+         *  Lowest corner of the grid.
+         */
+        float origin[3];
+
+        /**
+         *  Number of cells in every axis.
+         */
+        int dims[3];
+
+        /**
+         *  Start of every cell in the items array.
+         */
+        vector <int> cellStart;
+
+        /**
+         *  End of every cell in the items array, it goes down when
+         *  the items are removed.
+         */
+        vector <int> cellEnd;
+
+        /**
+         *  Items sorted by cell.
+         */
+        vector <int> items;
+
+        /**
+         *  Number of items that have not been removed.
+         */
+        int remaining;
+
+        /**
+         *  Position of every point in the items array.
+         */
+        vector <int> pointSlot;
+
+        /**
+         *  Cell of every point.
+         */
+        vector <int> pointCell;
+
+        /**
+         *  Returns the cell coordinate of a coordinate in an axis,
+         *  it may be outside of the grid.
+         *  @param value coordinate.
+         *  @param axis axis of the coordinate.
+         *  @return cell coordinate.
+         */
+        int cellCoord(float value, int axis)
+        {
+            return (int) floor((value - origin[axis]) / currentSize);
+        }
+};
+
+# endif
@@ -30,11 +30,9 @@
 SuperFiremanBrothers :: SuperFiremanBrothers () 
 {
     userDetector  = NULL;
-    sceneAnalyzer = NULL;
     zamusDetector = NULL;
     linqDetector = NULL;
-    players = map <XnUserID, int> ();
-    fireBalls = vector <Flame> (MAX_FIREBALLS, Flame());
+    userTable = NULL;
     level = 0;
     numFlames = 0;
     maxPlayers = 0;
@@ -43,39 +41,27 @@ SuperFiremanBrothers :: SuperFiremanBrothers ()
     lostGame = false;
     gameStatus = NOT_STARTED;
     flameModel = FlameModel();
+    startLevels();
 }
 
 
 /** 
  *  Constructor of the class.
  *  @param ud pointer to a User Detector type.
- *  @param sa pointer to a Scene Analyzer type.
  *  @param zd pointer to Zamus Listener type.
  *  @ṕaram ld pointer to Linq Listener type.
  *  @param mp max numer of players allowed.
  */
 SuperFiremanBrothers :: SuperFiremanBrothers (UserDetector *ud,
-                                              SceneAnalyzer *sa,
                                               Zamus *zd,
                                               Linq *ld,
                                               int mp) 
 { 
-    XnPlane3D floor;
-    DepthGenerator dgen;
-
-    dgen = ud -> retDepthGenerator();
-    sa -> GetFloor(floor);
-    dgen.ConvertRealWorldToProjective(1,
-                                      &floor.ptPoint,
-                                      &floor.ptPoint);
-
-    floorLevel = floor.ptPoint.Y + 100;
+    floorLevel = 0;
     userDetector  = ud;
-    sceneAnalyzer = sa;
     zamusDetector = zd;
     linqDetector = ld;
-    players = map <XnUserID, int> ();
-    fireBalls = vector <Flame> (MAX_FIREBALLS, Flame());
+    userTable = ud -> retUserTable();
     level = 0;
     numFlames = 0;
     maxPlayers = mp;
@@ -83,6 +69,7 @@ SuperFiremanBrothers :: SuperFiremanBrothers (UserDetector *ud,
     lostGame = false;
     gameStatus = NOT_STARTED;
     flameModel = FlameModel();
+    startLevels();
 }
 
 
@@ -95,18 +82,28 @@ SuperFiremanBrothers :: SuperFiremanBrothers (UserDetector *ud,
 void SuperFiremanBrothers ::  checkUsers() 
 {
     int i;
+    int slot;
+    int numListened;
+    bool listened[USER_SLOTS];
 
     vector <XnUserID> users;
-    map <XnUserID, int> p;
-    map <XnUserID, int> :: iterator iter;
 
     users = userDetector -> trackedUsers();
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        listened[i] = false;
+    }
     
     // Check for tracked listened players
+    numListened = 0;
     for(i = 0; i < users.size(); i++) {
         if (zamusDetector -> isListened (users[i]) || 
             linqDetector -> isListened (users[i])) {
-            p.insert(pair <XnUserID, int> (users[i], 0));
+            slot = userTable -> findSlot(users[i]);
+            if (slot != -1) {
+                listened[slot] = true;
+                numListened++;
+            }
         }
     }
     
@@ -114,15 +111,16 @@ void SuperFiremanBrothers ::  checkUsers()
     if (gameStatus == STARTED) {
         
         // Check players who left the game
-        for (iter = players.begin(); iter != players.end(); iter++) {
-            if (p.count(iter -> first) == 0) {
-                printf("Player %d has left the game\n", iter -> first);
-                players.erase(iter -> first);
+        for (i = 0; i < USER_SLOTS; i++) {
+            if (userTable -> player[i] && !listened[i]) {
+                printf("Player %d has left the game\n", userTable -> ids[i]);
+                userTable -> player[i] = false;
+                userTable -> score[i]  = 0;
             } 
         }
         
         // No players in game
-        if (p.size() == 0) {
+        if (numListened == 0) {
             gameStatus = NO_PLAYERS;
             return;
         }
@@ -130,12 +128,18 @@ void SuperFiremanBrothers ::  checkUsers()
 
     }
     else if (gameStatus == NOT_STARTED) {
-        players = p;
+        for (i = 0; i < USER_SLOTS; i++) {
+            userTable -> player[i] = listened[i];
+            userTable -> score[i]  = 0;
+        }
     }
 
     // All players ready to start game
-    if (players.size() == maxPlayers) {
+    if (numPlayers() == maxPlayers) {
         userDetector -> changeStopDetection(true);
+        if (gameStatus == NOT_STARTED) {
+            startLevels();
+        }
         gameStatus  = STARTED;
         return;
     }
@@ -151,7 +155,7 @@ void SuperFiremanBrothers :: checkGameOver()
     if (gameStatus == STARTED) {
     
         // Not enough players
-        if (players.size() == 0) {
+        if (numPlayers() == 0) {
             printf("Players left the game...!\n");
             gameStatus = NO_PLAYERS;
         }
@@ -178,9 +182,15 @@ void SuperFiremanBrothers :: checkGameOver()
  */
 int SuperFiremanBrothers :: retScore(XnUserID player) 
 {
-    if (players.count(player) == 1) {
-        return players[player];
+    int slot;
+
+    slot = userTable -> findSlot(player);
+
+    if ((slot != -1) && userTable -> player[slot]) {
+        return userTable -> score[slot];
     }
+
+    return 0;
 }
 
 
@@ -194,6 +204,81 @@ int SuperFiremanBrothers :: retGameStatus()
 }
 
 
+/**
+ *  Return the actual level of the game.
+ *  @return level.
+ */
+int SuperFiremanBrothers :: retLevel() 
+{
+    return level;
+}
+
+
+/**
+ *  Adds some bytes to a FNV-1a checksum.
+ *  @param checksum checksum to be updated.
+ *  @param data bytes to be added.
+ *  @param size number of bytes.
+ */
+static void addToChecksum (XnUInt32& checksum, const void *data, int size)
+{
+    int i;
+    const unsigned char *bytes;
+
+    bytes = (const unsigned char *) data;
+
+    for (i = 0; i < size; i++) {
+        checksum ^= bytes[i];
+        checksum *= 16777619;
+    }
+}
+
+
+/**
+ *  Returns a checksum of the state of the game: level, scores and
+ *  flames. Two runs with the same seed and input must give the same
+ *  checksum.
+ *  @return checksum.
+ */
+XnUInt32 SuperFiremanBrothers :: retChecksum ()
+{
+    int i;
+    float size;
+    XnUInt32 checksum;
+    Vector3D position;
+
+    checksum = 2166136261U;
+
+    addToChecksum(checksum, &level, sizeof(level));
+    addToChecksum(checksum, &numFlames, sizeof(numFlames));
+    addToChecksum(checksum, &counter, sizeof(counter));
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (userTable -> player[i]) {
+            addToChecksum(checksum, 
+                          &userTable -> ids[i], 
+                          sizeof(userTable -> ids[i]));
+            addToChecksum(checksum, 
+                          &userTable -> score[i], 
+                          sizeof(userTable -> score[i]));
+        }
+    }
+
+    // The bounding box of a flame depends on its hp
+    for (i = 0; i < fireBalls.size(); i++) {
+        position = fireBalls[i].getPosition();
+        size     = fireBalls[i].boundingSize();
+
+        addToChecksum(checksum, &position.x, sizeof(position.x));
+        addToChecksum(checksum, &position.y, sizeof(position.y));
+        addToChecksum(checksum, &position.z, sizeof(position.z));
+        addToChecksum(checksum, &size, sizeof(size));
+    }
+
+    return checksum;
+}
+
+
 /**
  *  Method that indicates if the game has started
  *  or not.
@@ -217,26 +302,25 @@ bool SuperFiremanBrothers :: isGameOver()
 }
 
 
+# ifndef SFB_HEADLESS
+
 /**
  *  Method that draws the Fireballs of the game and 
  *  controls the vector of fireballs.
+ *  @param alpha part of a tick since the last one, the flames are
+ *  drawn between their last two positions.
  */
-void SuperFiremanBrothers :: drawFireBalls ()
+void SuperFiremanBrothers :: drawFireBalls (float alpha)
 {
     int i;
 
+    // The extinguished flames are removed in nextFrame()
     for (i = 0; i < fireBalls.size(); i++) {
-        if (fireBalls[i].isAlive()) {
-            fireBalls[i].drawFlame();
-
-            // Draw Shadow.
-            fireBalls[i].drawShadow(floorLevel);
-        }
-        else {
-            fireBalls.erase(fireBalls.begin() + i);
-            i--;
-        }
+        fireBalls[i].addToBatch(flameBatch, alpha);
     }
+
+    // All the flames and then all the shadows
+    flameBatch.draw(flameModel.flame, floorLevel);
 }
 
 
@@ -251,26 +335,24 @@ void SuperFiremanBrothers :: drawGameInfo ()
     char strLevel[20] = "";
     char strStart[20] = "Calibrate to begin";
     char strEnd[20] = "Game Over";
-    UserGenerator uGen;
-    DepthGenerator dGen;
     XnUserID player;
     XnPoint3D com;
-    map <XnUserID, int> :: iterator iter;
+    int i;
 
     float amb[3] = {1.0, 1.0, 1.0};
     glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, amb);
     glDisable(GL_LIGHTING);
     y = -768;
 
-    uGen = userDetector -> retUserGenerator();
-    dGen = userDetector -> retDepthGenerator();
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (!userTable -> player[i]) {
+            continue;
+        }
 
-    for (iter = players.begin(); iter != players.end(); iter++) {
-        player = iter -> first;
-        score  = iter -> second;
+        player = userTable -> ids[i];
+        score  = userTable -> score[i];
         sprintf(strLabel, "Score: %d", score);
-        uGen.GetCoM(player, com);
-        dGen.ConvertRealWorldToProjective(1, &com, &com);
+        userDetector -> getProjectiveCoM(player, com);
 
         glRasterPos3f( com.X + 100, com.Y - 300, com.Z);
         glPrintString(GLUT_BITMAP_HELVETICA_18, strLabel);
@@ -307,10 +389,123 @@ void SuperFiremanBrothers :: glPrintString(void *font, char *str)
     }
 }
 
+# endif
+
+
+/**
+ *  Sets the spawn rate, speed and number of flames of the first
+ *  level, and how they rise in every level, for the players that
+ *  started the game.
+ */
+void SuperFiremanBrothers :: startLevels ()
+{
+    counter           = 0;
+    spawnRate         = (SPAWN_RATE_FIRST_LEVEL) * numPlayers();
+    speedRate         = (SPEED_RATE_FIRST_LEVEL) * numPlayers(); 
+    flamesInLevel     = (FLAMES_IN_FIRST_LEVEL) * numPlayers();
+    riseSpawnRate     = (RISE_SPAWN_RATE) * numPlayers();
+    riseSpeedRate     = (RISE_SPEED_RATE) * numPlayers();
+    riseFlamesInLevel = (RISE_FLAMES_IN_LEVEL) * numPlayers();
+}
+
+
+/**
+ *  Returns the number of players of the game.
+ *  @return number of players.
+ */
+int SuperFiremanBrothers :: numPlayers ()
+{
+    int i;
+    int n;
+
+    if (userTable == NULL) {
+        return 0;
+    }
+
+    n = 0;
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (userTable -> player[i]) {
+            n++;
+        }
+    }
+
+    return n;
+}
+
+
+/**
+ *  Adds points to the score of a player.
+ *  @param player user ID of the player.
+ *  @param points points to be added.
+ */
+void SuperFiremanBrothers :: addPoints (XnUserID player, int points)
+{
+    int slot;
+
+    slot = userTable -> findSlot(player);
+
+    if (slot != -1) {
+        userTable -> score[slot] += points;
+    }
+}
+
+
+/**
+ *  Reads the feet of the players in a new sensor frame. They stomp the
+ *  flames once, in the next tick, because they only move with the
+ *  frames.
+ */
+void SuperFiremanBrothers :: readFeet ()
+{
+    int i;
+
+    XnUserID  player;
+    XnSkeletonJointPosition joint;
+
+    clearFeet();
+
+    if (gameStatus != STARTED) {
+        return;
+    }
+
+    // Both feet of every player
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (!userTable -> player[i]) {
+            continue;
+        }
+
+        player = userTable -> ids[i];
+
+        userDetector -> getProjectivePosition(player, 
+                                              XN_SKEL_LEFT_FOOT,
+                                              joint);
+        feet.push_back(Vector3D(joint.position));
+        feetOwner.push_back(player);
+
+        userDetector -> getProjectivePosition(player, 
+                                              XN_SKEL_RIGHT_FOOT,
+                                              joint);
+        feet.push_back(Vector3D(joint.position));
+        feetOwner.push_back(player);
+    }
+}
+
+
+/**
+ *  Removes the feet of the last frame, they have stomped.
+ */
+void SuperFiremanBrothers :: clearFeet ()
+{
+    feet.clear();
+    feetOwner.clear();
+}
+
 
 /**
  *  Method that controls the fireballs that are 
- *  going to be spawned per frames.
+ *  going to be spawned per frames. It is called in
+ *  every tick of the simulation clock.
  */
 void SuperFiremanBrothers :: nextFrame ()
 {
@@ -318,106 +513,103 @@ void SuperFiremanBrothers :: nextFrame ()
         return;
     }
 
-    static int counter = 0;
-    static int spawnRate = (SPAWN_RATE_FIRST_LEVEL) * players.size();
-    static float speedRate = (SPEED_RATE_FIRST_LEVEL) * players.size(); 
-    static int flamesInLevel = (FLAMES_IN_FIRST_LEVEL) * players.size();
-    const static int riseSpawnRate = (RISE_SPAWN_RATE) * players.size();
-    const static int riseSpeedRate = (RISE_SPEED_RATE) * players.size();
-    const static int riseFlamesInLevel = (RISE_FLAMES_IN_LEVEL) * players.size();
-
     int i;
     int j;
+    int k;
     int hp;
     float x;
     float y;
     Vector3D position;
 
-    vector <ZamusShoot> zShoot; 
-    vector <LinqSpawnIce> lShoot; 
+    // Zamus and Linq share the projectiles
+    ProjectileSystem *shoots = zamusDetector -> projectiles;
 
-    zShoot = zamusDetector -> shoots;
-    lShoot = linqDetector -> iceSpawn;
-        
-    UserGenerator  ugen;
-    DepthGenerator dgen;
-    map <XnUserID, int> :: iterator iter;
-    XnUserID  player;
-    XnSkeletonJointPosition joint;
-    XnPoint3D foots[2];
+    // The floor is the one of the current frame
+    floorLevel = userDetector -> retFrame() -> floorProjective.Y + 100;
 
-    ugen  = userDetector -> retUserGenerator();
-    dgen  = userDetector -> retDepthGenerator();
+    // The shoots of this frame in the grid, every flame only checks
+    // the shoots of the cells around it
+    shootPositions.clear();
 
-    for (i = 0; i < fireBalls.size(); i++) {
+    for (j = 0; j < shoots -> size(); j++) {
+        shootPositions.push_back(shoots -> retPosition(j));
+    }
 
-        for (j = 0; j < zShoot.size(); j++) {
-            if (fireBalls[i].isInBoundingBox(zShoot[j].position)) {
-                fireBalls[i].extinguish();
-                players[zShoot[j].player] += POINTS_PER_HIT;
-                zShoot.erase(zShoot.begin() + j);
-                j--;
-            }
+    projectileHit.assign(shootPositions.size(), false);
+    projectileGrid.build(shootPositions);
+
+    i = 0;
+    while (i < fireBalls.size()) {
+
+        // The shoots are checked in order, every hit shrinks the flame
+        candidates.clear();
+        projectileGrid.query(fireBalls[i].getPosition(), 
+                             fireBalls[i].boundingSize(), 
+                             candidates);
+        if (candidates.size() > 1) {
+            sort(candidates.begin(), candidates.end());
         }
 
-        for (j = 0; j < lShoot.size(); j++) {
-            if (fireBalls[i].isInBoundingBox(lShoot[j].position)) {
-                fireBalls[i].extinguish();
-                players[lShoot[j].player] += POINTS_PER_HIT;
-                lShoot.erase(lShoot.begin() + j);
-                j--;
+        for (j = 0; j < candidates.size(); j++) {
+            k = candidates[j];
+
+            if (projectileHit[k] || 
+                !fireBalls[i].isInBoundingBox(shootPositions[k])) {
+                continue;
             }
+
+            fireBalls[i].extinguish();
+            projectileHit[k] = true;
+            projectileGrid.remove(k);
+
+            addPoints(shoots -> retOwner(k), POINTS_PER_HIT);
         }
 
-        for (iter = players.begin(); iter != players.end(); iter++) {
-            player = iter -> first;
-            ugen.GetSkeletonCap().GetSkeletonJointPosition(player, 
-                                             XN_SKEL_RIGHT_FOOT,
-                                             joint);
-            foots[0] = joint.position;
-            ugen.GetSkeletonCap().GetSkeletonJointPosition(player, 
-                                             XN_SKEL_RIGHT_FOOT,
-                                             joint);
-            foots[1] = joint.position;
-            dgen.ConvertRealWorldToProjective(2, foots, foots);
-            if (fireBalls[i].isInBoundingBox(foots[0])) {
-                fireBalls[i].extinguish();
-                players[player] += POINTS_PER_HIT;
-                j--;
-            }
-            if (fireBalls[i].isInBoundingBox(foots[1])) {
+        for (j = 0; j < feet.size(); j++) {
+            if (fireBalls[i].isInBoundingBox(feet[j])) {
                 fireBalls[i].extinguish();
-                players[player] += POINTS_PER_HIT;
-                j--;
+                addPoints(feetOwner[j], POINTS_PER_HIT);
             }
-        }    
-
-        zamusDetector -> shoots  = zShoot;
-        linqDetector -> iceSpawn = lShoot;
+        }
 
         if (fireBalls[i].getZPos() > FIRE_LIMIT) {
+            removeHitProjectiles();
+            clearFeet();
             lostGame = true;
             return;
         }
+
+        // The last flame takes the place of an extinguished one, so it
+        // is checked next
+        if (!fireBalls[i].isAlive()) {
+            fireBalls.remove(i);
+        }
         else {
-            fireBalls[i].advance(speedRate);
+            fireBalls[i].advance(speedRate / SIM_TICKS_PER_STEP);
+            i++;
         }
-
     }
 
-    if ((counter == spawnRate) &&
-        (numFlames < flamesInLevel)){
-        x = (float)rand() / (float)RAND_MAX;
-        y = (float)rand() / (float)RAND_MAX;
+    removeHitProjectiles();
+
+    // The feet of the frame stomp only in this tick
+    clearFeet();
+
+    // The spawn rate is in steps, the counter in ticks
+    if ((counter == spawnRate * SIM_TICKS_PER_STEP) &&
+        (numFlames < flamesInLevel) &&
+        !fireBalls.isFull()) {
+        x = random.nextFloat();
+        y = random.nextFloat();
 
-        x = (rand() % 800) + x;
-        y = (rand() % 600) + y - floorLevel;
+        x = random.nextInt(800) + x;
+        y = random.nextInt(600) + y - floorLevel;
 
-        hp = rand() % 3 + 1;
+        hp = random.nextInt(3) + 1;
 
         position = Vector3D(x, y, -3500.0);
 
-        fireBalls.push_back(Flame(position, hp, flameModel.flame));
+        addFlame(position, hp);
         counter = 0;
         numFlames++;
     }
@@ -441,3 +633,49 @@ void SuperFiremanBrothers :: nextFrame ()
         printf("Level %d start!\n", level);
     }
 }
+
+
+/**
+ *  Adds a flame to the game.
+ *  @param position position of the flame.
+ *  @param hp life points of the flame.
+ *  @return false if there is no room for more flames.
+ */
+bool SuperFiremanBrothers :: addFlame (Vector3D position, int hp)
+{
+    float spin;
+
+    spin = random.nextFloat() * 360.0;
+
+    return fireBalls.add(Flame(position, hp, flameModel.flame, spin)) != -1;
+}
+
+
+/**
+ *  Starts the random numbers of the game with a seed.
+ *  @param seed seed of the game.
+ */
+void SuperFiremanBrothers :: setSeed (unsigned int seed)
+{
+    random.setSeed(seed);
+}
+
+
+/**
+ *  Removes all the flames of the game.
+ */
+void SuperFiremanBrothers :: clearFlames ()
+{
+    fireBalls.clear();
+}
+
+
+/**
+ *  Removes the shoots that hit a flame, keeping the order of the
+ *  others.
+ */
+void SuperFiremanBrothers :: removeHitProjectiles ()
+{
+    zamusDetector -> projectiles -> remove(projectileHit);
+    projectileHit.assign(projectileHit.size(), false);
+}
@@ -46,12 +46,14 @@
 # include "common.h"
 # include "config.h"
 # include "FlameModel.h"
-# include "ZamusShoot.h"
-# include "LinqSpawnIce.h"
+# include "ProjectileSystem.h"
 # include "Flame.h"
+# include "FlamePool.h"
+# include "Random.h"
 # include "Zamus.h"
 # include "Linq.h"
 # include "UserDetector.h"
+# include "SpatialGrid.h"
 
 /**
  *  @class SuperFiremanBrothers
@@ -77,13 +79,11 @@ class SuperFiremanBrothers
         /** 
          *  Constructor of the class.
          *  @param ud pointer to a User Detector type.
-         *  @param sa pointer to a Scene Analyzer type.
          *  @param zd pointer to Zamus Listener type.
          *  @ṕaram ld pointer to Linq Listener type.
          *  @param mp max numer of players allowed.
          */
         SuperFiremanBrothers(UserDetector *ud,
-                             SceneAnalyzer *sa,
                              Zamus *zd,
                              Linq *ld,
                              int mp);
@@ -121,6 +121,20 @@ class SuperFiremanBrothers
          *  @return game status.
          */
         int retGameStatus();
+
+        /**
+         *  Return the actual level of the game.
+         *  @return level.
+         */
+        int retLevel();
+
+        /**
+         *  Returns a checksum of the state of the game: level,
+         *  scores and flames. Two runs with the same seed and input
+         *  must give the same checksum.
+         *  @return checksum.
+         */
+        XnUInt32 retChecksum();
         
         /**
          *  Method that indicates if the game has started
@@ -136,12 +150,16 @@ class SuperFiremanBrothers
          */
         bool isGameOver();
 
-       
+
+# ifndef SFB_HEADLESS
+
         /**
          *  Method that draws the Fireballs of the game and 
          *  controls the vector of fireballs.
+         *  @param alpha part of a tick since the last one, the
+         *  flames are drawn between their last two positions.
          */
-        void drawFireBalls();
+        void drawFireBalls(float alpha);
 
         /**
          *  Draw the scores over the users in the game (openGL).
@@ -155,12 +173,42 @@ class SuperFiremanBrothers
          */
         void glPrintString(void *font, char *str);
 
+# endif
+
         /**
          *  Method that controls the fireballs that are 
-         *  going to be spawned per frames.
+         *  going to be spawned per frames. It is called in
+         *  every tick of the simulation clock.
          */
         void nextFrame();
 
+        /**
+         *  Reads the feet of the players in a new sensor frame. They
+         *  stomp the flames once, in the next tick, because they only
+         *  move with the frames.
+         */
+        void readFeet();
+
+        /**
+         *  Adds a flame to the game.
+         *  @param position position of the flame.
+         *  @param hp life points of the flame.
+         *  @return false if there is no room for more flames.
+         */
+        bool addFlame(Vector3D position, int hp);
+
+        /**
+         *  Starts the random numbers of the game with a seed, the
+         *  same seed and the same input give the same game.
+         *  @param seed seed of the game.
+         */
+        void setSeed(unsigned int seed);
+
+        /**
+         *  Removes all the flames of the game.
+         */
+        void clearFlames();
+
 
     private:
     
@@ -197,15 +245,19 @@ class SuperFiremanBrothers
          */
         FlameModel flameModel;
 
+# ifndef SFB_HEADLESS
+
         /**
-         * Pointer to the application user detector.
+         *  Batch where the flames and their shadows are drawn.
          */
-        UserDetector *userDetector;
+        FlameBatch flameBatch;
+
+# endif
 
         /**
-         *  Pointer to the Scene Analyzer.
+         * Pointer to the application user detector.
          */
-        SceneAnalyzer *sceneAnalyzer;
+        UserDetector *userDetector;
 
         /**
          *  Pointer to the application Zamus detector.
@@ -218,15 +270,20 @@ class SuperFiremanBrothers
         Linq *linqDetector;
 
         /**
-         *  Map of players of the game, maps users to
-         *  scores.
+         *  Table of the users, the players of the game and their
+         *  scores are in it. NULL if there is no user detector.
          */
-        map <XnUserID, int> players;
+        UserTable *userTable;
         
         /**
-         *  Vector of flames in the game.
+         *  Flames in the game.
          */
-        vector <Flame> fireBalls;
+        FlamePool fireBalls;
+
+        /**
+         *  Random numbers of the game, for the flames.
+         */
+        Random random;
 
         /**
          *  Indicates if game lost.
@@ -254,6 +311,94 @@ class SuperFiremanBrothers
          */
         int numFlames;
 
+        /**
+         *  Frames since the last flame was spawned.
+         */
+        int counter;
+
+        /**
+         *  Frames between two flames in this level.
+         */
+        int spawnRate;
+
+        /**
+         *  Speed of the flames in this level.
+         */
+        float speedRate;
+
+        /**
+         *  Flames to be spawned in this level.
+         */
+        int flamesInLevel;
+
+        /**
+         *  Increments of the spawn rate, speed and flames in every
+         *  level.
+         */
+        int riseSpawnRate;
+        int riseSpeedRate;
+        int riseFlamesInLevel;
+
+        /**
+         *  Sets the spawn rate, speed and number of flames of the first
+         *  level, and how they rise in every level, for the players that
+         *  started the game.
+         */
+        void startLevels();
+
+        /**
+         *  Returns the number of players of the game.
+         *  @return number of players.
+         */
+        int numPlayers();
+
+        /**
+         *  Adds points to the score of a player.
+         *  @param player user ID of the player.
+         *  @param points points to be added.
+         */
+        void addPoints(XnUserID player, int points);
+
+        /**
+         *  Positions of the shoots of the frame, in the order of the
+         *  projectiles.
+         */
+        vector <Vector3D> shootPositions;
+
+        /**
+         *  Indicates which shoots hit a flame in the frame.
+         */
+        vector <bool> projectileHit;
+
+        /**
+         *  Broadphase of the collisions, the shoots of the frame.
+         */
+        SpatialGrid projectileGrid;
+
+        /**
+         *  Projective positions of the feet of the players in the
+         *  last frame, and the player of every foot. They are emptied
+         *  by the tick that uses them.
+         */
+        vector <Vector3D> feet;
+        vector <XnUserID> feetOwner;
+
+        /**
+         *  Shoots that may hit the flame being checked.
+         */
+        vector <int> candidates;
+
+        /**
+         *  Removes the shoots that hit a flame, keeping the order of
+         *  the others.
+         */
+        void removeHitProjectiles();
+
+        /**
+         *  Removes the feet of the last frame, they have stomped.
+         */
+        void clearFeet();
+
 };
 
 # endif
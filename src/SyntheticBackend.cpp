@@ -0,0 +1,355 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SyntheticBackend.cpp
+ *
+ *  @brief Implementation of the class SyntheticBackend.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "SyntheticBackend.h"
+
+/**
+ *  Constructor of the class.
+ *  @param players number of players, at most MAX_USERS.
+ */
+SyntheticBackend :: SyntheticBackend (int players)
+{
+    numPlayers  = (players > MAX_USERS) ? MAX_USERS : players;
+    frameNumber = 0;
+    frameID     = 0;
+    firstID     = 1;
+}
+
+
+/**
+ *  Starts the script again, the players leave the scene and
+ *  come back as new users.
+ */
+void SyntheticBackend :: rewind ()
+{
+    frameNumber = 0;
+    firstID += numPlayers;
+}
+
+
+/**
+ *  Starts the script again so the players can transform for
+ *  the new game.
+ */
+void SyntheticBackend :: gameOver ()
+{
+    rewind();
+}
+
+
+/**
+ *  Fills the next frame of the scripted players.
+ *  @param frame where the frame will be stored.
+ *  @param labels ignored, there is no label map.
+ *  @param image ignored, there is no camera image.
+ *  @return always true, the script never ends.
+ */
+bool SyntheticBackend :: readFrame (SensorFrame& frame, 
+                                    bool labels, 
+                                    bool image)
+{
+    int i;
+    int t;
+    Vector3D body;
+    SensorUser *user;
+
+    ProfileZone zone(PROFILE_ACQUIRE);
+
+    frameID++;
+    frame.frameID   = frameID;
+    frame.timestamp = ((XnUInt64) frameID * 1000000) / SYNTHETIC_FPS;
+    frame.numUsers  = 0;
+
+    frame.skeletons.clear();
+    frame.labels.clear();
+    frame.labelXRes = 0;
+    frame.labelYRes = 0;
+    frame.image.clear();
+    frame.imageXRes = 0;
+    frame.imageYRes = 0;
+
+    // The players come into the scene one after the other
+    for (i = 0; i < numPlayers; i++) {
+        t = frameNumber - i * SYNTHETIC_CALIBRATION / 2;
+        if (t < 0) {
+            continue;
+        }
+
+        body = bodyPosition(i);
+
+        user = &frame.users[frame.numUsers];
+        user -> id            = firstID + i;
+        user -> tracking      = t >= SYNTHETIC_CALIBRATION;
+        user -> com           = toRealWorld(body);
+        convertRealWorldToProjective(1, &user -> com, &user -> comProjective);
+
+        if (user -> tracking) {
+            buildPlayer(frame.skeletons.retSkeleton(frame.numUsers), 
+                        i, 
+                        t - SYNTHETIC_CALIBRATION);
+        }
+
+        frame.numUsers++;
+    }
+
+    // Flat floor one meter below the torso of the players
+    body = bodyPosition(0);
+    frame.floor.ptPoint.X = 0.0;
+    frame.floor.ptPoint.Y = -1000.0;
+    frame.floor.ptPoint.Z = body.z;
+    frame.floor.vNormal.X = 0.0;
+    frame.floor.vNormal.Y = 1.0;
+    frame.floor.vNormal.Z = 0.0;
+    convertRealWorldToProjective(1, 
+                                 &frame.floor.ptPoint, 
+                                 &frame.floorProjective);
+
+    frameNumber++;
+
+    return true;
+}
+
+
+/**
+ *  Builds the skeleton of a player for the current frame.
+ *  @param skeleton joints of the player.
+ *  @param slot slot of the player.
+ *  @param t frames since the player is tracked.
+ */
+void SyntheticBackend :: buildPlayer (SnapshotJoint *skeleton, int slot, int t)
+{
+    const float shoulderWidth = 180.0;
+    const float hipWidth      = 100.0;
+
+    int phase;
+    float angle;
+
+    Vector3D body;
+    Vector3D rs, ls;
+    Vector3D rUpper, rFore;
+    Vector3D lUpper, lFore;
+    Vector3D aim;
+
+    body = bodyPosition(slot);
+
+    // Trunk and legs do not move
+    setJoint(skeleton, XN_SKEL_TORSO, body);
+    setJoint(skeleton, XN_SKEL_NECK, Vector3D(body.x, body.y + 300, body.z));
+    setJoint(skeleton, XN_SKEL_HEAD, Vector3D(body.x, body.y + 500, body.z));
+
+    setJoint(skeleton, XN_SKEL_LEFT_HIP, 
+             Vector3D(body.x - hipWidth, body.y - 100, body.z));
+    setJoint(skeleton, XN_SKEL_LEFT_KNEE, 
+             Vector3D(body.x - hipWidth, body.y - 550, body.z));
+    setJoint(skeleton, XN_SKEL_LEFT_FOOT, 
+             Vector3D(body.x - hipWidth, body.y - 1000, body.z));
+    setJoint(skeleton, XN_SKEL_RIGHT_HIP, 
+             Vector3D(body.x + hipWidth, body.y - 100, body.z));
+    setJoint(skeleton, XN_SKEL_RIGHT_KNEE, 
+             Vector3D(body.x + hipWidth, body.y - 550, body.z));
+    setJoint(skeleton, XN_SKEL_RIGHT_FOOT, 
+             Vector3D(body.x + hipWidth, body.y - 1000, body.z));
+
+    // The left joints are the right arm of the poses, because the
+    // view is from backwards
+    rs = Vector3D(body.x - shoulderWidth, body.y + 300, body.z);
+    ls = Vector3D(body.x + shoulderWidth, body.y + 300, body.z);
+
+    // Sweeping aim used to shoot
+    angle = (float) t / SYNTHETIC_FPS;
+    aim = Vector3D(0.8 * sin(angle * 1.3), 0.8 + 0.5 * sin(angle * 0.7), -1.0);
+    aim.normalize();
+
+    // By default the arms are down
+    rUpper = Vector3D(0.0, -1.0, 0.0);
+    rFore  = Vector3D(0.0, -1.0, 0.0);
+    lUpper = Vector3D(0.0, -1.0, 0.0);
+    lFore  = Vector3D(0.0, -1.0, 0.0);
+
+    if (slot % 2 == 0) {
+        // Zamus
+        if (t < SYNTHETIC_ZAMUS_POSE * SYNTHETIC_FPS) {
+            // Transformation pose
+            rUpper = g_Vmz;
+            rFore  = g_Vy;
+            lUpper = g_Vmz;
+            lFore  = g_Vmz;
+        }
+        else {
+            phase = t % (12 * SYNTHETIC_FPS);
+            if (phase < SYNTHETIC_FPS) {
+                // Buster activation pose
+                rUpper = g_Vmz;
+                rFore  = g_Vmz;
+                lUpper = g_Vmz;
+                lFore  = g_Vmx;
+            }
+            else {
+                // Shoot with the arm straight
+                rUpper = aim;
+                rFore  = aim;
+            }
+        }
+    }
+    else {
+        // Linq
+        if (t < SYNTHETIC_FPS) {
+            // First pose, right arm to the side
+            rUpper = g_Vmx;
+            rFore  = g_Vmx;
+        }
+        else if (t < 2 * SYNTHETIC_FPS) {
+            // Second pose, both arms to the sides
+            rUpper = g_Vmx;
+            rFore  = g_Vmx;
+            lUpper = g_Vx;
+            lFore  = g_Vx;
+        }
+        else if (t < 3 * SYNTHETIC_FPS) {
+            // Third pose, hands together over the head
+            rUpper = g_Vmx + g_Vy;
+            rFore  = g_Vx + g_Vy;
+            lUpper = g_Vx + g_Vy;
+            lFore  = g_Vmx + g_Vy;
+            rUpper.normalize();
+            rFore.normalize();
+            lUpper.normalize();
+            lFore.normalize();
+        }
+        else {
+            // Ice rod, bend the arm to charge and straight to invoke
+            phase = t % (SYNTHETIC_FPS + SYNTHETIC_FPS / 3);
+            if (phase < SYNTHETIC_FPS / 2) {
+                rUpper = g_Vmz;
+                rFore  = Vector3D(0.0, 1.0, 0.3);
+                rFore.normalize();
+            }
+            else {
+                rUpper = aim;
+                rFore  = aim;
+            }
+        }
+    }
+
+    setArm(skeleton, XN_SKEL_LEFT_SHOULDER, XN_SKEL_LEFT_ELBOW, 
+           XN_SKEL_LEFT_HAND, rs, rUpper, rFore);
+    setArm(skeleton, XN_SKEL_RIGHT_SHOULDER, XN_SKEL_RIGHT_ELBOW, 
+           XN_SKEL_RIGHT_HAND, ls, lUpper, lFore);
+}
+
+
+/**
+ *  Sets the joints of an arm.
+ *  @param skeleton joints of the player.
+ *  @param shoulder shoulder joint of the arm.
+ *  @param elbow elbow joint of the arm.
+ *  @param hand hand joint of the arm.
+ *  @param shoulderPos position of the shoulder.
+ *  @param upper direction from the shoulder to the elbow.
+ *  @param fore direction from the elbow to the hand.
+ */
+void SyntheticBackend :: setArm (SnapshotJoint *skeleton,
+                                XnSkeletonJoint shoulder,
+                                XnSkeletonJoint elbow,
+                                XnSkeletonJoint hand,
+                                Vector3D shoulderPos,
+                                Vector3D upper,
+                                Vector3D fore)
+{
+    const float upperLength = 300.0;
+    const float foreLength  = 280.0;
+
+    Vector3D elbowPos;
+    Vector3D handPos;
+    Vector3D bone;
+
+    bone     = upper * upperLength;
+    elbowPos = shoulderPos + bone;
+    bone     = fore * foreLength;
+    handPos  = elbowPos + bone;
+
+    setJoint(skeleton, shoulder, shoulderPos);
+    setJoint(skeleton, elbow, elbowPos);
+    setJoint(skeleton, hand, handPos);
+}
+
+
+/**
+ *  Sets the real world and projective position of a joint.
+ *  @param skeleton joints of the player.
+ *  @param joint joint to be set.
+ *  @param position real world position of the joint.
+ */
+void SyntheticBackend :: setJoint (SnapshotJoint *skeleton,
+                                  XnSkeletonJoint joint,
+                                  Vector3D position)
+{
+    SnapshotJoint *snapshot;
+
+    snapshot = &skeleton[SkeletonSnapshot :: jointIndex(joint)];
+
+    snapshot -> real       = toRealWorld(position);
+    convertRealWorldToProjective(1, 
+                                 &snapshot -> real, 
+                                 &snapshot -> projective);
+    snapshot -> confidence = 1.0;
+}
+
+
+/**
+ *  Returns the position of the body of a player.
+ *  @param slot slot of the player.
+ *  @return real world position of the torso.
+ */
+Vector3D SyntheticBackend :: bodyPosition (int slot)
+{
+    return Vector3D((slot - (numPlayers - 1) / 2.0) * 700.0, 0.0, 2200.0);
+}
+
+
+/**
+ *  Converts a vector to a real world point.
+ *  @param real real world vector.
+ *  @return real world point.
+ */
+XnPoint3D SyntheticBackend :: toRealWorld (Vector3D real)
+{
+    XnPoint3D point;
+
+    point.X = real.x;
+    point.Y = real.y;
+    point.Z = real.z;
+
+    return point;
+}
@@ -0,0 +1,185 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file SyntheticBackend.h
+ *
+ *  @brief Header file for the class SyntheticBackend.
+ *
+ *  This file contains the definition of a sensor backend that plays
+ *  scripted players, used to run the game without the Kinect.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef SYNTHETIC_BACKEND_H
+# define SYNTHETIC_BACKEND_H
+
+# include "common.h"
+# include "config.h"
+# include "SensorBackend.h"
+
+/**
+ *  Frames per second of the synthetic sensor.
+ */
+# define SYNTHETIC_FPS 30
+
+/**
+ *  Frames that a new player waits before his skeleton is tracked,
+ *  like the calibration of the sensor.
+ */
+# define SYNTHETIC_CALIBRATION 30
+
+/**
+ *  Seconds that a scripted Zamus holds the transformation pose,
+ *  longer than the hold time of the pose in the poses file.
+ */
+# define SYNTHETIC_ZAMUS_POSE 5.0
+
+/**
+ *  @class SyntheticBackend
+ *
+ *  @brief Sensor backend of scripted players.
+ *
+ *  The players of even slots play Zamus and the ones of odd slots play
+ *  Linq. Every player appears, gets calibrated, does the
+ *  transformation poses and then keeps shooting with a sweeping aim,
+ *  so the whole game logic is exercised. The joints are built in real
+ *  world coordinates and projected with the default pinhole camera of
+ *  the SensorBackend.
+ *
+ *  @see SensorBackend
+ */
+class SyntheticBackend : public SensorBackend
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         *  @param players number of players, at most MAX_USERS.
+         */
+        SyntheticBackend(int players);
+
+        /**
+         *  Class destructor.
+         */
+        ~SyntheticBackend() {}
+
+        /**
+         *  Fills the next frame of the scripted players.
+         *  @param frame where the frame will be stored.
+         *  @param labels ignored, there is no label map.
+         *  @param image ignored, there is no camera image.
+         *  @return always true, the script never ends.
+         */
+        bool readFrame(SensorFrame& frame, bool labels, bool image);
+
+        /**
+         *  Starts the script again, the players leave the scene and
+         *  come back as new users.
+         */
+        void rewind();
+
+        /**
+         *  Starts the script again so the players can transform for
+         *  the new game.
+         */
+        void gameOver();
+
+    private:
+
+        /**
+         *  Number of scripted players.
+         */
+        int numPlayers;
+
+        /**
+         *  Frames produced since the start of the script.
+         */
+        int frameNumber;
+
+        /**
+         *  Total frames produced, used as frame ID and clock.
+         */
+        XnUInt32 frameID;
+
+        /**
+         *  ID given to the first player of the script.
+         */
+        XnUserID firstID;
+
+        /**
+         *  Builds the skeleton of a player for the current frame.
+         *  @param skeleton joints of the player.
+         *  @param slot slot of the player.
+         *  @param t frames since the player is tracked.
+         */
+        void buildPlayer(SnapshotJoint *skeleton, int slot, int t);
+
+        /**
+         *  Sets the joints of an arm.
+         *  @param skeleton joints of the player.
+         *  @param shoulder shoulder joint of the arm.
+         *  @param elbow elbow joint of the arm.
+         *  @param hand hand joint of the arm.
+         *  @param shoulderPos position of the shoulder.
+         *  @param upper direction from the shoulder to the elbow.
+         *  @param fore direction from the elbow to the hand.
+         */
+        void setArm(SnapshotJoint *skeleton,
+                    XnSkeletonJoint shoulder,
+                    XnSkeletonJoint elbow,
+                    XnSkeletonJoint hand,
+                    Vector3D shoulderPos,
+                    Vector3D upper,
+                    Vector3D fore);
+
+        /**
+         *  Sets the real world and projective position of a joint.
+         *  @param skeleton joints of the player.
+         *  @param joint joint to be set.
+         *  @param position real world position of the joint.
+         */
+        void setJoint(SnapshotJoint *skeleton,
+                      XnSkeletonJoint joint,
+                      Vector3D position);
+
+        /**
+         *  Returns the position of the body of a player.
+         *  @param slot slot of the player.
+         *  @return real world position of the torso.
+         */
+        Vector3D bodyPosition(int slot);
+
+        /**
+         *  Converts a vector to a real world point.
+         *  @param real real world vector.
+         *  @return real world point.
+         */
+        static XnPoint3D toRealWorld(Vector3D real);
+};
+
+# endif
@@ -0,0 +1,157 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ *  @file TripleBuffer.h
+ *
+ *  @brief Header file for the template class TripleBuffer.
+ *
+ *  This file contains the definition of a lock-free triple buffer used
+ *  to hand the sensor frames from the capture thread to the game loop.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef TRIPLE_BUFFER_H
+# define TRIPLE_BUFFER_H
+
+/**
+ *  @class TripleBuffer
+ *
+ *  @brief Lock-free single producer, single consumer triple buffer.
+ *
+ *  The producer always owns the back slot and the consumer always owns
+ *  the front slot, the third slot is exchanged atomically between them.
+ *  The producer never waits for the consumer and the consumer always
+ *  gets the newest complete element, older elements that were never
+ *  read are simply overwritten.
+ *
+ *  @see SensorThread
+ */
+template <class T>
+class TripleBuffer
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        TripleBuffer()
+        {
+            front  = 0;
+            middle = 1;
+            back   = 2;
+        }
+
+        /**
+         *  Class destructor.
+         */
+        ~TripleBuffer() {}
+
+        /**
+         *  Returns the slot owned by the producer. It can be written
+         *  freely until publish() is called.
+         *  @return slot to be written.
+         */
+        T& writeBuffer()
+        {
+            return slots[back];
+        }
+
+        /**
+         *  Publish the back slot as the newest complete element and
+         *  take the old middle slot as the new back slot.
+         */
+        void publish()
+        {
+            int old;
+
+            // Make the writes of the slot visible before the exchange.
+            __sync_synchronize();
+            old  = __sync_lock_test_and_set(&middle, back | FRESH);
+            back = old & INDEX;
+        }
+
+        /**
+         *  Takes the newest published element if there is one. It never
+         *  blocks.
+         *  @return true if a new element is now in the front slot.
+         */
+        bool update()
+        {
+            int old;
+
+            if ((middle & FRESH) == 0) {
+                return false;
+            }
+
+            old   = __sync_lock_test_and_set(&middle, front);
+            front = old & INDEX;
+
+            return true;
+        }
+
+        /**
+         *  Returns the slot owned by the consumer.
+         *  @return newest element taken by update().
+         */
+        const T& readBuffer() const
+        {
+            return slots[front];
+        }
+
+    private:
+
+        /**
+         *  Masks used to encode the middle slot, the lower bits are the
+         *  slot index and FRESH indicates that it has not been read.
+         */
+        enum masks {
+            INDEX = 3,
+            FRESH = 4
+        };
+
+        /**
+         *  The three slots.
+         */
+        T slots[3];
+
+        /**
+         *  Index of the slot owned by the consumer.
+         */
+        int front;
+
+        /**
+         *  Index of the exchanged slot and its fresh flag.
+         */
+        volatile int middle;
+
+        /**
+         *  Index of the slot owned by the producer.
+         */
+        int back;
+};
+
+# endif
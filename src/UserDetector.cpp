@@ -39,184 +39,35 @@
 
 # include "UserDetector.h"
 
-/**
- *  Function used to cast void* to UserDetector* object
- *  @param object object to be cast.
- */
-static UserDetector* cast(void* object) 
-{
-    return static_cast<UserDetector *>(object);
-}
-
-/**
- *  Method that calls the equivalent new user callback function 
- *  for the user detector introduced.
- *  @param gen reference to an user generator.
- *  @param userID user ID of the current user.
- *  @param userDet current passed user detector.
- */
-
-static void XN_CALLBACK_TYPE c_NewUser(UserGenerator& gen, 
-                                       XnUserID userID, 
-                                       void *userDet)
-{
-    cast(userDet) -> newUser(userID);
-}
-
-
-/**
- *  Method that calls the equivalent lost user callback function 
- *  for the user detector introduced.
- *  @param gen reference to an user generator.
- *  @param userID user ID of the current user.
- *  @param userDet current passed user detector.
- */
-static void XN_CALLBACK_TYPE c_LostUser(UserGenerator& gen, 
-                                        XnUserID userID, 
-                                        void *userDet)
-{
-    cast(userDet) -> lostUser(userID);
-}
-
-/**
- *  Method that calls the equivalent start calibration callback function 
- *  for the user detector introduced.
- *  @param skeleton reference to a skeleton capability type (OpenNI).
- *  @param userID user ID of the current user.
- *  @param userDet current passed user detector.
- */
-static void XN_CALLBACK_TYPE c_StartCalibration(SkeletonCapability& skeleton, 
-                                                XnUserID userID, 
-                                                void *userDet)
-{
-    cast(userDet) -> startCalibration(userID);
-}
-
-/**
- *  Method that calls the equivalent end calibration callback function 
- *  for the user detector introduced.
- *  @param skeleton reference to a skeleton capability type (OpenNI).
- *  @param userID user ID of the current user.
- *  @param success boolean that indicates the calibration success.
- *  @param userDet current passed user detector.
- */
-static void XN_CALLBACK_TYPE c_EndCalibration(SkeletonCapability& skeleton, 
-                                              XnUserID userID, 
-                                              XnBool success,
-                                              void *userDet)
-{
-    cast(userDet) -> endCalibration(userID, success);
-}
-
-/**
- *  Method that calls the equivalent pose detection callback function 
- *  for the user detector introduced.
- *  @param pose reference to a pose capability type (OpenNI).
- *  @param poseName array where the pose name will be stored.
- *  @param userID user ID of the current user.
- *  @param userDet current passed user detector.
- */
-static void XN_CALLBACK_TYPE c_PoseDetected(PoseDetectionCapability &pose,
-                                            const XnChar *poseName, 
-                                            XnUserID userID,
-                                            void *userDet)
-{
-    cast(userDet) -> poseDetected(poseName, userID);
-}
-
-
 /**
  *  Constructor of the class.
  */
 UserDetector :: UserDetector()
 {
-    memset(strPose, '\0', sizeof(strPose) * sizeof(char));
-    userGenerator = NULL;
-    depthGenerator = NULL;
     listener = vector<UserListener *>();
-    usersTracked = map <XnUserID, int>();
-    userHandle = NULL;
-    userPoseHandle = NULL;
-    userSkelHandle = NULL;
-    needPose = false;
+    userTable.clear();
     stopDetection = false;
+    backend = NULL;
+    frame = NULL;
+    recorder = NULL;
+    numTrackedSlots = 0;
 }
 
 
 /**
  *  Constructor of the class.
- *  @param userGen reference to a OpenNI user generator class.
- *  @param depthGen reference to a OpenNI depth generator class.
+ *  @param sensor backend that gives the frames, it is told
+ *  when the detection of new users must stop.
  */
-UserDetector :: UserDetector(UserGenerator& userGen, DepthGenerator& depthGen)
+UserDetector :: UserDetector(SensorBackend *sensor)
 {
-    memset(strPose, '\0', sizeof(strPose) * sizeof(char));
-    userGenerator = userGen;
-    depthGenerator = depthGen;
     listener = vector<UserListener *>(); 
-    usersTracked = map <XnUserID, int>();
-    userHandle = NULL;
-    userPoseHandle = NULL;
-    userSkelHandle = NULL;
-    needPose = false;
+    userTable.clear();
     stopDetection = false;
-}
-
-
-/** 
- *  Method that register the callbacks relative to user
- *  interaction with the Kinect (new user, calibrate user, etc).
- */
-void UserDetector :: registerCallbacks() 
-{
-
-    // Register user handling functions
-    userGenerator.RegisterUserCallbacks(
-        c_NewUser, 
-        c_LostUser, 
-        this, 
-        userHandle
-    );
-    
-    // Skeleton handling callbacks
-    userGenerator.GetSkeletonCap().RegisterCalibrationCallbacks(
-        c_StartCalibration, 
-        c_EndCalibration, 
-        this, 
-        userSkelHandle
-    );
-
-    // If calibration pose needed
-    if (userGenerator.GetSkeletonCap().NeedPoseForCalibration()) {
-        needPose = true;
-
-        // Checking capability for pose
-        if (!userGenerator.IsCapabilitySupported(
-            XN_CAPABILITY_POSE_DETECTION)) 
-        {
-            printf("Pose required, but not supported\n");
-            exit(EXIT_FAILURE);
-        }
-        
-        // Getting pose 
-        userGenerator.GetSkeletonCap().GetCalibrationPose(strPose);
-
-        // Register pose callback
-        userGenerator.GetPoseDetectionCap().RegisterToPoseCallbacks(
-            c_PoseDetected, 
-            NULL, 
-            this,
-            userPoseHandle
-        );
-    }
-    else {
-        memset(strPose, '\0', sizeof(strPose));
-        userPoseHandle = NULL;
-    }
-
-    // Detect a skeleton with all joins
-    userGenerator.GetSkeletonCap().SetSkeletonProfile(XN_SKEL_PROFILE_ALL);
-    
+    backend = sensor;
+    frame = NULL;
+    recorder = NULL;
+    numTrackedSlots = 0;
 }
 
 
@@ -237,36 +88,95 @@ void UserDetector :: addListener(UserListener *newListener)
     }
 
 }
-
-
 /**
- *  Callback function called when the calibration of an user
- *  starts.
- *  @param userID user ID of the user to be calibrated.
+ *  Takes a new sensor frame, the users that appeared, started
+ *  being tracked or were lost since the last frame are
+ *  handled here, in the game loop thread.
+ *  @param newFrame pointer to the new sensor frame.
  */
-void UserDetector :: initCalibration(XnUserID userID) 
+void UserDetector :: updateFrame(const SensorFrame *newFrame)
 {
-    // Check pose
-    if(needPose) {
-        printf("Start Pose Detection\n");
-        userGenerator.GetPoseDetectionCap().StartPoseDetection(
-            strPose,
-            userID
-        );
+    int i;
+    int slot;
+    unsigned int j;
+    bool listened;
+    bool wasTracking;
+    bool seen[USER_SLOTS];
+    int stages[MAX_USERS];
+    const SensorUser *user;
+
+    frame = newFrame;
+
+    // The users lost in the last frame were already seen by the game
+    userTable.releaseLost();
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        seen[i] = false;
     }
-    else {
-        userGenerator.GetSkeletonCap().RequestCalibration(userID, true);
+
+    numTrackedSlots = 0;
+
+    for (i = 0; i < frame -> numUsers; i++) {
+        user = &frame -> users[i];
+        slot = userTable.findSlot(user -> id);
+
+        if (slot == -1) {
+            slot = userTable.addUser(user -> id);
+            if (slot == -1) {
+                continue;
+            }
+            newUser(user -> id);
+        }
+
+        wasTracking = userTable.tracking[slot];
+        userTable.tracking[slot] = user -> tracking;
+        seen[slot] = true;
+
+        if (user -> tracking) {
+            trackedSlots[numTrackedSlots++] = slot;
+        }
+
+        // The calibration succeded in the sensor thread
+        if (user -> tracking && !wasTracking) {
+
+            listened = false;
+            for (j = 0; j < listener.size(); j++) {
+                listened = listened || listener[j] -> isListened(user -> id);
+            }
+
+            if (!listened && !userTable.tracked[slot]) {
+                userTable.tracked[slot] = true;
+                userTable.stage[slot]   = NO_LISTENED;
+            }
+        }
+    }
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (userTable.used[i] && !seen[i]) {
+            lostUser(userTable.ids[i]);
+            userTable.markLost(i);
+        }
+    }
+
+    // The features of the poses, once for all the detectors
+    g_PoseLibrary.computeFeatures(frame);
+
+    if (recorder != NULL) {
+        for (i = 0; i < frame -> numUsers; i++) {
+            stages[i] = userStage(frame -> users[i].id);
+        }
+        recorder -> record(frame, stages);
     }
 }
 
 
 /**
- *  Callback function called when new user appears.
+ *  Function called when new user appears.
  *  @param userID user ID of the new user.
  */
 void UserDetector :: newUser(XnUserID userID)
 {
-    int i, j;
+    int i;
 
     if (stopDetection) {
         return;
@@ -280,13 +190,11 @@ void UserDetector :: newUser(XnUserID userID)
             break;
         }
     }
-
-    initCalibration(userID);        
 }
 
 
 /**
- *  Callback function called when an user is lost.
+ *  Function called when an user is lost.
  *  @param userID user ID of the user lost.
  */
 void UserDetector :: lostUser(XnUserID userID)
@@ -310,117 +218,199 @@ void UserDetector :: lostUser(XnUserID userID)
         remTrackedUser(userID);
     }
 }
+/**
+ *  Returns the current sensor frame.
+ *  @return current sensor frame, NULL if there is none.
+ */
+const SensorFrame* UserDetector :: retFrame()
+{
+    return frame;
+}
 
 
 /**
- *  Callback function called when thecalibration for a 
- *  detected user begins.
- *  @param user ID of the user to be calibrated.
+ *  Returns the table with the state of the users.
+ *  @return table of the users.
  */
-void UserDetector :: startCalibration(XnUserID userID)
+UserTable* UserDetector :: retUserTable()
 {
-    printf("Calibration start user %d\n", userID);
+    return &userTable;
 }
 
 
 /**
- *  Callback function called when calibration of the 
- *  user ends.
- *  @param userID user ID of the user calibrated.
- *  @param success indicates if the calibration succeded or not.
+ *  Returns the slot of an user in the current frame.
+ *  @param userID user ID of the user.
+ *  @return slot of the user, -1 if it is not in the frame.
  */
-void UserDetector :: endCalibration(XnUserID userID, 
-                                    XnBool success)
+int UserDetector :: findUser(XnUserID userID)
 {
-    printf("Calibration for user %d %s\n", 
-        userID, success ? "Succeded" : "Failed");
-
-    // On calibration succeded
-    if(success) {
-        userGenerator.GetSkeletonCap().StartTracking(userID);
-        usersTracked.insert(pair <XnUserID, int> (userID, NO_LISTENED));
-    }    
-    else {
-        initCalibration(userID);
+    int i;
+
+    if (frame == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < frame -> numUsers; i++) {
+        if (frame -> users[i].id == userID) {
+            return i;
+        }
     }
+
+    return -1;
 }
 
 
 /**
- *  Callback function called when a new pose is detected.
- *  @param poseName name of the pose detected.
- *  @param userID user ID of the user that made the pose.
+ *  Indicates if the skeleton of an user is being tracked in
+ *  the current frame.
+ *  @param userID user ID of the user to be checked.
+ *  @return true if the skeleton is tracked, false otherwise.
  */
-void UserDetector :: poseDetected(const XnChar *poseName, 
-                                  XnUserID userID)
+bool UserDetector :: isSkeletonTracking(XnUserID userID)
 {
-    printf("Pose %s detected for user %d\n", poseName, userID);
+    int slot;
 
-    // Stop pose detection
-    userGenerator.GetPoseDetectionCap().StopPoseDetection(userID);
+    slot = findUser(userID);
 
-    // Request calibration
-    userGenerator.GetSkeletonCap().RequestCalibration(userID, true);
+    return (slot != -1) && frame -> users[slot].tracking;
 }
 
 
 /**
- *  Returns the name of the pose.
- *  @return string name of the pose.
+ *  Returns the skeleton of an user in the current frame.
+ *  @param userID user ID of the user.
+ *  @return pointer to the SNAPSHOT_JOINTS joints of the user, NULL if
+ *  the user is not tracked.
  */
-char* UserDetector :: retPoseStr()
+const SnapshotJoint* UserDetector :: retSkeleton(XnUserID userID)
 {
-    return strPose;
+    int slot;
+
+    slot = findUser(userID);
+
+    if ((slot == -1) || !frame -> users[slot].tracking) {
+        return NULL;
+    }
+
+    return frame -> skeletons.retSkeleton(slot);
 }
 
 
 /**
- *  Returns the user handler of callbacks.
- *  @return user handle.
+ *  Returns the position of a joint of an user in the current
+ *  frame. The confidence is zero if the user is not tracked.
+ *  @param userID user ID of the user.
+ *  @param joint joint to be returned.
+ *  @param position where the joint position will be stored.
  */
-XnCallbackHandle UserDetector :: retUserHandle()
+void UserDetector :: getJointPosition(XnUserID userID, 
+                                      XnSkeletonJoint joint,
+                                      XnSkeletonJointPosition& position)
 {
-    return userHandle;
+    const SnapshotJoint *skeleton;
+
+    skeleton = retSkeleton(userID);
+
+    if (skeleton != NULL) {
+        skeleton += SkeletonSnapshot::jointIndex(joint);
+        position.position    = skeleton -> real;
+        position.fConfidence = skeleton -> confidence;
+    }
+    else {
+        memset(&position, 0, sizeof(position));
+    }
 }
 
 
 /**
- *  Returns the user pose handler of callbacks.
- *  @return user pose handler.
+ *  Returns the position of a joint of an user in the current
+ *  frame in projective coordinates. The confidence is zero if the
+ *  user is not tracked.
+ *  @param userID user ID of the user.
+ *  @param joint joint to be returned.
+ *  @param position where the joint position will be stored.
  */
-XnCallbackHandle UserDetector :: retUserPoseHandle()
+void UserDetector :: getProjectivePosition(XnUserID userID, 
+                                           XnSkeletonJoint joint,
+                                           XnSkeletonJointPosition& position)
 {
-    return userPoseHandle;
-}       
+    const SnapshotJoint *skeleton;
+
+    skeleton = retSkeleton(userID);
+
+    if (skeleton != NULL) {
+        skeleton += SkeletonSnapshot::jointIndex(joint);
+        position.position    = skeleton -> projective;
+        position.fConfidence = skeleton -> confidence;
+    }
+    else {
+        memset(&position, 0, sizeof(position));
+    }
+}
 
 
 /**
- *  Returns the user skeleton handler of callbacks.
- *  @return user skeleton handler.
+ *  Returns the center of mass of an user in the current frame.
+ *  @param userID user ID of the user.
+ *  @param com where the center of mass will be stored.
  */
-XnCallbackHandle UserDetector :: retUserSkelHandle()
+void UserDetector :: getCoM(XnUserID userID, XnPoint3D& com)
 {
-    return userSkelHandle;
-}     
+    int slot;
+
+    slot = findUser(userID);
+
+    if (slot != -1) {
+        com = frame -> users[slot].com;
+    }
+    else {
+        memset(&com, 0, sizeof(com));
+    }
+}
 
 
 /**
- *  Returns the user generator.
- *  @return user generator.
+ *  Returns the center of mass of an user in the current frame in
+ *  projective coordinates.
+ *  @param userID user ID of the user.
+ *  @param com where the center of mass will be stored.
  */
-UserGenerator UserDetector :: retUserGenerator ()
+void UserDetector :: getProjectiveCoM(XnUserID userID, XnPoint3D& com)
 {
-    return userGenerator;
+    int slot;
+
+    slot = findUser(userID);
+
+    if (slot != -1) {
+        com = frame -> users[slot].comProjective;
+    }
+    else {
+        memset(&com, 0, sizeof(com));
+    }
 }
 
 
 /**
- *  Returns depth generator.
- *  @param depth generator.
+ *  Returns the users in the current frame.
+ *  @param usersIDs array where the user IDs will be stored.
+ *  @param numUsers size of the array, it returns the number of
+ *  users.
  */
-DepthGenerator UserDetector :: retDepthGenerator ()
+void UserDetector :: getUsers(XnUserID *usersIDs, XnUInt16& numUsers)
 {
-    return depthGenerator;
+    int i;
+    int n;
+
+    n = 0;
+
+    if (frame != NULL) {
+        for (i = 0; (i < frame -> numUsers) && (n < numUsers); i++) {
+            usersIDs[n++] = frame -> users[i].id;
+        }
+    }
+
+    numUsers = n;
 }
 
 
@@ -440,9 +430,15 @@ vector<UserListener *> UserDetector :: retUserListenerVector ()
  *  @return user current transformation stage.
  */
 int UserDetector :: retStage(XnUserID userID) {
-    if (usersTracked.count(userID) == 1) {
-        return usersTracked[userID];
+    int slot;
+
+    slot = userTable.findSlot(userID);
+
+    if ((slot != -1) && userTable.tracked[slot]) {
+        return userTable.stage[slot];
     }
+
+    return NO_LISTENED;
 }
 
 
@@ -453,7 +449,14 @@ int UserDetector :: retStage(XnUserID userID) {
  */
 void UserDetector :: changeStage(XnUserID userID, int stage) 
 {
-    usersTracked[userID] = stage;
+    int slot;
+
+    slot = userTable.findSlot(userID);
+
+    if (slot != -1) {
+        userTable.tracked[slot] = true;
+        userTable.stage[slot]   = stage;
+    }
 }
 
 
@@ -464,7 +467,11 @@ void UserDetector :: changeStage(XnUserID userID, int stage)
  */
 bool UserDetector ::  isTracked(XnUserID userID) 
 {
-    return (usersTracked.count(userID) == 1);
+    int slot;
+
+    slot = userTable.findSlot(userID);
+
+    return (slot != -1) && userTable.tracked[slot];
 }
 
 
@@ -474,7 +481,14 @@ bool UserDetector ::  isTracked(XnUserID userID)
  */
 void UserDetector :: remTrackedUser(XnUserID userID)
 {
-    usersTracked.erase(userID);
+    int slot;
+
+    slot = userTable.findSlot(userID);
+
+    if (slot != -1) {
+        userTable.tracked[slot] = false;
+        userTable.stage[slot]   = NO_LISTENED;
+    }
 }
 
 
@@ -484,7 +498,18 @@ void UserDetector :: remTrackedUser(XnUserID userID)
  */
 int UserDetector :: retNumUsersTracked() 
 {
-    return usersTracked.size();
+    int i;
+    int n;
+
+    n = 0;
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (userTable.used[i] && userTable.tracked[i]) {
+            n++;
+        }
+    }
+
+    return n;
 }
  
 
@@ -496,18 +521,15 @@ vector<XnUserID> UserDetector :: trackedUsers()
 {
     int i;
     
-    XnUserID currentUsers[MAX_USERS];
-    XnUInt16 numUsers;
-
     vector<XnUserID> userVec;
 
-    numUsers = MAX_USERS;
-
-    userGenerator.GetUsers(currentUsers, numUsers);
+    if (frame == NULL) {
+        return userVec;
+    }
 
-    for(i = 0; i < numUsers; i++) {
-        if(userGenerator.GetSkeletonCap().IsTracking(currentUsers[i]) ) {
-            userVec.push_back(currentUsers[i]);
+    for(i = 0; i < frame -> numUsers; i++) {
+        if(frame -> users[i].tracking) {
+            userVec.push_back(frame -> users[i].id);
         }
     }
     return userVec;
@@ -531,5 +553,49 @@ bool UserDetector :: retDetectionStat()
 void UserDetector :: changeStopDetection (bool value) 
 {
     stopDetection = value;
+
+    // The backend stops calibrating new users
+    if (backend != NULL) {
+        backend -> changeStopDetection(value);
+    }
+}
+
+
+/**
+ *  Changes the recorder of the frames, every new frame is
+ *  written to it with the stages of the users.
+ *  @param rec recorder to be used, NULL to stop recording.
+ */
+void UserDetector :: changeRecorder (SkeletonRecorder *rec) 
+{
+    recorder = rec;
+}
+
+
+/**
+ *  Returns the stage of an user, the transformation stage if
+ *  he is transforming or the one of his listener if he is
+ *  transformed.
+ *  @param userID user ID of the user.
+ *  @return stage of the user, NO_LISTENED if he has none.
+ */
+int UserDetector :: userStage (XnUserID userID) 
+{
+    int slot;
+    unsigned int i;
+
+    slot = userTable.findSlot(userID);
+
+    if ((slot != -1) && userTable.tracked[slot]) {
+        return userTable.stage[slot];
+    }
+
+    for (i = 0; i < listener.size(); i++) {
+        if (listener[i] -> isListened(userID)) {
+            return listener[i] -> retLisUserStage(userID);
+        }
+    }
+
+    return NO_LISTENED;
 }
 
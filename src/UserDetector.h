@@ -41,6 +41,11 @@
 
 # include "common.h"
 # include "UserListener.h"
+# include "SensorFrame.h"
+# include "SkeletonRecorder.h"
+# include "SensorBackend.h"
+# include "UserTable.h"
+# include "PoseLibrary.h"
 
 /**
  *  @class UserDetector
@@ -69,22 +74,16 @@ class UserDetector : private UserListener
 
        /**
         *  Constructor of the class.
-        *  @param userGen reference to a OpenNI user generator class.
-        *  @param depthGen reference to a OpenNI depth generator class.
+        *  @param sensor backend that gives the frames, it is told
+        *  when the detection of new users must stop.
         */
-        UserDetector(UserGenerator& userGen, DepthGenerator& depthGen);
+        UserDetector(SensorBackend *sensor);
         
         /**
          *  Class destructor.
          */
         ~UserDetector() {}
 
-        /** 
-         *  Method that register the callbacks relative to user
-         *  interaction with the Kinect (new user, calibrate user, etc).
-         */
-        void registerCallbacks();
-
         /**
          *  Adds a new listener type, listener types are used to 
          *  describe and implement behaviours of diferent user
@@ -92,85 +91,111 @@ class UserDetector : private UserListener
          *  types.
          */
         void addListener(UserListener *newListener);
-
+        
         /**
-         *  Callback function called when the calibration of an user
-         *  starts.
-         *  @param userID user ID of the user to be calibrated.
+         *  Takes a new sensor frame, the users that appeared, started
+         *  being tracked or were lost since the last frame are
+         *  handled here, in the game loop thread.
+         *  @param newFrame pointer to the new sensor frame.
          */
-         void initCalibration(XnUserID userID);
-        
+         void updateFrame(const SensorFrame *newFrame);
+
         /**
-         *  Callback function called when new user appears.
+         *  Function called when new user appears.
          *  @param userID user ID of the new user.
          */
          void newUser(XnUserID userID);
 
         /**
-         *  Callback function called when an user is lost.
+         *  Function called when an user is lost.
          *  @param userID user ID of the user lost.
          */
          void lostUser(XnUserID userID);
 
         /**
-         *  Callback function called when the calibration for a 
-         *  detected user begins.
-         *  @param user ID of the user to be calibrated.
+         *  Returns the current sensor frame.
+         *  @return current sensor frame, NULL if there is none.
          */
-         void startCalibration(XnUserID userID);
+        const SensorFrame* retFrame();
 
         /**
-         *  Callback function called when calibration of the 
-         *  user ends.
-         *  @param userID user ID of the user calibrated.
-         *  @param success indicates if the calibration succeded or not.
+         *  Returns the table with the state of the users.
+         *  @return table of the users.
          */
-         void endCalibration(XnUserID userID, 
-                             XnBool success);
+        UserTable* retUserTable();
 
         /**
-         *  Callback function called when a new pose is detected.
-         *  @param poseName name of the pose detected.
-         *  @param userID user ID of the user that made the pose.
+         *  Indicates if the skeleton of an user is being tracked in
+         *  the current frame.
+         *  @param userID user ID of the user to be checked.
+         *  @return true if the skeleton is tracked, false otherwise.
          */
-         void poseDetected(const XnChar *poseName, 
-                           XnUserID userID);
+        bool isSkeletonTracking(XnUserID userID);
 
         /**
-         *  Returns the name of the pose.
-         *  @return string name of the pose.
+         *  Returns the skeleton of an user in the current frame.
+         *  @param userID user ID of the user.
+         *  @return pointer to the SNAPSHOT_JOINTS joints of the user,
+         *  NULL if the user is not tracked.
          */
-        XnChar* retPoseStr();
+        const SnapshotJoint* retSkeleton(XnUserID userID);
 
         /**
-         *  Returns the user handler of callbacks.
-         *  @return user handle.
+         *  Returns the slot of an user in the current frame, the
+         *  index of his skeleton and his pose features.
+         *  @param userID user ID of the user.
+         *  @return slot of the user, -1 if he is not in the frame.
          */
-        XnCallbackHandle retUserHandle();
-  
+        int retSlot(XnUserID userID)
+        {
+            return findUser(userID);
+        }
+
+        /**
+         *  Returns the position of a joint of an user in the current
+         *  frame. The confidence is zero if the user is not tracked.
+         *  @param userID user ID of the user.
+         *  @param joint joint to be returned.
+         *  @param position where the joint position will be stored.
+         */
+        void getJointPosition(XnUserID userID, 
+                              XnSkeletonJoint joint,
+                              XnSkeletonJointPosition& position);
+
         /**
-         *  Returns the user pose handler of callbacks.
-         *  @return user pose handler.
+         *  Returns the position of a joint of an user in the current
+         *  frame in projective coordinates. The confidence is zero if
+         *  the user is not tracked.
+         *  @param userID user ID of the user.
+         *  @param joint joint to be returned.
+         *  @param position where the joint position will be stored.
          */
-        XnCallbackHandle retUserPoseHandle();
+        void getProjectivePosition(XnUserID userID, 
+                                   XnSkeletonJoint joint,
+                                   XnSkeletonJointPosition& position);
 
         /**
-         *  Returns the user skeleton handler of callbacks.
-         *  @return user skeleton handler.
+         *  Returns the center of mass of an user in the current frame.
+         *  @param userID user ID of the user.
+         *  @param com where the center of mass will be stored.
          */
-        XnCallbackHandle retUserSkelHandle();
+        void getCoM(XnUserID userID, XnPoint3D& com);
 
         /**
-         *  Returns the user generator.
-         *  @return user generator.
+         *  Returns the center of mass of an user in the current frame
+         *  in projective coordinates.
+         *  @param userID user ID of the user.
+         *  @param com where the center of mass will be stored.
          */
-        UserGenerator retUserGenerator(); 
+        void getProjectiveCoM(XnUserID userID, XnPoint3D& com);
 
         /**
-         *  Returns depth generator.
-         *  @param depth generator.
+         *  Returns the users in the current frame.
+         *  @param usersIDs array where the user IDs will be stored.
+         *  @param numUsers size of the array, it returns the number of
+         *  users.
          */
-        DepthGenerator retDepthGenerator(); 
+        void getUsers(XnUserID *usersIDs, XnUInt16& numUsers);
 
         /**
          *  Returns the user listener vector.
@@ -217,6 +242,26 @@ class UserDetector : private UserListener
          */
         vector<XnUserID> trackedUsers();
 
+        /**
+         *  Returns the number of users of the frame whose skeleton is
+         *  tracked, the users that the pose detectors check.
+         *  @return number of slots of retTrackedSlots().
+         */
+        int retNumTrackedSlots()
+        {
+            return numTrackedSlots;
+        }
+
+        /**
+         *  Returns the slots in the user table of the users of the
+         *  frame whose skeleton is tracked, in the order of the frame.
+         *  @return slots of the users.
+         */
+        const int* retTrackedSlots()
+        {
+            return trackedSlots;
+        }
+
         /**
          *  Returns the detection status parameter.
          *  @param detection status (detect, no detect).
@@ -230,24 +275,15 @@ class UserDetector : private UserListener
          */
         void changeStopDetection (bool value);
 
-    private: 
-    
-
-        /** 
-         *  String that contains the pose name.
-         */
-        XnChar strPose[20];
-
-        /** 
-         *  Current user generator.
-         */
-        UserGenerator userGenerator;
-
         /**
-         *  Current depth generator.
+         *  Changes the recorder of the frames, every new frame is
+         *  written to it with the stages of the users.
+         *  @param rec recorder to be used, NULL to stop recording.
          */
-        DepthGenerator depthGenerator;
+        void changeRecorder (SkeletonRecorder *rec);
 
+    private: 
+    
         /** 
          *  Vector of listeners, listeners are posible user
          *  transformations (zamus, linq).
@@ -255,36 +291,54 @@ class UserDetector : private UserListener
         vector<UserListener *> listener;
 
         /** 
-         *  User detection handler. 
+         *  Indicates when to stop the detection of users, the
+         *  detection of users must stop once the game is started.
          */
-        XnCallbackHandle userHandle;
+        bool stopDetection;
 
-        /** 
-         *  User pose handler.
+        /**
+         *  Backend that gives the frames, NULL if there is none.
          */
-        XnCallbackHandle userPoseHandle;
-        
-        /** 
-         *  User skeleton handler.
+        SensorBackend *backend;
+
+        /**
+         *  Current sensor frame.
          */
-        XnCallbackHandle userSkelHandle;
+        const SensorFrame *frame;
 
-        /** 
-         *  Indicates if pose is needed.
+        /**
+         *  Returns the slot of an user in the current frame.
+         *  @param userID user ID of the user.
+         *  @return slot of the user, -1 if it is not in the frame.
          */
-        XnBool needPose;
+        int findUser(XnUserID userID);
 
-        /** 
-         *  Indicates when to stop the detection of users, the
-         *  detection of users must stop once the game is started.
+        /**
+         *  Returns the stage of an user, the transformation stage if
+         *  he is transforming or the one of his listener if he is
+         *  transformed.
+         *  @param userID user ID of the user.
+         *  @return stage of the user, NO_LISTENED if he has none.
          */
-        bool stopDetection;
+        int userStage(XnUserID userID);
+
+        /**
+         *  Recorder of the frames, NULL if they are not recorded.
+         */
+        SkeletonRecorder *recorder;
   
         /**
-         *  Map of user being tracked, it indicates the stage 
-         *  in wich the users are when transforming.
+         *  State of the users, the users of the frame have a slot
+         *  in the table since they appear until they are lost.
+         */
+        UserTable userTable;
+
+        /**
+         *  Slots of the users of the frame whose skeleton is tracked,
+         *  it is computed once per frame for all the detectors.
          */
-        map <XnUserID, int> usersTracked;
+        int numTrackedSlots;
+        int trackedSlots[MAX_USERS];
        
 };
 # endif
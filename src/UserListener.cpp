@@ -43,7 +43,7 @@
 UserListener :: UserListener()
 {
     listenerType = -1;
-    usersListened = map <XnUserID, int> ();
+    userTable = NULL;
 }
 
 
@@ -54,7 +54,15 @@ UserListener :: UserListener()
  */
 bool UserListener :: isListened(XnUserID userID)
 {
-    return (usersListened.count(userID) == 1);
+    int slot;
+
+    if (userTable == NULL) {
+        return false;
+    }
+
+    slot = userTable -> findSlot(userID);
+
+    return (slot != -1) && (userTable -> listener[slot] == listenerType);
 }
 
 
@@ -67,9 +75,54 @@ bool UserListener :: isListened(XnUserID userID)
  */
 int UserListener :: retLisUserStage(XnUserID userID) 
 {
-    if (usersListened.count(userID) == 1) {
-        return usersListened[userID];
+    int slot;
+
+    if (!isListened(userID)) {
+        return NO_LISTENED;
     }
 
-    return NO_LISTENED;
+    slot = userTable -> findSlot(userID);
+
+    return userTable -> listenedStage[slot];
+}
+
+
+/**
+ *  Associates an user with the listener.
+ *  @param userID user ID of the user.
+ *  @param stage stage of the user in the listener.
+ */
+void UserListener :: addListened(XnUserID userID, int stage)
+{
+    int slot;
+
+    if (userTable == NULL) {
+        return;
+    }
+
+    slot = userTable -> findSlot(userID);
+
+    if (slot != -1) {
+        userTable -> listener[slot]      = listenerType;
+        userTable -> listenedStage[slot] = stage;
+    }
+}
+
+
+/**
+ *  Removes an user from the listener.
+ *  @param userID user ID of the user.
+ */
+void UserListener :: remListened(XnUserID userID)
+{
+    int slot;
+
+    if (!isListened(userID)) {
+        return;
+    }
+
+    slot = userTable -> findSlot(userID);
+
+    userTable -> listener[slot]      = NO_LISTENED;
+    userTable -> listenedStage[slot] = NO_LISTENED;
 }
@@ -41,6 +41,7 @@
     
 # include "common.h"
 # include "config.h"
+# include "UserTable.h"
 
 /**
  *  @class UserListener
@@ -75,10 +76,24 @@ class UserListener
         int listenerType;
         
         /** 
-         *  Map of users IDs and status of users associated 
-         *  with the listener.
+         *  Table of the users, the users associated with the
+         *  listener have its type in the table, NULL if the
+         *  listener has no users.
          */
-        map <XnUserID, int> usersListened;
+        UserTable *userTable;
+
+        /**
+         *  Associates an user with the listener.
+         *  @param userID user ID of the user.
+         *  @param stage stage of the user in the listener.
+         */
+        void addListened(XnUserID userID, int stage);
+
+        /**
+         *  Removes an user from the listener.
+         *  @param userID user ID of the user.
+         */
+        void remListened(XnUserID userID);
 
         /** 
          *  Function that indicates if a user is being listened
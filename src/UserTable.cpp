@@ -0,0 +1,206 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file UserTable.cpp
+ *
+ *  @brief Implementation file for the class UserTable.
+ *
+ *  This file contains the implementation of the functions and methods
+ *  of the class UserTable.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# include "UserTable.h"
+
+/**
+ *  Constructor of the class.
+ */
+UserTable :: UserTable ()
+{
+    clear();
+}
+
+/**
+ *  Frees all the slots and the pose timers.
+ */
+void UserTable :: clear ()
+{
+    int i;
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        resetSlot(i);
+    }
+
+    numPoseTimers = 0;
+    numActions    = 0;
+}
+
+/**
+ *  Returns the slot of an user.
+ *  @param userID user ID of the user.
+ *  @return slot of the user, -1 if he has none.
+ */
+int UserTable :: findSlot (XnUserID userID) const
+{
+    int i;
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (used[i] && (ids[i] == userID)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ *  Gives a free slot to a new user, with all his state
+ *  reset.
+ *  @param userID user ID of the new user.
+ *  @return slot of the user, -1 if the table is full.
+ */
+int UserTable :: addUser (XnUserID userID)
+{
+    int i;
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (!used[i]) {
+            resetSlot(i);
+            used[i] = true;
+            ids[i]  = userID;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ *  Marks the user of a slot as lost, the slot is freed in
+ *  releaseLost().
+ *  @param slot slot of the user.
+ */
+void UserTable :: markLost (int slot)
+{
+    lost[slot] = true;
+}
+
+/**
+ *  Frees the slots of the users marked as lost.
+ */
+void UserTable :: releaseLost ()
+{
+    int i;
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        if (lost[i]) {
+            resetSlot(i);
+        }
+    }
+}
+
+/**
+ *  Reserves a column of pose times for a pose detector.
+ *  @return index of the column, -1 if there are no more.
+ */
+int UserTable :: addPoseTimer ()
+{
+    int i;
+
+    if (numPoseTimers == MAX_POSE_TIMERS) {
+        return -1;
+    }
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        poseTime[numPoseTimers][i] = 0.0;
+    }
+
+    return numPoseTimers++;
+}
+
+/**
+ *  Reserves a column of action timers for an action
+ *  scheduler.
+ *  @return index of the column, -1 if there are no more.
+ */
+int UserTable :: addAction ()
+{
+    int i;
+
+    if (numActions == MAX_ACTIONS) {
+        return -1;
+    }
+
+    for (i = 0; i < USER_SLOTS; i++) {
+        readyTime[numActions][i]   = 0;
+        charging[numActions][i]    = false;
+        chargeStart[numActions][i] = 0;
+        chargeLast[numActions][i]  = 0;
+    }
+
+    return numActions++;
+}
+
+/**
+ *  Resets the state of a slot.
+ *  @param slot slot to be reset.
+ */
+void UserTable :: resetSlot (int slot)
+{
+    int i;
+
+    used[slot]     = false;
+    lost[slot]     = false;
+    ids[slot]      = 0;
+    tracking[slot] = false;
+
+    tracked[slot] = false;
+    stage[slot]   = NO_LISTENED;
+
+    listener[slot]      = NO_LISTENED;
+    listenedStage[slot] = NO_LISTENED;
+
+    busterStatus[slot]        = -1;
+    busterActivationMsg[slot] = false;
+
+    iceRodStatus[slot] = -1;
+
+    for (i = 0; i < MAX_POSE_TIMERS; i++) {
+        poseTime[i][slot] = 0.0;
+    }
+
+    for (i = 0; i < MAX_ACTIONS; i++) {
+        readyTime[i][slot]   = 0;
+        charging[i][slot]    = false;
+        chargeStart[i][slot] = 0;
+        chargeLast[i][slot]  = 0;
+    }
+
+    player[slot] = false;
+    score[slot]  = 0;
+}
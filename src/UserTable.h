@@ -0,0 +1,225 @@
+/**
+ * This application consist of a simple game that we called "Super Fireman Brothers". 
+ * This applications uses the XBox Kinect sensor to track the player's moves.
+ *
+ * Copyright (C) 2011 Alfonso Ros, Ismael Mendonca
+ *
+ * This file is part of Super Fireman Brothers.
+ *
+ * Super Fireman Brothers is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Super Fireman Brothers is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Super Fireman Brothers. Check the txt file "LICENSE",
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ *  @file UserTable.h
+ *
+ *  @brief Header file for the class UserTable.
+ *
+ *  This file contains the definition of the table with the state of
+ *  every user of the game, shared by the user detector, the listeners,
+ *  the pose detectors and the game.
+ *
+ *  @authors Alfonso Ros e Ismael Mendonça
+ *
+ */
+
+# ifndef USER_TABLE_H
+# define USER_TABLE_H
+
+# include "common.h"
+# include "config.h"
+
+/**
+ *  Number of slots of the table. The users lost in a frame keep their
+ *  slot until the next one, so there is room for the users of two
+ *  frames.
+ */
+# define USER_SLOTS (2 * MAX_USERS)
+
+/**
+ *  Number of pose detectors that can keep pose times in the table.
+ */
+# define MAX_POSE_TIMERS 8
+
+/**
+ *  Number of action schedulers that can keep their timers in the
+ *  table.
+ */
+# define MAX_ACTIONS 4
+
+/**
+ *  @class UserTable
+ *
+ *  @brief State of every user, indexed by the slot of the user.
+ *
+ *  Every field is an array with one entry per slot, the user detector
+ *  gives a slot to an user when he appears and frees it after he is
+ *  lost. The slot of an user is found with a linear search over the
+ *  few user IDs, so the state of the users needs no tree lookups nor
+ *  allocations in the frame.
+ */
+class UserTable
+{
+    public:
+
+        /**
+         *  Constructor of the class.
+         */
+        UserTable();
+
+        /**
+         *  Class destructor.
+         */
+        ~UserTable() {}
+
+        /**
+         *  Frees all the slots and the pose timers.
+         */
+        void clear();
+
+        /**
+         *  Returns the slot of an user.
+         *  @param userID user ID of the user.
+         *  @return slot of the user, -1 if he has none.
+         */
+        int findSlot(XnUserID userID) const;
+
+        /**
+         *  Gives a free slot to a new user, with all his state
+         *  reset.
+         *  @param userID user ID of the new user.
+         *  @return slot of the user, -1 if the table is full.
+         */
+        int addUser(XnUserID userID);
+
+        /**
+         *  Marks the user of a slot as lost, the slot is freed in
+         *  releaseLost().
+         *  @param slot slot of the user.
+         */
+        void markLost(int slot);
+
+        /**
+         *  Frees the slots of the users marked as lost.
+         */
+        void releaseLost();
+
+        /**
+         *  Reserves a column of pose times for a pose detector.
+         *  @return index of the column, -1 if there are no more.
+         */
+        int addPoseTimer();
+
+        /**
+         *  Reserves a column of action timers for an action
+         *  scheduler.
+         *  @return index of the column, -1 if there are no more.
+         */
+        int addAction();
+
+        /**
+         *  Indicates if the slot has an user.
+         */
+        bool used[USER_SLOTS];
+
+        /**
+         *  Indicates if the user of the slot was lost in this frame.
+         */
+        bool lost[USER_SLOTS];
+
+        /**
+         *  User ID of the user of the slot.
+         */
+        XnUserID ids[USER_SLOTS];
+
+        /**
+         *  Indicates if the user was tracked in the last frame.
+         */
+        bool tracking[USER_SLOTS];
+
+        /**
+         *  Indicates if the user is tracked and not transformed yet,
+         *  and his transformation stage.
+         */
+        bool tracked[USER_SLOTS];
+        int stage[USER_SLOTS];
+
+        /**
+         *  Listener type of the user (ZAMUS_TYPE or LINQ_TYPE),
+         *  NO_LISTENED if he is not transformed, and his stage in
+         *  the listener.
+         */
+        int listener[USER_SLOTS];
+        int listenedStage[USER_SLOTS];
+
+        /**
+         *  Buster of the Zamus users, -1 if the user is not Zamus.
+         */
+        int busterStatus[USER_SLOTS];
+
+        /**
+         *  Indicates if the activation of the buster was printed.
+         */
+        bool busterActivationMsg[USER_SLOTS];
+
+        /**
+         *  Ice rod of the Linq users, -1 if the user is not Linq.
+         */
+        int iceRodStatus[USER_SLOTS];
+
+        /**
+         *  Time that the users have been posing, one column for every
+         *  pose detector.
+         */
+        double poseTime[MAX_POSE_TIMERS][USER_SLOTS];
+
+        /**
+         *  Timers of the actions of the users, one column for every
+         *  action scheduler: the time (usec) when the action can be
+         *  used again, if the user is charging it and the first and
+         *  last times of the charge.
+         */
+        XnUInt64 readyTime[MAX_ACTIONS][USER_SLOTS];
+        bool charging[MAX_ACTIONS][USER_SLOTS];
+        XnUInt64 chargeStart[MAX_ACTIONS][USER_SLOTS];
+        XnUInt64 chargeLast[MAX_ACTIONS][USER_SLOTS];
+
+        /**
+         *  Indicates if the user plays the game, and his score.
+         */
+        bool player[USER_SLOTS];
+        int score[USER_SLOTS];
+
+    private:
+
+        /**
+         *  Number of pose timers reserved.
+         */
+        int numPoseTimers;
+
+        /**
+         *  Number of action timers reserved.
+         */
+        int numActions;
+
+        /**
+         *  Resets the state of a slot.
+         *  @param slot slot to be reset.
+         */
+        void resetSlot(int slot);
+};
+
+# endif
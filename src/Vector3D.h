@@ -37,9 +37,7 @@
 // TODO: This file must include common.h but common.h also includes this
 // file.
 
-# include <XnOpenNI.h>
-# include <XnOS.h>
-# include <XnCppWrapper.h>
+# include "SensorTypes.h"
 
 using namespace xn;
 
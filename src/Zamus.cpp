@@ -39,21 +39,24 @@
  *
  *  @param userDetector is a pointer to the userDetector of the
  *  game.
+ *  @param projectiles is a pointer to the projectiles of the
+ *  game.
  */
-Zamus :: Zamus(UserDetector *userDetector) : 
+Zamus :: Zamus(UserDetector *userDetector, ProjectileSystem *projectiles) : 
         AbstractPoseDetection(userDetector)
 {
     listenerType = ZAMUS_TYPE;
     userDetector -> addListener(this);                   
-    setRequiredPoseTime(Z_POSE_TIME);
-    busterStatus = map <XnUserID, int>();
-    shoots = vector <ZamusShoot > ();
+    zamusPose = g_PoseLibrary.findPose("zamus");
+    setHoldPose(zamusPose);
+    userTable = userDetector -> retUserTable();
+    this -> projectiles = projectiles;
 }
 
 /**
  *  Add shoot function.
  *
- *  This function adds a new shoot to the vector shoots.
+ *  This function adds a new water shoot to the projectiles.
  *
  *  @param position is the initial position of the water shoot.
  *  @param direction is the vector that representes the direction
@@ -62,7 +65,7 @@ Zamus :: Zamus(UserDetector *userDetector) :
  */
 void Zamus :: addShoot (XnPoint3D position, Vector3D direction, XnUserID p)
 {
-    shoots.push_back(ZamusShoot(position, direction, p));
+    projectiles -> add(ZAMUS_SHOOT, position, direction, p);
 }
 
 /**
@@ -76,27 +79,10 @@ void Zamus :: addShoot (XnPoint3D position, Vector3D direction, XnUserID p)
  */
 bool Zamus :: isPosing(XnUserID userID, double poseTime) 
 {
-    //printf("Entre al isposing de zamus\n");
-    UserGenerator userGen;
-    SkeletonCapability *skelCap;
-    XnSkeletonJointPosition rs, re, rh, ls, le, lh;
-
-    Vector3D vrs, vre, vrh;
-    Vector3D vrse, vreh;
-
-    Vector3D vlsrs, vrsls;
-
-    Vector3D vls, vle, vlh;
-    Vector3D vlse, vleh;
-
     int percent;
-    int index;
     int stage;
-    
-    bool isStraightLeft;
-    bool isFrontLeft;
-    bool isRightPlaced;
-    bool isFrontRight;
+
+    bool isZamusPose;
 
     // Check if userID is in listener
     if (userDetector -> isTracked(userID)) {
@@ -106,92 +92,13 @@ bool Zamus :: isPosing(XnUserID userID, double poseTime)
         return false;
     }
 
-    userGen = userDetector -> retUserGenerator();
-
-    // Get joint positions (positions are switched)
-    // because the view is from backwards
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_SHOULDER, 
-        rs
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_ELBOW, 
-        re
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_LEFT_HAND, 
-        rh
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_SHOULDER, 
-        ls
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_ELBOW, 
-        le
-    );
-    userGen.GetSkeletonCap().GetSkeletonJointPosition(
-        userID, 
-        XN_SKEL_RIGHT_HAND, 
-        lh
-    );
-
-    // Confidence test
-    if( (rs.fConfidence < CONFIDENCE) || 
-        (re.fConfidence < CONFIDENCE) ||
-        (rh.fConfidence < CONFIDENCE) ||
-        (ls.fConfidence < CONFIDENCE) ||
-        (le.fConfidence < CONFIDENCE) ||
-        (lh.fConfidence < CONFIDENCE)) 
-        {
-            return false;
-        }
-    
-
-    vrs = Vector3D((rs.position).X, (rs.position).Y, (rs.position).Z);
-    vre = Vector3D((re.position).X, (re.position).Y, (re.position).Z);
-    vrh = Vector3D((rh.position).X, (rh.position).Y, (rh.position).Z);
-    vls = Vector3D((ls.position).X, (ls.position).Y, (ls.position).Z);
-    vle = Vector3D((le.position).X, (le.position).Y, (le.position).Z);
-    vlh = Vector3D((lh.position).X, (lh.position).Y, (lh.position).Z);
-
-    // Right Shoulder to elbow
-    vrse = vre - vrs;
-    
-    // Right Elbow to hand
-    vreh = vrh - vre;
-
-    // Left Shoulder to Elbow
-    vlse = vle - vls;
-    
-    // Left Elbow to hand
-    vleh = vlh - vle;
+    // The stage is kept while the arms can not be seen
+    if (!isPoseVisible(userID, zamusPose)) {
+        return false;
+    }
 
-    // Shoulder line
-    vlsrs = vrs - vls;
-    vrsls = vls - vrs;
-    
-    vrse.normalize();
-    vreh.normalize();
-    vlse.normalize();
-    vleh.normalize();
-    vlsrs.normalize();
-    vrsls.normalize();
-
-    // For left Arm
-    isStraightLeft = toAngle(acos(vlse.dot(vleh))) <= STRAIGHT_RANGE;
-    
-    isFrontLeft = toAngle(acos(vlse.dot(g_Vmz))) <= 30;
- 
-    // For right Arm
-    isFrontRight = toAngle(acos(vrse.dot(g_Vmz))) <= 30;
-    
-    isRightPlaced = toAngle(acos(vreh.dot(g_Vy))) <= 30;
+    // Left arm straight in front and right forearm up
+    isZamusPose = isInPose(userID, zamusPose);
       
     // Transformation course
     if(stage == NO_LISTENED ||
@@ -199,10 +106,10 @@ bool Zamus :: isPosing(XnUserID userID, double poseTime)
        stage == T_STAGE_2 ||
        stage == T_STAGE_3) 
        {
-        if (isStraightLeft && isFrontLeft && isRightPlaced && 
-            isFrontRight) {
+        if (isZamusPose) {
             
-            percent = transPercent(poseTime, Z_POSE_TIME);
+            percent = transPercent(poseTime, 
+                                   g_PoseLibrary.retHoldTime(zamusPose));
 
             printf("Zamus transformation %d%% -- \n", percent);
 
@@ -234,6 +141,21 @@ bool Zamus :: isPosing(XnUserID userID, double poseTime)
     return false;
 }
 
+/**
+ *  Indicates if an user can do the pose in his current role
+ *  and stage.
+ *
+ *  @param table is the table of the users.
+ *  @param slot is the slot of the user in the table.
+ *
+ *  @return True if the user is tracked and not transforming in
+ *  Linq.
+ */
+bool Zamus :: canPose(const UserTable *table, int slot)
+{
+    return table -> tracked[slot] && (table -> stage[slot] <= T_STAGE_3);
+}
+
 /**
  *  Function to be applied when the pose is detected 
  *
@@ -241,8 +163,14 @@ bool Zamus :: isPosing(XnUserID userID, double poseTime)
  */
 void Zamus :: poseDetected(XnUserID userID)
 {
-    usersListened.insert(pair <XnUserID, int> (userID, TRANSFORMED));
-    busterStatus.insert(pair <XnUserID, int> (userID, DEACTIVATED));
+    int slot;
+
+    addListened(userID, TRANSFORMED);
+
+    slot = userTable -> findSlot(userID);
+    if (slot != -1) {
+        userTable -> busterStatus[slot] = DEACTIVATED;
+    }
 
     userDetector -> remTrackedUser(userID);
 
@@ -259,8 +187,12 @@ void Zamus :: poseDetected(XnUserID userID)
  */
 int Zamus :: retBusterStatus(XnUserID userID)
 {
-    if (busterStatus.count(userID) == 1) {
-        return busterStatus[userID];
+    int slot;
+
+    slot = userTable -> findSlot(userID);
+
+    if (slot != -1) {
+        return userTable -> busterStatus[slot];
     }
 
     return -1;
@@ -275,7 +207,13 @@ int Zamus :: retBusterStatus(XnUserID userID)
  */
 void Zamus :: changeBusterStatus(XnUserID userID, int status) 
 {
-    busterStatus[userID] = status;
+    int slot;
+
+    slot = userTable -> findSlot(userID);
+
+    if (slot != -1) {
+        userTable -> busterStatus[slot] = status;
+    }
 }
 
 /**
@@ -289,9 +227,6 @@ void Zamus :: changeBusterStatus(XnUserID userID, int status)
 int Zamus :: retLisUserStage(XnUserID userID) 
 {
     return UserListener :: retLisUserStage(userID);
-    //if (usersListened.count(userID) == 1) {
-    //    return usersListened[userID];
-    //}
 }
 
 /**
@@ -324,14 +259,15 @@ void Zamus :: newUser(XnUserID userID) {
  */
 void Zamus :: lostUser(XnUserID userID) {
 
+    int slot;
+
     // Remove user from listener
-    if (isListened(userID) == 1) {
-        usersListened.erase(userID);
-    }
+    remListened(userID);
     
     // Remove user from buster
-    if (busterStatus.count(userID) == 1) {
-        busterStatus.erase(userID);
+    slot = userTable -> findSlot(userID);
+    if (slot != -1) {
+        userTable -> busterStatus[slot] = -1;
     }
 
     printf("Lost Zamus user %d\n", userID);
@@ -39,7 +39,7 @@
 # include "config.h"
 # include "util.h"
 # include "AbstractPoseDetection.h"
-# include "ZamusShoot.h"
+# include "ProjectileSystem.h"
 # include "UserListener.h"
 # include "UserDetector.h"
 
@@ -63,8 +63,10 @@ class Zamus : public AbstractPoseDetection, UserListener
          *
          *  @param userDetector is a pointer to the userDetector of the
          *  game.
+         *  @param projectiles is a pointer to the projectiles of the
+         *  game.
          */
-        Zamus(UserDetector *userDetector);
+        Zamus(UserDetector *userDetector, ProjectileSystem *projectiles);
         
         /**
          *  Zamus destructor 
@@ -97,17 +99,17 @@ class Zamus : public AbstractPoseDetection, UserListener
         };
 
         /**
-         *  Vector of zamus shoots.
+         *  Projectiles of the game.
          *
-         *  This vector contain the information about all the shoots made
-         *  by the players.
+         *  The shoots made by the players are added here, with the
+         *  ices of Linq.
          */
-        vector <ZamusShoot > shoots;
+        ProjectileSystem *projectiles;
 
         /**
          *  Add shoot function.
          *
-         *  This function adds a new shoot to the vector shoots.
+         *  This function adds a new water shoot to the projectiles.
          *
          *  @param position is the initial position of the water shoot.
          *  @param direction is the vector that representes the direction
@@ -154,12 +156,12 @@ class Zamus : public AbstractPoseDetection, UserListener
         virtual bool isListened(XnUserID userID);
 
      private:
-        
+
         /**
-         *  Buster Status (Activated/Deactivated).
+         *  Pose of the library for the transformation.
          */
-        map <XnUserID, int> busterStatus;
-
+        int zamusPose;
+        
         /**
          *  Indicates if the pose is being applied.
          *
@@ -171,6 +173,17 @@ class Zamus : public AbstractPoseDetection, UserListener
          */
         virtual bool isPosing(XnUserID userID, double poseTime = 0.0);
 
+        /**
+         *  Indicates if an user can do the pose in his current role
+         *  and stage.
+         *
+         *  @param table is the table of the users.
+         *  @param slot is the slot of the user in the table.
+         *
+         *  @return True if the user is tracked and not transforming in Linq.
+         */
+        virtual bool canPose(const UserTable *table, int slot);
+
         /**
          * Function to be applied when the pose is detected 
          *
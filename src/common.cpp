@@ -36,6 +36,8 @@
 
 # include "common.h"
 
+# ifndef SFB_HEADLESS
+
 /**
  *  Function used to check the OpenNI registered enumeration errors.
  *  @param status actual XN status.
@@ -55,3 +57,5 @@ void checkEnumError (XnStatus status, EnumerationErrors& error)
         exit(EXIT_FAILURE);
     }
 }
+
+# endif
@@ -41,23 +41,29 @@
 //  OpenNI
 //------------------------------------------------------------------------
 
-# include <XnOpenNI.h>
-# include <XnOS.h>
-# include <XnCppWrapper.h>
+# include "SensorTypes.h"
 
 //------------------------------------------------------------------------
 //  OpenGL
 //------------------------------------------------------------------------
 
+# ifndef SFB_HEADLESS
+// The pixel buffers are OpenGL 2.1
+# define GL_GLEXT_PROTOTYPES
 # include <GL/glut.h>
 # include <GL/glu.h>
 # include <GL/gl.h>
+# else
+// The models are never loaded in the headless build.
+typedef struct _GLMmodel GLMmodel;
+# endif
 
 
 //------------------------------------------------------------------------
 //  C++
 //------------------------------------------------------------------------
 
+# include <algorithm>
 # include <cmath>
 # include <cstdio>
 # include <string>
@@ -69,12 +75,15 @@
 //  Libraries
 //------------------------------------------------------------------------
 
-# include "TimeCounter.h"
+# include "Profiler.h"
 # include "Vector3D.h"
 
+# ifndef SFB_HEADLESS
 # define STATUS_CHECK(f, msg) checkGlobalErrorStatus(f, msg, #f)
+# endif
 
 # define XML_CONFIG_FILE "config/Config.xml"
+# define POSE_FILE "config/Poses.txt"
 
 /* Vectors indicating the coordinates axis */
 
@@ -89,6 +98,8 @@ using namespace std;
 using namespace xn;
 
 
+# ifndef SFB_HEADLESS
+
 /**
  * Checks global status error messages of XN.
  * @param status indicates the actual XN status.
@@ -104,6 +115,8 @@ inline void checkGlobalErrorStatus (XnStatus status, string errorMsg, const char
     }
 }
 
+# endif
+
 /**
  * Report and errpr and exit the program.
  * @param string containing the error message.
@@ -114,6 +127,8 @@ inline void reportError(string error)
     exit(EXIT_FAILURE);
 }
 
+# ifndef SFB_HEADLESS
+
 /**
  * Function used to check the OpenNI registered enumeration errors.
  * @param status actual XN status.
@@ -121,4 +136,6 @@ inline void reportError(string error)
  */
 void checkEnumError (XnStatus status, EnumerationErrors& error);
 
+# endif
+
 #endif
@@ -36,7 +36,7 @@
 # define CONFIG_H
 
 # define MAX_USERS 3
-# define MAX_FIREBALLS 100
+# define MAX_FIREBALLS 512
 # define POSE_SIZE 20
 # define CONFIDENCE 0.5f
 # define NO_LISTENED -1
@@ -48,35 +48,44 @@
 # define CROPLEFT     0.01
 # define CROPRIGHT   -0.05
 
-// Pose detection (in degrees)
-
-# define STRAIGHT_RANGE 60
-
 // Listener Types
 
 # define NEUTRAL_TYPE 0
 # define ZAMUS_TYPE 1
 # define LINQ_TYPE 2
 
-// Pose times
-
-# define Z_POSE_TIME 3.5
-# define Z_BUSTER_POSE_TIME 0.0
-# define L_POSE_TIME 0.0
-# define L_ICEROD_POSE_TIME 0.0
-
 // Zamus and Linq shoots
 
 # define Z_SHOOT_SPEED    1.5
 # define Z_SHOOT_MAX_DIST 10000
-# define Z_SHOOT_DELAY    2
 # define L_SHOOT_SPEED    0.5
 # define L_SHOOT_MAX_DIST 10000
 
+// Timing of the shoots in seconds. The Buster has a cooldown between
+// two shoots. The Ice Rod is charged bending the arm for L_ICE_CHARGE,
+// the charge lasts L_ICE_CHARGE_WINDOW after the arm stops bending, and
+// every use fires a burst of L_ICE_BURST ices.
+
+# define Z_SHOOT_COOLDOWN     0.125
+# define L_ICE_COOLDOWN       0.5
+# define L_ICE_CHARGE         0.2
+# define L_ICE_CHARGE_WINDOW  1.0
+# define L_ICE_BURST          3
+# define L_ICE_BURST_INTERVAL 0.05
+
 // Flame config
 
 # define FLAME_SCALE_FACTOR 1.0
 
+// Degrees that the flames spin in every tick of the game.
+
+# define FLAME_SPIN_SPEED 9.0
+
+// Side of the cells of the collision grid, bigger than the half of
+// the bounding box of the flames with 3 hp.
+
+# define COLLISION_CELL_SIZE 400
+
 // Game macros.
 
 # define FIRE_LIMIT 3500
@@ -88,4 +97,18 @@
 # define RISE_FLAMES_IN_LEVEL 20 / MAX_USERS
 # define POINTS_PER_HIT 100
 
+// Simulation clock. The game advances in ticks of a fixed length,
+// the speeds and delays of the game were tuned with one step for
+// every frame of the sensor, so every step is split in ticks. 
+// SIM_MAX_TICKS limits the ticks of an update after a stall.
+
+# define SIM_TICK_RATE 120
+# define SIM_STEP_RATE 30
+# define SIM_TICKS_PER_STEP (SIM_TICK_RATE / SIM_STEP_RATE)
+# define SIM_MAX_TICKS 12
+
+// Profiler, seconds between the dumps.
+
+# define PROFILER_DUMP_SECONDS 5
+
 # endif
@@ -208,6 +208,17 @@
  *  - Run make
  *  - Run make documentation (if you want the documentation)
  *  - Run the command ./SuperFiremanBrothers.
+ *  - Run the command ./SuperFiremanBrothers session.sfbr to record the
+ *    skeletons of the session, it can be replayed with the simulation.
+ *  - Add -t to print every few seconds the latencies of every stage
+ *    of the frames (acquire, checkUsers, detectPose, drawScene...).
+ *
+ *  The game logic can also run without Kinect and without window,
+ *  with scripted players, to test it or measure its speed:
+ *  - Run make simulation
+ *  - Run the command ./Bin/Release/SuperFiremanBrothersSim -h to see the options.
+ *  - Run make bench to build the benchmarks of the poses, collisions,
+ *    model loading and rendering in ./Bin/Release.
  *
  *  <hr>
  *  @section requirements requirements
@@ -269,37 +280,39 @@
 # include "util.h"
 
 # include "SceneRenderer.h"
+# include "SensorThread.h"
+# include "OpenNIBackend.h"
 # include "UserDetector.h"
-# include "BusterDetector.h"
-# include "IceRodDetector.h"
-# include "Zamus.h"
-# include "Linq.h"
-# include "SuperFiremanBrothers.h"
+# include "GameSimulation.h"
+# include "SkeletonRecorder.h"
 
 /**
- *  OpenNI objects forward declarations.
+ *  Sensor backend of the Kinect, it owns the OpenNI context.
  */
-Context             g_Context;
-EnumerationErrors   g_Error;
-DepthGenerator      g_DepthGenerator;
-UserGenerator       g_UserGenerator;
-ImageGenerator      g_ImageGenerator;
-SceneAnalyzer       g_SceneAnalyzer;
-SceneMetaData       g_SceneMD;
+OpenNIBackend       g_Backend;
 
 /**
  *  Forward declaration of our clases.
  */
 UserDetector        g_UserDetector;
+SensorThread        g_SensorThread;
 SceneRenderer       g_SceneRenderer;
-Zamus               *g_ZamusDetector;
-Linq                *g_LinqDetector;
-BusterDetector      *g_BusterDetector;
-IceRodDetector      *g_IceRodDetector;
-SuperFiremanBrothers g_SFBgame;
+GameSimulation      *g_Simulation;
+SkeletonRecorder    g_Recorder;
 
 int g_MaxPlayers;
 int g_gameOver;
+unsigned int g_Seed;
+
+/**
+ *  Wall clock time (usec) of the last frame of the game.
+ */
+XnUInt64 g_LastFrameTime = 0;
+
+/**
+ *  Path of the recording of the session, NULL if it is not recorded.
+ */
+char *g_RecordingPath = NULL;
 
 /**
  *  Lights
@@ -321,78 +334,43 @@ GLfloat mat_shininess[] = { 10.0 };
  */
 void initialize() 
 {
-    ImageMetaData imageMD;
-    XnStatus status;
     int dummy;
     
-    srand ( time(NULL) );
+    // The seed of the game, it is saved in the recordings
+    g_Seed = time(NULL);
 
-    // Initializing context and checking for enumeration errors
-    status = g_Context.InitFromXmlFile(XML_CONFIG_FILE, &g_Error);
-    checkEnumError(status, g_Error);
-
-    // Finding nodes and checking for errors
-    STATUS_CHECK(g_Context.FindExistingNode(XN_NODE_TYPE_DEPTH, g_DepthGenerator), "Finding depth node");
-    STATUS_CHECK(g_Context.FindExistingNode(XN_NODE_TYPE_SCENE, g_SceneAnalyzer), "Finding scene analizer");
-
-
-    //  Note: when the image generation node is handled the program gets
-    //  too slow.
-
-    // STATUS_CHECK(g_Context.FindExistingNode(XN_NODE_TYPE_IMAGE, g_ImageGenerator), "Finding image node");
-
-    // Set view point of Depth generator to the image generator point of
-    // view.
-    // STATUS_CHECK(g_DepthGenerator.GetAlternativeViewPointCap().SetViewPoint(g_ImageGenerator), "Set View Point");
-
-    STATUS_CHECK(g_Context.FindExistingNode(XN_NODE_TYPE_USER, g_UserGenerator), "Finding user node");
-    
-    //g_ImageGenerator.GetMetaData(imageMD);
-    
-    // Checking camera pixel format
-    //if (imageMD.PixelFormat() != XN_PIXEL_FORMAT_RGB24) {
-    //    reportError("Camera format not supported...!\n");
-    //}
-
-    // Checking user generator capabilities
-    if(!g_UserGenerator.IsCapabilitySupported(XN_CAPABILITY_SKELETON)) {
-        reportError("Skeleton capability not supported\n");
-    }
-    
-    if(!g_UserGenerator.IsCapabilitySupported(XN_CAPABILITY_POSE_DETECTION)) {
-        reportError("Pose detection capability not supported\n");
-    }
+    // Initializing the Kinect, the program exits on errors. The camera
+    // image is only copied while it is drawn.
+    g_Backend.init(XML_CONFIG_FILE);
 
     printf("Number of players: ");
     dummy = scanf("%d", &g_MaxPlayers);
     printf("\n");
 
     //Initialize user detector object
-    g_UserDetector = UserDetector(g_UserGenerator, g_DepthGenerator);
-    g_UserDetector.registerCallbacks();
+    g_UserDetector = UserDetector(&g_Backend);
     
-    g_ZamusDetector = new Zamus(&g_UserDetector);
-    g_LinqDetector = new Linq(&g_UserDetector);
-    g_BusterDetector = new BusterDetector(g_ZamusDetector, &g_UserDetector);
-    g_IceRodDetector = new IceRodDetector(g_LinqDetector, &g_UserDetector);
+    g_Simulation = new GameSimulation(&g_UserDetector, g_MaxPlayers, g_Seed);
+
+    // Record the session to replay it later
+    if (g_RecordingPath != NULL) {
+        if (!g_Recorder.open(g_RecordingPath, g_MaxPlayers, g_Seed)) {
+            reportError("Could not start the recording\n");
+        }
+        g_UserDetector.changeRecorder(&g_Recorder);
+        printf("Recording the session to %s\n", g_RecordingPath);
+    }
 
     // Initialize image render object
-    g_SceneRenderer = SceneRenderer(&g_ImageGenerator,
-                                    &g_DepthGenerator,
-                                    &g_SceneAnalyzer,
-                                    &g_UserDetector,
-                                    g_ZamusDetector,
-                                    g_LinqDetector);
-
-    STATUS_CHECK(g_Context.StartGeneratingAll(), "Context generation");
-
-    g_SFBgame = SuperFiremanBrothers(&g_UserDetector, 
-                                     &g_SceneAnalyzer, 
-                                     g_ZamusDetector, 
-                                     g_LinqDetector, 
-                                     g_MaxPlayers
-                                    );
+    g_SceneRenderer = SceneRenderer(&g_UserDetector,
+                                    g_Simulation -> retZamusDetector(),
+                                    g_Simulation -> retLinqDetector());
+
+    g_Backend.startGenerating();
 
+    // From now on only the sensor thread talks to the backend.
+    g_SensorThread = SensorThread(&g_Backend);
+    g_SensorThread.start();
 }
 
 /**
@@ -400,7 +378,9 @@ void initialize()
  */
 void cleanupExit() 
 {
-    g_Context.Shutdown();
+    g_SensorThread.stop();
+    g_Recorder.close();
+    g_Backend.shutdown();
     exit(EXIT_SUCCESS);
 }
 
@@ -429,10 +409,36 @@ void update (int value)
  */
 void glutDisplay (void)
 {
+    float alpha;
+
+    ProfileZone frameZone(PROFILE_FRAME);
+
     /**
-     *  Update every node of OpenNI.
+     *  Take the newest frame of the sensor thread without waiting,
+     *  the players and poses are only checked when there is a new one.
      */
-    g_Context.WaitOneUpdateAll(g_DepthGenerator);
+    g_SensorThread.changeCaptureLabels(g_SceneRenderer.retDrawUser());
+    g_SensorThread.changeCaptureImage(g_SceneRenderer.retDrawUser() &&
+                                      g_SceneRenderer.retDrawImage());
+
+    /**
+     *  The game advances in fixed ticks of the timestamps of the
+     *  frames, like the headless simulation, so a recording of the
+     *  session replays the same game. The wall clock only moves the
+     *  drawing between the frames.
+     */
+    if (g_SensorThread.update()) {
+        g_Simulation -> step(&g_SensorThread.retFrame());
+        g_Simulation -> advanceTo(g_SensorThread.retFrame().timestamp);
+        g_LastFrameTime = Profiler::now() / 1000;
+
+        if (g_Simulation -> retGame() -> isGameOver()) {
+            g_SensorThread.stopGenerating();
+        }
+    }
+
+    alpha = g_Simulation -> retAlpha(Profiler::now() / 1000 - 
+                                     g_LastFrameTime);
 
     glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
@@ -449,53 +455,51 @@ void glutDisplay (void)
 
     glPushMatrix();
 
-    // Checking fot game starting and finishing
-    g_SFBgame.checkUsers();
-
-    if (g_SFBgame.isGameOn()) {
-        
-        g_UserDetector.changeStopDetection(true);
-        g_SFBgame.checkGameOver();
-
-        if (!g_SFBgame.isGameOver()) {
-            g_BusterDetector -> detectPose();
-            g_IceRodDetector -> detectPose();
-        } 
-        else {
-            STATUS_CHECK(g_Context.StopGeneratingAll(), 
-                "Context generation shutdown");
-        }
-    }
-    else {
-        // Detects poses
-        g_ZamusDetector -> detectPose();
-        g_LinqDetector -> detectPose();
-    }
-    
-   
     /**
      *  Use the draw functions of every class to display the game with
      *  OpenGL.
      */
-    g_SceneRenderer.drawScene();
-    g_SFBgame.drawFireBalls();
-    g_SFBgame.drawGameInfo();
-    g_SFBgame.nextFrame();
+    {
+        ProfileZone zone(PROFILE_DRAW_SCENE);
+        g_SceneRenderer.drawScene(alpha);
+    }
+
+    {
+        ProfileZone zone(PROFILE_DRAW_FIREBALLS);
+        g_Simulation -> retGame() -> drawFireBalls(alpha);
+    }
+
+    g_Simulation -> retGame() -> drawGameInfo();
 
     glPopMatrix();
-    glutSwapBuffers();
+
+    {
+        ProfileZone zone(PROFILE_SWAP_BUFFERS);
+        glutSwapBuffers();
+    }
+
+    g_Profiler.dumpIfDue();
 }
 
 /**
  *  OpenGL Keyboard function.
  *
- *  Exit the program when escape key is pressed.
+ *  Exit the program when escape key is pressed. The key 'u' shows
+ *  the users pixels behind the scene, and 'i' the camera image with
+ *  them.
  */
 static void onGlutKeyboard(unsigned char key, int x, int y)
 {
     switch (key) {
         case 27:
-             exit(1);
+             cleanupExit();
+             break;
+        case 'u':
+             g_SceneRenderer.switchDrawUser();
+             break;
+        case 'i':
+             g_SceneRenderer.switchDrawImage();
+             break;
     }
 }
 
@@ -540,6 +544,19 @@ static void initGL (int argc, char* argv[])
  */
 int main(int argc, char* argv[]) 
 {   
+    int i;
+
+    // -t prints the profile of the frames, any other argument is the
+    // path of the recording
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0) {
+            g_Profiler.enable(true);
+        }
+        else if (argv[i][0] != '-') {
+            g_RecordingPath = argv[i];
+        }
+    }
+
     initialize();
     initGL (argc, argv);
     cleanupExit();